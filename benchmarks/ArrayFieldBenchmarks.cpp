@@ -0,0 +1,160 @@
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+constexpr size_t kSamples = 32;
+constexpr size_t kPayloadWords = 32;
+
+// A 4-bit header followed by 32 signed 12-bit samples, declared either as one
+// field per sample or as a single array
+MessageConfig makeSampleConfig(bool asArray) {
+    nlohmann::json fields = nlohmann::json::array();
+    fields.push_back({{"name", "channel"}, {"bit_width", 4}, {"signed", false}});
+    if (asArray) {
+        fields.push_back({{"name", "samples"}, {"bit_width", 12}, {"signed", true}, {"count", kSamples}});
+    } else {
+        for (size_t i = 0; i < kSamples; ++i) {
+            fields.push_back({{"name", "s" + std::to_string(i)}, {"bit_width", 12}, {"signed", true}});
+        }
+    }
+    return MessageConfig(fields);
+}
+
+// An 8-bit header followed by a 256-byte payload, declared either as 64-bit
+// scalar fields or as a single Bytes field
+MessageConfig makePayloadConfig(bool asBytes) {
+    nlohmann::json fields = nlohmann::json::array();
+    fields.push_back({{"name", "type"}, {"bit_width", 8}, {"signed", false}});
+    if (asBytes) {
+        fields.push_back({{"name", "payload"}, {"bytes", kPayloadWords * 8}});
+    } else {
+        for (size_t i = 0; i < kPayloadWords; ++i) {
+            fields.push_back({{"name", "w" + std::to_string(i)}, {"bit_width", 64}, {"signed", true}});
+        }
+    }
+    return MessageConfig(fields);
+}
+
+std::vector<int64_t> makeSamples() {
+    std::vector<int64_t> samples(kSamples);
+    for (size_t i = 0; i < kSamples; ++i) {
+        samples[i] = static_cast<int64_t>(i * 131 % 4096) - 2048;
+    }
+    return samples;
+}
+
+// Baseline: one scalar field per sample, set through handles
+void BM_PackSamplesAsScalars(benchmark::State& state) {
+    MessageConfig config = makeSampleConfig(false);
+    BinaryMessage message(config);
+    std::vector<int64_t> samples = makeSamples();
+    std::vector<uint8_t> buffer(message.getPackedSize());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < kSamples; ++i) {
+            message.setField(FieldHandle(static_cast<uint32_t>(i + 1)), samples[i]);
+        }
+        benchmark::DoNotOptimize(message.packInto(buffer.data(), buffer.size()));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PackSamplesAsScalars);
+
+void BM_PackSamplesAsArray(benchmark::State& state) {
+    MessageConfig config = makeSampleConfig(true);
+    BinaryMessage message(config);
+    FieldHandle handle = config.getFieldHandle("samples");
+    std::vector<int64_t> samples = makeSamples();
+    std::vector<uint8_t> buffer(message.getPackedSize());
+
+    for (auto _ : state) {
+        message.setArray(handle, samples.data(), samples.size());
+        benchmark::DoNotOptimize(message.packInto(buffer.data(), buffer.size()));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PackSamplesAsArray);
+
+void BM_UnpackSamplesAsScalars(benchmark::State& state) {
+    MessageConfig config = makeSampleConfig(false);
+    BinaryMessage message(config);
+    std::vector<int64_t> samples = makeSamples();
+    for (size_t i = 0; i < kSamples; ++i) {
+        message.setField(FieldHandle(static_cast<uint32_t>(i + 1)), samples[i]);
+    }
+    std::vector<uint8_t> buffer = message.pack();
+
+    for (auto _ : state) {
+        message.unpackFrom(buffer.data(), buffer.size());
+        for (size_t i = 0; i < kSamples; ++i) {
+            samples[i] = message.getField(FieldHandle(static_cast<uint32_t>(i + 1)));
+        }
+        benchmark::DoNotOptimize(samples.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_UnpackSamplesAsScalars);
+
+void BM_UnpackSamplesAsArray(benchmark::State& state) {
+    MessageConfig config = makeSampleConfig(true);
+    BinaryMessage message(config);
+    FieldHandle handle = config.getFieldHandle("samples");
+    std::vector<int64_t> samples = makeSamples();
+    message.setArray(handle, samples.data(), samples.size());
+    std::vector<uint8_t> buffer = message.pack();
+
+    for (auto _ : state) {
+        message.unpackFrom(buffer.data(), buffer.size());
+        message.getArray(handle, samples.data(), samples.size());
+        benchmark::DoNotOptimize(samples.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_UnpackSamplesAsArray);
+
+// Baseline: a 256-byte payload carried as 64-bit scalar fields
+void BM_RoundTripPayloadAsScalars(benchmark::State& state) {
+    MessageConfig config = makePayloadConfig(false);
+    BinaryMessage message(config);
+    std::vector<uint8_t> buffer(message.getPackedSize());
+    for (size_t i = 0; i < kPayloadWords; ++i) {
+        message.setField(FieldHandle(static_cast<uint32_t>(i + 1)), static_cast<int64_t>(i * 0x0101010101010101ULL));
+    }
+
+    for (auto _ : state) {
+        message.packInto(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(message.unpackFrom(buffer.data(), buffer.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+BENCHMARK(BM_RoundTripPayloadAsScalars);
+
+void BM_RoundTripPayloadAsBytes(benchmark::State& state) {
+    MessageConfig config = makePayloadConfig(true);
+    BinaryMessage message(config);
+    std::vector<uint8_t> buffer(message.getPackedSize());
+    std::vector<uint8_t> payload(kPayloadWords * 8);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+    message.setBytes(config.getFieldHandle("payload"), payload.data(), payload.size());
+
+    for (auto _ : state) {
+        message.packInto(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(message.unpackFrom(buffer.data(), buffer.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * buffer.size()));
+}
+BENCHMARK(BM_RoundTripPayloadAsBytes);
+
+} // namespace
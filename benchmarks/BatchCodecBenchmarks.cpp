@@ -0,0 +1,94 @@
+#include "BatchCodec.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+constexpr size_t kFrames = 4096;
+
+MessageConfig makeSensorConfig() {
+    return MessageConfig(R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "humidity", "bit_width": 8, "signed": false},
+        {"name": "battery_level", "bit_width": 4, "signed": false}
+    ])"_json);
+}
+
+std::vector<uint8_t> randomFrames(size_t frameSize) {
+    std::mt19937 rng(1);
+    std::vector<uint8_t> frames(kFrames * frameSize);
+    for (auto& byte : frames) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return frames;
+}
+
+void BM_DecodePerMessage(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    BinaryMessage message(config);
+    size_t frameSize = message.getPackedSize();
+    auto frames = randomFrames(frameSize);
+    std::vector<std::vector<int64_t>> columns(config.getFields().size(), std::vector<int64_t>(kFrames));
+    std::vector<FieldHandle> handles;
+    for (const auto& field : config.getFields()) {
+        handles.push_back(config.getFieldHandle(field.name()));
+    }
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < kFrames; ++i) {
+            message.unpackFrom(frames.data() + i * frameSize, frameSize);
+            for (size_t f = 0; f < handles.size(); ++f) {
+                columns[f][i] = message.getField(handles[f]);
+            }
+        }
+        benchmark::DoNotOptimize(columns.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+
+void BM_DecodeBatch(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    BatchCodec codec(config);
+    auto frames = randomFrames(codec.getFrameSize());
+    std::vector<std::vector<int64_t>> columns(codec.getColumnCount(), std::vector<int64_t>(kFrames));
+    std::vector<int64_t*> pointers;
+    for (auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+
+    for (auto _ : state) {
+        codec.decode(frames.data(), kFrames, codec.getFrameSize(), pointers.data());
+        benchmark::DoNotOptimize(columns.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+
+void BM_EncodeBatch(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    BatchCodec codec(config);
+    auto frames = randomFrames(codec.getFrameSize());
+    auto columns = codec.decode(frames.data(), kFrames, codec.getFrameSize());
+    std::vector<const int64_t*> pointers;
+    for (const auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+
+    for (auto _ : state) {
+        codec.encode(pointers.data(), kFrames, frames.data(), codec.getFrameSize());
+        benchmark::DoNotOptimize(frames.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+
+} // namespace
+
+BENCHMARK(BM_DecodePerMessage);
+BENCHMARK(BM_DecodeBatch);
+BENCHMARK(BM_EncodeBatch);
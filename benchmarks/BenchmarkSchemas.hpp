@@ -0,0 +1,109 @@
+#pragma once
+
+#include "FieldConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace BinaryMessageLibrary {
+namespace Benchmarks {
+
+/**
+ * @brief Bit-width distributions used to generate benchmark schemas.
+ */
+enum class WidthProfile {
+    Narrow,       ///< 1-8 bits, flags and small enums
+    ByteAligned,  ///< 8, 16 or 32 bits
+    Mixed,        ///< 1-64 bits, uniformly
+    Wide          ///< 33-64 bits, counters and timestamps
+};
+
+inline const char* widthProfileName(WidthProfile profile) {
+    switch (profile) {
+        case WidthProfile::Narrow:
+            return "narrow";
+        case WidthProfile::ByteAligned:
+            return "byte_aligned";
+        case WidthProfile::Mixed:
+            return "mixed";
+        case WidthProfile::Wide:
+        default:
+            return "wide";
+    }
+}
+
+/**
+ * @brief Generates a message definition with a deterministic pseudo-random layout.
+ *
+ * @param fieldCount Number of fields.
+ * @param profile Distribution of field bit widths.
+ * @param signedPercent Share of signed fields, 0-100.
+ * @return nlohmann::json An array of field definitions as accepted by MessageConfig.
+ */
+inline nlohmann::json makeSchema(size_t fieldCount, WidthProfile profile, int signedPercent) {
+    std::mt19937 rng(static_cast<unsigned>(fieldCount * 131 + static_cast<int>(profile) * 7 + signedPercent));
+    nlohmann::json fields = nlohmann::json::array();
+    for (size_t i = 0; i < fieldCount; ++i) {
+        unsigned width = 0;
+        switch (profile) {
+            case WidthProfile::Narrow:
+                width = 1 + rng() % 8;
+                break;
+            case WidthProfile::ByteAligned:
+                width = 8u << (rng() % 3);
+                break;
+            case WidthProfile::Mixed:
+                width = 1 + rng() % 64;
+                break;
+            case WidthProfile::Wide:
+                width = 33 + rng() % 32;
+                break;
+        }
+        bool isSigned = static_cast<int>(rng() % 100) < signedPercent && width > 1;
+        fields.push_back({{"name", "field_" + std::to_string(i)}, {"bit_width", width}, {"signed", isSigned}});
+    }
+    return fields;
+}
+
+/**
+ * @brief Generates in-range values for every field of a configuration.
+ */
+inline std::vector<int64_t> makeValues(const std::vector<FieldConfig>& fields) {
+    std::mt19937_64 rng(fields.size());
+    std::vector<int64_t> values;
+    values.reserve(fields.size());
+    for (const auto& field : fields) {
+        uint64_t span = static_cast<uint64_t>(field.getMaxValue()) - static_cast<uint64_t>(field.getMinValue());
+        uint64_t offset = span == UINT64_MAX ? rng() : rng() % (span + 1);
+        values.push_back(static_cast<int64_t>(static_cast<uint64_t>(field.getMinValue()) + offset));
+    }
+    return values;
+}
+
+/**
+ * @brief Reads the schema parameters of a benchmark run set up with SchemaMatrix.
+ */
+inline nlohmann::json schemaFor(const benchmark::State& state) {
+    return makeSchema(static_cast<size_t>(state.range(0)), static_cast<WidthProfile>(state.range(1)),
+                      static_cast<int>(state.range(2)));
+}
+
+/**
+ * @brief Registers the field count x width profile x signed mix matrix.
+ */
+inline void SchemaMatrix(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"fields", "widths", "signed_pct"});
+    for (int fields : {4, 16, 64, 256}) {
+        for (int profile = 0; profile <= static_cast<int>(WidthProfile::Wide); ++profile) {
+            for (int signedPercent : {0, 50, 100}) {
+                b->Args({fields, profile, signedPercent});
+            }
+        }
+    }
+}
+
+} // namespace Benchmarks
+} // namespace BinaryMessageLibrary
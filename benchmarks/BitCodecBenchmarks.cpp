@@ -0,0 +1,126 @@
+#include "BitCodec.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+constexpr size_t kFieldsPerMessage = 64;
+
+// The per-bit loops BinaryMessage::pack()/unpack() used before the word codec
+void bitwiseDeposit(std::vector<uint8_t>& buffer, size_t offset, unsigned width, uint64_t value) {
+    for (size_t bit = 0; bit < width; ++bit) {
+        size_t byte_index = (offset + bit) / 8;
+        size_t bit_index = (offset + bit) % 8;
+        if (value & (1ULL << bit)) {
+            buffer[byte_index] |= (1 << bit_index);
+        }
+    }
+}
+
+uint64_t bitwiseExtract(const std::vector<uint8_t>& buffer, size_t offset, unsigned width) {
+    uint64_t value = 0;
+    for (size_t bit = 0; bit < width; ++bit) {
+        size_t byte_index = (offset + bit) / 8;
+        size_t bit_index = (offset + bit) % 8;
+        if (buffer[byte_index] & (1 << bit_index)) {
+            value |= (1ULL << bit);
+        }
+    }
+    return value;
+}
+
+std::vector<uint64_t> randomValues(unsigned width) {
+    std::mt19937_64 rng(width);
+    std::vector<uint64_t> values(kFieldsPerMessage);
+    for (auto& value : values) {
+        value = rng() & BitCodec::lowMask(width);
+    }
+    return values;
+}
+
+size_t bufferBytes(unsigned width) {
+    return (kFieldsPerMessage * width + 7) / 8;
+}
+
+void BM_PackBitwise(benchmark::State& state) {
+    unsigned width = static_cast<unsigned>(state.range(0));
+    auto values = randomValues(width);
+    std::vector<uint8_t> buffer(bufferBytes(width));
+    for (auto _ : state) {
+        std::fill(buffer.begin(), buffer.end(), 0);
+        for (size_t i = 0; i < values.size(); ++i) {
+            bitwiseDeposit(buffer, i * width, width, values[i]);
+        }
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kFieldsPerMessage);
+}
+
+void BM_PackWord(benchmark::State& state) {
+    unsigned width = static_cast<unsigned>(state.range(0));
+    auto values = randomValues(width);
+    std::vector<uint8_t> buffer(bufferBytes(width));
+    for (auto _ : state) {
+        std::fill(buffer.begin(), buffer.end(), 0);
+        for (size_t i = 0; i < values.size(); ++i) {
+            BitCodec::depositBits(buffer.data(), buffer.size(), i * width, width, values[i]);
+        }
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kFieldsPerMessage);
+}
+
+void BM_UnpackBitwise(benchmark::State& state) {
+    unsigned width = static_cast<unsigned>(state.range(0));
+    auto values = randomValues(width);
+    std::vector<uint8_t> buffer(bufferBytes(width));
+    for (size_t i = 0; i < values.size(); ++i) {
+        bitwiseDeposit(buffer, i * width, width, values[i]);
+    }
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < kFieldsPerMessage; ++i) {
+            sum += bitwiseExtract(buffer, i * width, width);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * kFieldsPerMessage);
+}
+
+void BM_UnpackWord(benchmark::State& state) {
+    unsigned width = static_cast<unsigned>(state.range(0));
+    auto values = randomValues(width);
+    std::vector<uint8_t> buffer(bufferBytes(width));
+    for (size_t i = 0; i < values.size(); ++i) {
+        BitCodec::depositBits(buffer.data(), buffer.size(), i * width, width, values[i]);
+    }
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < kFieldsPerMessage; ++i) {
+            sum += BitCodec::extractBits(buffer.data(), buffer.size(), i * width, width);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * kFieldsPerMessage);
+}
+
+void FieldWidths(benchmark::internal::Benchmark* b) {
+    for (int width : {1, 4, 7, 8, 12, 16, 24, 31, 32, 48, 57, 63, 64}) {
+        b->Arg(width);
+    }
+    b->ArgName("bit_width");
+}
+
+} // namespace
+
+BENCHMARK(BM_PackBitwise)->Apply(FieldWidths);
+BENCHMARK(BM_PackWord)->Apply(FieldWidths);
+BENCHMARK(BM_UnpackBitwise)->Apply(FieldWidths);
+BENCHMARK(BM_UnpackWord)->Apply(FieldWidths);
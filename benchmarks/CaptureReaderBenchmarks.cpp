@@ -0,0 +1,84 @@
+#include "CaptureReader.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+constexpr size_t kCaptureFrames = 1u << 20;
+
+MessageConfig makeSensorConfig() {
+    return MessageConfig(R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "humidity", "bit_width": 8, "signed": false},
+        {"name": "battery_level", "bit_width": 4, "signed": false}
+    ])"_json);
+}
+
+// Capture file shared by all cases, written once and removed at exit
+const std::string& capturePath(size_t frameSize) {
+    static const std::string path = [frameSize]() {
+        std::string file = "binary_message_bench_capture.bin";
+        std::mt19937 rng(5);
+        std::vector<char> data(kCaptureFrames * frameSize);
+        for (auto& byte : data) {
+            byte = static_cast<char>(rng());
+        }
+        std::ofstream(file, std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size()));
+        std::atexit([]() { std::remove("binary_message_bench_capture.bin"); });
+        return file;
+    }();
+    return path;
+}
+
+// Baseline: read the file into a vector, then unpack from the copy
+void BM_CaptureReadIntoVector(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    BinaryMessage message(config);
+    size_t frameSize = message.getPackedSize();
+    const std::string& path = capturePath(frameSize);
+
+    for (auto _ : state) {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        for (size_t offset = 0; offset + frameSize <= data.size(); offset += frameSize) {
+            message.unpackFrom(data.data() + offset, frameSize);
+            benchmark::DoNotOptimize(message);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kCaptureFrames);
+    state.SetBytesProcessed(state.iterations() * kCaptureFrames * frameSize);
+}
+
+void BM_CaptureMapped(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    BinaryMessage message(config);
+    size_t frameSize = message.getPackedSize();
+    const std::string& path = capturePath(frameSize);
+
+    for (auto _ : state) {
+        CaptureReader reader(path, config);
+        for (FrameView view : reader) {
+            message.unpackFrom(view.data, view.size);
+            benchmark::DoNotOptimize(message);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kCaptureFrames);
+    state.SetBytesProcessed(state.iterations() * kCaptureFrames * frameSize);
+}
+
+} // namespace
+
+BENCHMARK(BM_CaptureReadIntoVector)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CaptureMapped)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,122 @@
+#include "ColumnStore.hpp"
+#include "BatchCodec.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+constexpr size_t kRows = 1u << 20;
+
+MessageConfig makeSensorConfig() {
+    return MessageConfig(R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "humidity", "bit_width": 8, "signed": false},
+        {"name": "battery_level", "bit_width": 4, "signed": false}
+    ])"_json);
+}
+
+std::vector<uint8_t> makeFrames(const MessageConfig& config) {
+    BatchCodec codec(config);
+    std::mt19937 rng(11);
+    std::vector<uint8_t> frames(kRows * codec.getFrameSize());
+    for (auto& byte : frames) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return frames;
+}
+
+// Baseline: decode every field of every frame, then sum one of them
+void BM_ScanFieldFromFrames(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    BatchCodec codec(config);
+    std::vector<uint8_t> frames = makeFrames(config);
+    auto columns = codec.decode(frames.data(), 1, codec.getFrameSize());
+
+    constexpr size_t kBatch = 4096;
+    for (auto& column : columns) {
+        column.resize(kBatch);
+    }
+    std::vector<int64_t*> pointers;
+    for (auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (size_t row = 0; row < kRows; row += kBatch) {
+            codec.decode(frames.data() + row * codec.getFrameSize(), kBatch, codec.getFrameSize(), pointers.data());
+            for (int64_t value : columns[1]) {
+                sum += value;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * kRows);
+    state.SetBytesProcessed(state.iterations() * frames.size());
+}
+
+// Sums the same field from its own column; only that column's chunks are read
+void BM_ScanFieldFromColumnStore(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    std::vector<uint8_t> frames = makeFrames(config);
+    std::ostringstream out;
+    {
+        ColumnStoreWriter writer(out, config, ColumnStoreWriter::kDefaultBlockRows,
+                                 static_cast<ColumnEncoding>(state.range(0)));
+        writer.appendFrames(frames.data(), kRows, BatchCodec(config).getFrameSize());
+    }
+    std::string bytes = out.str();
+    ColumnStoreReader reader(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    size_t temperature = reader.getColumnIndex("temperature");
+    std::vector<int64_t> values(ColumnStoreWriter::kDefaultBlockRows);
+
+    uint64_t scanned = 0;
+    for (size_t b = 0; b < reader.getBlockCount(); ++b) {
+        scanned += reader.getStats(b, temperature).byteSize;
+    }
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (size_t b = 0; b < reader.getBlockCount(); ++b) {
+            size_t rows = reader.readColumn(temperature, b, values.data());
+            for (size_t i = 0; i < rows; ++i) {
+                sum += values[i];
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * kRows);
+    state.SetBytesProcessed(state.iterations() * scanned);
+}
+
+void BM_ColumnStoreWrite(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    std::vector<uint8_t> frames = makeFrames(config);
+    size_t frameSize = BatchCodec(config).getFrameSize();
+
+    for (auto _ : state) {
+        std::ostringstream out;
+        ColumnStoreWriter writer(out, config);
+        writer.appendFrames(frames.data(), kRows, frameSize);
+        writer.finish();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * kRows);
+}
+
+} // namespace
+
+BENCHMARK(BM_ScanFieldFromFrames)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScanFieldFromColumnStore)
+    ->Arg(static_cast<int>(ColumnEncoding::Plain))
+    ->Arg(static_cast<int>(ColumnEncoding::Auto))
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ColumnStoreWrite)->Unit(benchmark::kMillisecond);
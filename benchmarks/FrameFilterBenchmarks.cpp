@@ -0,0 +1,98 @@
+#include "FrameFilter.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+constexpr size_t kFrames = 1u << 16;
+
+MessageConfig makeTelemetryConfig() {
+    return MessageConfig(R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "humidity", "bit_width": 8, "signed": false},
+        {"name": "error_code", "bit_width": 4, "signed": false},
+        {"name": "timestamp", "bit_width": 36, "signed": false}
+    ])"_json);
+}
+
+// About 1 in 32 frames carries an error, as in a typical "errors only" consumer
+std::vector<uint8_t> makeFrames(const MessageConfig& config) {
+    BinaryMessage message(config);
+    size_t frameSize = message.getPackedSize();
+    std::vector<uint8_t> frames(kFrames * frameSize);
+    std::mt19937 rng(17);
+    for (size_t i = 0; i < kFrames; ++i) {
+        message.setField("sensor_id", static_cast<int64_t>(rng() % 64));
+        message.setField("temperature", static_cast<int64_t>(rng() % 1024) - 512);
+        message.setField("humidity", static_cast<int64_t>(rng() % 256));
+        message.setField("error_code", rng() % 32 == 0 ? static_cast<int64_t>(1 + rng() % 15) : 0);
+        message.setField("timestamp", static_cast<int64_t>(i));
+        message.packInto(frames.data() + i * frameSize, frameSize);
+    }
+    return frames;
+}
+
+// Baseline: unpack every frame and test the field values
+void BM_FilterByUnpacking(benchmark::State& state) {
+    MessageConfig config = makeTelemetryConfig();
+    std::vector<uint8_t> frames = makeFrames(config);
+    BinaryMessage message(config);
+    size_t frameSize = message.getPackedSize();
+    FieldHandle errorCode = config.getFieldHandle("error_code");
+    FieldHandle temperature = config.getFieldHandle("temperature");
+    std::vector<size_t> indices;
+
+    for (auto _ : state) {
+        indices.clear();
+        for (size_t i = 0; i < kFrames; ++i) {
+            message.unpackFrom(frames.data() + i * frameSize, frameSize);
+            if (message.getField(errorCode) != 0 && message.getField(temperature) < -100) {
+                indices.push_back(i);
+            }
+        }
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+
+void BM_FilterPacked(benchmark::State& state) {
+    MessageConfig config = makeTelemetryConfig();
+    std::vector<uint8_t> frames = makeFrames(config);
+    size_t frameSize = config.getLayout().getTotalBytes();
+    FrameFilter filter(config);
+    filter.where("error_code", CompareOp::NotEqual, 0).where("temperature", CompareOp::Less, -100);
+    std::vector<size_t> indices;
+
+    for (auto _ : state) {
+        filter.selectIndices(frames.data(), kFrames, frameSize, indices);
+        benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+
+void BM_FilterPackedBitmap(benchmark::State& state) {
+    MessageConfig config = makeTelemetryConfig();
+    std::vector<uint8_t> frames = makeFrames(config);
+    size_t frameSize = config.getLayout().getTotalBytes();
+    FrameFilter filter(config);
+    filter.where("error_code", CompareOp::NotEqual, 0).where("temperature", CompareOp::Less, -100);
+    std::vector<uint64_t> bitmap((kFrames + 63) / 64);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(filter.selectBitmap(frames.data(), kFrames, frameSize, bitmap.data()));
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+
+} // namespace
+
+BENCHMARK(BM_FilterByUnpacking);
+BENCHMARK(BM_FilterPacked);
+BENCHMARK(BM_FilterPackedBitmap);
@@ -0,0 +1,338 @@
+#include "BenchmarkSchemas.hpp"
+#include "BinaryMessage.hpp"
+#include "BinaryMessageFactory.hpp"
+#include "MessageConfig.hpp"
+#include "MessageView.hpp"
+#include "SchemaSnapshot.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+using namespace BinaryMessageLibrary::Benchmarks;
+
+namespace {
+
+void setLabel(benchmark::State& state) {
+    state.SetLabel(widthProfileName(static_cast<WidthProfile>(state.range(1))));
+}
+
+void fill(BinaryMessage& message, const MessageConfig& config) {
+    auto values = makeValues(config.getFields());
+    for (size_t i = 0; i < values.size(); ++i) {
+        message.setField(FieldHandle(static_cast<uint32_t>(i)), values[i]);
+    }
+}
+
+void BM_Pack(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+
+    for (auto _ : state) {
+        auto buffer = message.pack();
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    setLabel(state);
+    state.SetBytesProcessed(state.iterations() * message.getPackedSize());
+}
+
+void BM_PackInto(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    std::vector<uint8_t> buffer(message.getPackedSize());
+
+    for (auto _ : state) {
+        message.packInto(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    setLabel(state);
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+void BM_Unpack(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    auto buffer = message.pack();
+
+    for (auto _ : state) {
+        message.unpack(buffer);
+        benchmark::DoNotOptimize(message);
+    }
+    setLabel(state);
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+// The same schemas, MSB-first and big-endian: every field goes through the
+// big-endian word path
+nlohmann::json msbFirstSchemaFor(const benchmark::State& state) {
+    return {{"bit_order", "msb_first"}, {"fields", schemaFor(state)}};
+}
+
+void BM_PackIntoMsbFirst(benchmark::State& state) {
+    MessageConfig config(msbFirstSchemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    std::vector<uint8_t> buffer(message.getPackedSize());
+
+    for (auto _ : state) {
+        message.packInto(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    setLabel(state);
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+void BM_UnpackMsbFirst(benchmark::State& state) {
+    MessageConfig config(msbFirstSchemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    auto buffer = message.pack();
+
+    for (auto _ : state) {
+        message.unpack(buffer);
+        benchmark::DoNotOptimize(message);
+    }
+    setLabel(state);
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+void BM_SetFieldByName(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    auto values = makeValues(config.getFields());
+    std::vector<std::string> names;
+    for (const auto& field : config.getFields()) {
+        names.push_back(field.name());
+    }
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < names.size(); ++i) {
+            message.setField(names[i], values[i]);
+        }
+    }
+    setLabel(state);
+    state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+void BM_SetFieldByHandle(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    auto values = makeValues(config.getFields());
+    std::vector<FieldHandle> handles;
+    for (const auto& field : config.getFields()) {
+        handles.push_back(config.getFieldHandle(field.name()));
+    }
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < handles.size(); ++i) {
+            message.setField(handles[i], values[i]);
+        }
+    }
+    setLabel(state);
+    state.SetItemsProcessed(state.iterations() * handles.size());
+}
+
+void BM_GetFieldByName(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    std::vector<std::string> names;
+    for (const auto& field : config.getFields()) {
+        names.push_back(field.name());
+    }
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (const auto& name : names) {
+            sum += message.getField(name);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setLabel(state);
+    state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+void BM_GetFieldByHandle(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    std::vector<FieldHandle> handles;
+    for (const auto& field : config.getFields()) {
+        handles.push_back(config.getFieldHandle(field.name()));
+    }
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        for (FieldHandle handle : handles) {
+            sum += message.getField(handle);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    setLabel(state);
+    state.SetItemsProcessed(state.iterations() * handles.size());
+}
+
+// Reads one field of a packed message: full unpack versus a lazy view
+void BM_ReadOneFieldUnpack(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    auto buffer = message.pack();
+    FieldHandle field(static_cast<uint32_t>(config.getFields().size() / 2));
+
+    for (auto _ : state) {
+        message.unpackFrom(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(message.getField(field));
+    }
+    setLabel(state);
+}
+
+void BM_ReadOneFieldView(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    auto buffer = message.pack();
+    FieldHandle field(static_cast<uint32_t>(config.getFields().size() / 2));
+
+    for (auto _ : state) {
+        MessageView view(config, buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(view.getField(field));
+    }
+    setLabel(state);
+}
+
+// Forwarding: bump one field of a packed frame by repacking versus patching in place
+void BM_ForwardRepack(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    auto buffer = message.pack();
+    FieldHandle field(0);
+    const FieldConfig& first = config.getFields()[0];
+
+    for (auto _ : state) {
+        message.unpack(buffer);
+        int64_t value = message.getField(field);
+        message.setField(field, value == first.getMaxValue() ? first.getMinValue() : value + 1);
+        buffer = message.pack();
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    setLabel(state);
+}
+
+void BM_ForwardPatch(benchmark::State& state) {
+    MessageConfig config(schemaFor(state));
+    BinaryMessage message(config);
+    fill(message, config);
+    auto buffer = message.pack();
+    FieldHandle field(0);
+    const FieldConfig& first = config.getFields()[0];
+
+    for (auto _ : state) {
+        MutableMessageView view(config, buffer.data(), buffer.size());
+        int64_t value = view.getField(field);
+        view.setField(field, value == first.getMaxValue() ? first.getMinValue() : value + 1);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    setLabel(state);
+}
+
+// Factory-style definition with one message type per schema variant
+nlohmann::json makeFactoryConfig(size_t typeCount, size_t fieldCount) {
+    nlohmann::json config = nlohmann::json::object();
+    for (size_t t = 0; t < typeCount; ++t) {
+        config["message_" + std::to_string(t)] =
+            makeSchema(fieldCount, static_cast<WidthProfile>(t % 4), static_cast<int>(t % 3) * 50);
+    }
+    return config;
+}
+
+void BM_FactoryCreateMessage(benchmark::State& state) {
+    BinaryMessageFactory factory(makeFactoryConfig(16, static_cast<size_t>(state.range(0))));
+
+    for (auto _ : state) {
+        auto message = factory.createMessage("message_7");
+        benchmark::DoNotOptimize(message.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_FactoryAcquire(benchmark::State& state) {
+    BinaryMessageFactory factory(makeFactoryConfig(16, static_cast<size_t>(state.range(0))));
+
+    for (auto _ : state) {
+        auto message = factory.acquire("message_7");
+        benchmark::DoNotOptimize(message.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_LoadMessageConfig(benchmark::State& state) {
+    nlohmann::json schema = schemaFor(state);
+
+    for (auto _ : state) {
+        MessageConfig config(schema);
+        benchmark::DoNotOptimize(config);
+    }
+    setLabel(state);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_LoadFactoryFromText(benchmark::State& state) {
+    size_t typeCount = static_cast<size_t>(state.range(0));
+    std::string text = makeFactoryConfig(typeCount, 16).dump();
+
+    for (auto _ : state) {
+        BinaryMessageFactory factory(nlohmann::json::parse(text));
+        benchmark::DoNotOptimize(factory);
+    }
+    state.SetItemsProcessed(state.iterations() * typeCount);
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+// The same configuration, from a snapshot of it instead of its text
+void BM_LoadFactoryFromSnapshot(benchmark::State& state) {
+    size_t typeCount = static_cast<size_t>(state.range(0));
+    std::string text = makeFactoryConfig(typeCount, 16).dump();
+    uint64_t sourceChecksum = SchemaSnapshot::checksum(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    std::vector<uint8_t> snapshot;
+    BinaryMessageFactory(nlohmann::json::parse(text)).writeSnapshot(snapshot, sourceChecksum);
+
+    for (auto _ : state) {
+        BinaryMessageFactory factory;
+        // The source is still checksummed to detect a stale snapshot
+        uint64_t current = SchemaSnapshot::checksum(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+        if (!factory.loadSnapshot(snapshot.data(), snapshot.size(), current)) {
+            state.SkipWithError("stale snapshot");
+            break;
+        }
+        benchmark::DoNotOptimize(factory);
+    }
+    state.SetItemsProcessed(state.iterations() * typeCount);
+    state.SetBytesProcessed(state.iterations() * snapshot.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_Pack)->Apply(SchemaMatrix);
+BENCHMARK(BM_PackInto)->Apply(SchemaMatrix);
+BENCHMARK(BM_Unpack)->Apply(SchemaMatrix);
+BENCHMARK(BM_PackIntoMsbFirst)->Apply(SchemaMatrix);
+BENCHMARK(BM_UnpackMsbFirst)->Apply(SchemaMatrix);
+BENCHMARK(BM_SetFieldByName)->Apply(SchemaMatrix);
+BENCHMARK(BM_SetFieldByHandle)->Apply(SchemaMatrix);
+BENCHMARK(BM_GetFieldByName)->Apply(SchemaMatrix);
+BENCHMARK(BM_GetFieldByHandle)->Apply(SchemaMatrix);
+BENCHMARK(BM_ReadOneFieldUnpack)->Apply(SchemaMatrix);
+BENCHMARK(BM_ReadOneFieldView)->Apply(SchemaMatrix);
+BENCHMARK(BM_ForwardRepack)->Apply(SchemaMatrix);
+BENCHMARK(BM_ForwardPatch)->Apply(SchemaMatrix);
+BENCHMARK(BM_FactoryCreateMessage)->Arg(4)->Arg(16)->Arg(64)->Arg(256)->ArgName("fields")->ThreadRange(1, 8);
+BENCHMARK(BM_FactoryAcquire)->Arg(4)->Arg(16)->Arg(64)->Arg(256)->ArgName("fields")->ThreadRange(1, 8);
+BENCHMARK(BM_LoadMessageConfig)->Apply(SchemaMatrix);
+BENCHMARK(BM_LoadFactoryFromText)->Arg(1)->Arg(16)->Arg(128)->ArgName("types");
+BENCHMARK(BM_LoadFactoryFromSnapshot)->Arg(1)->Arg(16)->Arg(128)->ArgName("types");
@@ -0,0 +1,84 @@
+#include "SimdKernels.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+constexpr size_t kFrames = 1 << 14;
+
+// sensor_data layout: temperature is a signed 10-bit field at bit 6
+MessageConfig makeSensorConfig() {
+    return MessageConfig(R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "humidity", "bit_width": 8, "signed": false},
+        {"name": "battery_level", "bit_width": 4, "signed": false},
+        {"name": "reserved", "bit_width": 36, "signed": false}
+    ])"_json);
+}
+
+std::vector<uint8_t> randomFrames(size_t frameSize) {
+    std::mt19937 rng(3);
+    std::vector<uint8_t> frames(kFrames * frameSize + 8);
+    for (auto& byte : frames) {
+        byte = static_cast<uint8_t>(rng());
+    }
+    return frames;
+}
+
+void BM_ExtractTemperatureUnpack(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    BinaryMessage message(config);
+    size_t frameSize = message.getPackedSize();
+    auto frames = randomFrames(frameSize);
+    FieldHandle temperature = config.getFieldHandle("temperature");
+    std::vector<int64_t> column(kFrames);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < kFrames; ++i) {
+            message.unpackFrom(frames.data() + i * frameSize, frameSize);
+            column[i] = message.getField(temperature);
+        }
+        benchmark::DoNotOptimize(column.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+
+void BM_ExtractTemperatureKernel(benchmark::State& state) {
+    SimdLevel level = static_cast<SimdLevel>(state.range(0));
+    if (level > SimdKernels::activeSimdLevel()) {
+        state.SkipWithError("instruction set not supported on this CPU");
+        return;
+    }
+    state.SetLabel(SimdKernels::simdLevelName(level));
+
+    MessageConfig config = makeSensorConfig();
+    const auto& layout = config.getLayout();
+    size_t frameSize = layout.getTotalBytes();
+    auto frames = randomFrames(frameSize);
+    size_t index = config.getFieldHandle("temperature").index();
+    std::vector<int64_t> column(kFrames);
+
+    for (auto _ : state) {
+        SimdKernels::extractColumn(level, frames.data() + layout.byteOffsets()[index], kFrames, frameSize,
+                                   layout.shifts()[index], layout.masks()[index],
+                                   layout.signShifts()[index], column.data());
+        benchmark::DoNotOptimize(column.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+
+} // namespace
+
+BENCHMARK(BM_ExtractTemperatureUnpack);
+BENCHMARK(BM_ExtractTemperatureKernel)
+    ->Arg(static_cast<int>(SimdLevel::Scalar))
+    ->Arg(static_cast<int>(SimdLevel::AVX2))
+    ->Arg(static_cast<int>(SimdLevel::AVX512))
+    ->ArgName("level");
@@ -0,0 +1,79 @@
+#include "StaticMessage.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+BINARY_MESSAGE_FIELD_NAME(SensorId, "sensor_id");
+BINARY_MESSAGE_FIELD_NAME(Temperature, "temperature");
+BINARY_MESSAGE_FIELD_NAME(Humidity, "humidity");
+BINARY_MESSAGE_FIELD_NAME(BatteryLevel, "battery_level");
+
+using SensorData = StaticMessage<
+    Field<SensorId, 6>,
+    Field<Temperature, 10, true>,
+    Field<Humidity, 8>,
+    Field<BatteryLevel, 4>>;
+
+void BM_StaticPack(benchmark::State& state) {
+    SensorData message;
+    message.set<SensorId>(15);
+    message.set<Temperature>(-125);
+    message.set<Humidity>(75);
+    message.set<BatteryLevel>(12);
+    uint8_t buffer[SensorData::kPackedSize];
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(message);
+        message.packInto(buffer, sizeof(buffer));
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+
+void BM_DynamicPack(benchmark::State& state) {
+    MessageConfig config(SensorData::schema());
+    BinaryMessage message(config);
+    message.setField("sensor_id", 15);
+    message.setField("temperature", -125);
+    message.setField("humidity", 75);
+    message.setField("battery_level", 12);
+    std::vector<uint8_t> buffer(message.getPackedSize());
+
+    for (auto _ : state) {
+        message.packInto(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+
+void BM_StaticUnpack(benchmark::State& state) {
+    SensorData message;
+    uint8_t buffer[SensorData::kPackedSize] = {0x4F, 0xE1, 0x4B, 0x0C};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buffer);
+        message.unpackFrom(buffer, sizeof(buffer));
+        benchmark::DoNotOptimize(message);
+    }
+}
+
+void BM_DynamicUnpack(benchmark::State& state) {
+    MessageConfig config(SensorData::schema());
+    BinaryMessage message(config);
+    std::vector<uint8_t> buffer = {0x4F, 0xE1, 0x4B, 0x0C};
+
+    for (auto _ : state) {
+        message.unpackFrom(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(message);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_StaticPack);
+BENCHMARK(BM_DynamicPack);
+BENCHMARK(BM_StaticUnpack);
+BENCHMARK(BM_DynamicUnpack);
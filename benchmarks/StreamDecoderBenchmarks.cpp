@@ -0,0 +1,96 @@
+#include "StreamDecoder.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+// Capture of tens of megabytes, so every worker gets many chunks
+constexpr size_t kStreamFrames = 4u << 20;
+
+MessageConfig makeSensorConfig() {
+    return MessageConfig(R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "humidity", "bit_width": 8, "signed": false},
+        {"name": "battery_level", "bit_width": 4, "signed": false},
+        {"name": "timestamp", "bit_width": 48, "signed": false},
+        {"name": "pressure", "bit_width": 20, "signed": true}
+    ])"_json);
+}
+
+const std::vector<uint8_t>& capture(size_t frameSize) {
+    static std::vector<uint8_t> frames = [frameSize]() {
+        std::mt19937 rng(3);
+        std::vector<uint8_t> data(kStreamFrames * frameSize);
+        for (auto& byte : data) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        return data;
+    }();
+    return frames;
+}
+
+// Baseline: one BinaryMessage::unpackFrom per frame on a single core
+void BM_StreamUnpackPerMessage(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    BinaryMessage message(config);
+    size_t frameSize = message.getPackedSize();
+    const auto& frames = capture(frameSize);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < kStreamFrames; ++i) {
+            message.unpackFrom(frames.data() + i * frameSize, frameSize);
+            benchmark::DoNotOptimize(message);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kStreamFrames);
+    state.SetBytesProcessed(state.iterations() * frames.size());
+}
+
+void BM_StreamDecodeParallel(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    StreamDecoder decoder(config, static_cast<size_t>(state.range(0)));
+    const auto& frames = capture(decoder.getCodec().getFrameSize());
+    std::vector<std::vector<int64_t>> columns(config.getFields().size(), std::vector<int64_t>(kStreamFrames));
+    std::vector<int64_t*> pointers;
+    for (auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+
+    for (auto _ : state) {
+        decoder.decode(frames.data(), frames.size(), pointers.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kStreamFrames);
+    state.SetBytesProcessed(state.iterations() * frames.size());
+}
+
+void BM_StreamForEachChunkOrdered(benchmark::State& state) {
+    MessageConfig config = makeSensorConfig();
+    StreamDecoder decoder(config, static_cast<size_t>(state.range(0)));
+    const auto& frames = capture(decoder.getCodec().getFrameSize());
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        decoder.forEachChunk(frames.data(), frames.size(), [&sum](const DecodedChunk& chunk) {
+            sum += chunk.columns[1][chunk.frameCount - 1];
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * kStreamFrames);
+    state.SetBytesProcessed(state.iterations() * frames.size());
+}
+
+} // namespace
+
+BENCHMARK(BM_StreamUnpackPerMessage)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StreamDecodeParallel)->RangeMultiplier(2)->Range(1, 16)->ArgName("threads")
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StreamForEachChunkOrdered)->RangeMultiplier(2)->Range(1, 16)->ArgName("threads")
+    ->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,116 @@
+#include "StructBinding.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+struct Telemetry {
+    uint8_t sensorId;
+    int16_t temperature;
+    uint8_t humidity;
+    uint8_t batteryLevel;
+    uint32_t sequence;
+    uint64_t timestamp;
+    bool alarm;
+};
+
+MessageConfig makeTelemetryConfig() {
+    return MessageConfig(R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "humidity", "bit_width": 8, "signed": false},
+        {"name": "battery_level", "bit_width": 4, "signed": false},
+        {"name": "sequence", "bit_width": 32, "signed": false},
+        {"name": "timestamp", "bit_width": 48, "signed": false},
+        {"name": "alarm", "bit_width": 1, "signed": false}
+    ])"_json);
+}
+
+StructBinding<Telemetry> makeBinding(const MessageConfig& config) {
+    StructBinding<Telemetry> binding(config);
+    binding.bind(&Telemetry::sensorId, "sensor_id")
+           .bind(&Telemetry::temperature, "temperature")
+           .bind(&Telemetry::humidity, "humidity")
+           .bind(&Telemetry::batteryLevel, "battery_level")
+           .bind(&Telemetry::sequence, "sequence")
+           .bind(&Telemetry::timestamp, "timestamp")
+           .bind(&Telemetry::alarm, "alarm");
+    return binding;
+}
+
+const Telemetry kSample{17, -250, 61, 9, 123456, 1700000000000ULL, true};
+
+// Baseline: copy the struct into a BinaryMessage by field name, then pack
+void BM_StructPackByName(benchmark::State& state) {
+    MessageConfig config = makeTelemetryConfig();
+    BinaryMessage message(config);
+    std::vector<uint8_t> buffer(message.getPackedSize());
+
+    for (auto _ : state) {
+        message.setField("sensor_id", kSample.sensorId);
+        message.setField("temperature", kSample.temperature);
+        message.setField("humidity", kSample.humidity);
+        message.setField("battery_level", kSample.batteryLevel);
+        message.setField("sequence", kSample.sequence);
+        message.setField("timestamp", static_cast<int64_t>(kSample.timestamp));
+        message.setField("alarm", kSample.alarm);
+        message.packInto(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+
+void BM_StructPackBound(benchmark::State& state) {
+    MessageConfig config = makeTelemetryConfig();
+    StructBinding<Telemetry> binding = makeBinding(config);
+    std::vector<uint8_t> buffer(binding.getPackedSize());
+
+    for (auto _ : state) {
+        binding.pack(kSample, buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+}
+
+void BM_StructUnpackByName(benchmark::State& state) {
+    MessageConfig config = makeTelemetryConfig();
+    StructBinding<Telemetry> binding = makeBinding(config);
+    std::vector<uint8_t> buffer = binding.pack(kSample);
+    BinaryMessage message(config);
+    Telemetry telemetry{};
+
+    for (auto _ : state) {
+        message.unpackFrom(buffer.data(), buffer.size());
+        telemetry.sensorId = static_cast<uint8_t>(message.getField("sensor_id"));
+        telemetry.temperature = static_cast<int16_t>(message.getField("temperature"));
+        telemetry.humidity = static_cast<uint8_t>(message.getField("humidity"));
+        telemetry.batteryLevel = static_cast<uint8_t>(message.getField("battery_level"));
+        telemetry.sequence = static_cast<uint32_t>(message.getField("sequence"));
+        telemetry.timestamp = static_cast<uint64_t>(message.getField("timestamp"));
+        telemetry.alarm = message.getField("alarm") != 0;
+        benchmark::DoNotOptimize(telemetry);
+    }
+}
+
+void BM_StructUnpackBound(benchmark::State& state) {
+    MessageConfig config = makeTelemetryConfig();
+    StructBinding<Telemetry> binding = makeBinding(config);
+    std::vector<uint8_t> buffer = binding.pack(kSample);
+    Telemetry telemetry{};
+
+    for (auto _ : state) {
+        binding.unpack(buffer.data(), buffer.size(), telemetry);
+        benchmark::DoNotOptimize(telemetry);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_StructPackByName);
+BENCHMARK(BM_StructPackBound);
+BENCHMARK(BM_StructUnpackByName);
+BENCHMARK(BM_StructUnpackBound);
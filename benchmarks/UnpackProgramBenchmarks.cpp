@@ -0,0 +1,83 @@
+#include "BenchmarkSchemas.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include "UnpackProgram.hpp"
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+using namespace BinaryMessageLibrary::Benchmarks;
+
+namespace {
+
+// Packed message for the schema of the run, in the requested bit order
+std::vector<uint8_t> packedFor(const MessageConfig& config) {
+    BinaryMessage message(config);
+    auto values = makeValues(config.getFields());
+    for (size_t i = 0; i < values.size(); ++i) {
+        message.setField(FieldHandle(static_cast<uint32_t>(i)), values[i]);
+    }
+    return message.pack();
+}
+
+nlohmann::json orderedSchemaFor(const benchmark::State& state, bool msbFirst) {
+    return msbFirst ? nlohmann::json{{"bit_order", "msb_first"}, {"fields", schemaFor(state)}} : schemaFor(state);
+}
+
+// The per-field loop BinaryMessage::unpackFrom ran before it used the program
+void runLayoutLoop(benchmark::State& state, bool msbFirst) {
+    MessageConfig config(orderedSchemaFor(state, msbFirst));
+    const MessageLayout& layout = config.getLayout();
+    auto buffer = packedFor(config);
+    std::vector<int64_t> values(layout.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < layout.size(); ++i) {
+            values[i] = layout.extract(i, buffer.data(), buffer.size());
+        }
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(widthProfileName(static_cast<WidthProfile>(state.range(1))));
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+void runProgram(benchmark::State& state, bool msbFirst) {
+    MessageConfig config(orderedSchemaFor(state, msbFirst));
+    const MessageLayout& layout = config.getLayout();
+    const UnpackProgram& program = config.getUnpackProgram();
+    auto buffer = packedFor(config);
+    std::vector<int64_t> values(layout.size());
+
+    for (auto _ : state) {
+        program.run(layout, buffer.data(), buffer.size(), values.data(), nullptr);
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(widthProfileName(static_cast<WidthProfile>(state.range(1))));
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+
+void BM_UnpackLayoutLoop(benchmark::State& state) {
+    runLayoutLoop(state, false);
+}
+
+void BM_UnpackProgram(benchmark::State& state) {
+    runProgram(state, false);
+}
+
+void BM_UnpackLayoutLoopMsbFirst(benchmark::State& state) {
+    runLayoutLoop(state, true);
+}
+
+void BM_UnpackProgramMsbFirst(benchmark::State& state) {
+    runProgram(state, true);
+}
+
+} // namespace
+
+BENCHMARK(BM_UnpackLayoutLoop)->Apply(SchemaMatrix);
+BENCHMARK(BM_UnpackProgram)->Apply(SchemaMatrix);
+BENCHMARK(BM_UnpackLayoutLoopMsbFirst)->Apply(SchemaMatrix);
+BENCHMARK(BM_UnpackProgramMsbFirst)->Apply(SchemaMatrix);
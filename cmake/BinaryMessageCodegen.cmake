@@ -0,0 +1,47 @@
+# binary_message_generate_codecs(<target> <definitions.json> [NAMESPACE <ns>])
+#
+# Runs binary_message_codegen on a BinaryMessageFactory-style JSON file at build
+# time and makes the generated headers available to <target>. The generator
+# writes one header per message type plus <definitions>_codecs.hpp including
+# all of them, into a per-target directory that is added to the include path.
+function(binary_message_generate_codecs TARGET DEFINITIONS)
+    cmake_parse_arguments(CODEGEN "" "NAMESPACE" "" ${ARGN})
+    if(NOT CODEGEN_NAMESPACE)
+        set(CODEGEN_NAMESPACE generated)
+    endif()
+
+    get_filename_component(definitions_path ${DEFINITIONS} ABSOLUTE)
+    get_filename_component(definitions_name ${DEFINITIONS} NAME_WE)
+    set(output_dir ${CMAKE_CURRENT_BINARY_DIR}/${TARGET}_generated)
+    set(umbrella ${output_dir}/${definitions_name}_codecs.hpp)
+
+    # The per-type headers are byproducts, so Ninja and clean know about them.
+    # Their names come from the message types, read at configure time; editing
+    # the definitions re-runs CMake to pick up added or removed types.
+    set(byproducts)
+    if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.19)
+        file(READ ${definitions_path} definitions_json)
+        string(JSON type_count ERROR_VARIABLE json_error LENGTH "${definitions_json}")
+        if(NOT json_error AND type_count GREATER 0)
+            math(EXPR last_type "${type_count} - 1")
+            foreach(index RANGE ${last_type})
+                string(JSON type MEMBER "${definitions_json}" ${index})
+                list(APPEND byproducts ${output_dir}/${type}.hpp)
+            endforeach()
+        endif()
+        set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${definitions_path})
+    endif()
+
+    file(MAKE_DIRECTORY ${output_dir})
+    add_custom_command(
+        OUTPUT ${umbrella}
+        BYPRODUCTS ${byproducts}
+        COMMAND binary_message_codegen ${definitions_path} ${output_dir} ${CODEGEN_NAMESPACE}
+        DEPENDS binary_message_codegen ${definitions_path}
+        COMMENT "Generating message codecs from ${DEFINITIONS}"
+        VERBATIM
+    )
+
+    target_sources(${TARGET} PRIVATE ${umbrella})
+    target_include_directories(${TARGET} PRIVATE ${output_dir})
+endfunction()
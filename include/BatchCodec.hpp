@@ -0,0 +1,115 @@
+#pragma once
+
+#include "MessageConfig.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Encodes and decodes arrays of same-typed frames to and from columns.
+ *
+ * Instead of unpacking each frame into its own BinaryMessage, the batch codec
+ * walks the message layout once per field and moves that field for every frame
+ * in a tight loop, writing one int64_t column per field. This amortizes the
+ * layout walk over the batch and leaves the compiler a simple strided loop to
+ * vectorize.
+ *
+ * Frames are expected at a fixed stride from each other, which may be larger than
+ * the packed frame size (e.g. for padded records). The frame buffer must hold at
+ * least (count - 1) * stride + getFrameSize() bytes.
+ */
+class BatchCodec {
+public:
+    /**
+     * @brief Constructs a batch codec for the given message configuration.
+     *
+     * @param config The message configuration; must outlive the codec.
+     *
+     * @throws std::runtime_error if the message has array or Bytes fields.
+     */
+    explicit BatchCodec(const MessageConfig& config);
+
+    /**
+     * @brief Gets the packed size of a single frame in bytes.
+     *
+     * @return size_t The frame size.
+     */
+    size_t getFrameSize() const;
+
+    /**
+     * @brief Gets the number of columns, i.e. the number of fields.
+     *
+     * @return size_t The column count.
+     */
+    size_t getColumnCount() const;
+
+    /**
+     * @brief Decodes @p count frames into per-field columns.
+     *
+     * @param frames Pointer to the first frame.
+     * @param count Number of frames to decode.
+     * @param stride Distance in bytes between the starts of consecutive frames.
+     * @param columns One output array per field, in field order, each holding
+     *        at least @p count values.
+     *
+     * @throws std::runtime_error if the stride is smaller than the frame size.
+     */
+    void decode(const uint8_t* frames, size_t count, size_t stride, int64_t* const* columns) const;
+
+    /**
+     * @brief Decodes @p count frames into newly allocated per-field columns.
+     *
+     * @param frames Pointer to the first frame.
+     * @param count Number of frames to decode.
+     * @param stride Distance in bytes between the starts of consecutive frames.
+     * @return std::vector<std::vector<int64_t>> One column per field.
+     *
+     * @throws std::runtime_error if the stride is smaller than the frame size.
+     */
+    std::vector<std::vector<int64_t>> decode(const uint8_t* frames, size_t count, size_t stride) const;
+
+    /**
+     * @brief Encodes @p count frames from per-field columns.
+     *
+     * Each frame's getFrameSize() bytes are fully rewritten; bytes between frames
+     * (when the stride exceeds the frame size) are left untouched. Values are
+     * truncated to their field width, as in BinaryMessage::pack().
+     *
+     * @param columns One input array per field, in field order, each holding at
+     *        least @p count values.
+     * @param count Number of frames to encode.
+     * @param frames Pointer to where the first frame is written.
+     * @param stride Distance in bytes between the starts of consecutive frames.
+     *
+     * @throws std::runtime_error if the stride is smaller than the frame size.
+     */
+    void encode(const int64_t* const* columns, size_t count, uint8_t* frames, size_t stride) const;
+
+    /**
+     * @brief Gets the message configuration the codec was built for.
+     *
+     * @return const MessageConfig& The message configuration.
+     */
+    const MessageConfig& getConfig() const;
+
+private:
+    const MessageConfig& config_;
+
+    /**
+     * @brief Validates that frames of this type fit at the given stride.
+     *
+     * @throws std::runtime_error if the stride is smaller than the frame size.
+     */
+    void validateStride(size_t count, size_t stride) const;
+
+    /**
+     * @brief Decodes one column of a field that is not in the default LSB-first,
+     *        little-endian wire order.
+     */
+    void decodeOrderedColumn(size_t field, const uint8_t* frames, size_t count, size_t stride,
+                             int64_t* column) const;
+};
+
+} // namespace BinaryMessageLibrary
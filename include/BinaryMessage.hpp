@@ -4,7 +4,15 @@
 #include <string>
 #include <cstdint>
 #include <memory>
+#include <cstddef>
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_span)
+#include <span>
+#endif
 #include "FieldConfig.hpp"
+#include "FieldHandle.hpp"
 #include "MessageConfig.hpp"
 
 namespace BinaryMessageLibrary {
@@ -14,7 +22,9 @@ namespace BinaryMessageLibrary {
  * 
  * This class provides functionality to create, manipulate, pack, and unpack binary messages
  * according to a specified configuration. It supports fields of varying bit widths and
- * both signed and unsigned values.
+ * both signed and unsigned values, fixed-size arrays of such values, and raw byte
+ * blobs. Array and Bytes fields are kept in their packed form, so messages with
+ * large ones pack and unpack with block copies rather than per-element work.
  */
 class BinaryMessage {
 public:
@@ -26,6 +36,20 @@ public:
      * @throws std::runtime_error if the configuration is invalid.
      */
     explicit BinaryMessage(const MessageConfig& config);
+
+    /**
+     * @brief Constructs a new BinaryMessage object that shares ownership of its schema.
+     * 
+     * The schema stays alive for as long as the message does, so the message can
+     * be moved, copied and handed to other threads independently of whoever
+     * created it. With the other constructor the caller guarantees the
+     * configuration outlives the message.
+     * 
+     * @param schema The shared, immutable message configuration to use.
+     * 
+     * @throws std::runtime_error if the schema is null.
+     */
+    explicit BinaryMessage(MessageSchema schema);
     
     /**
      * @brief Sets the value of a field in the message.
@@ -33,8 +57,8 @@ public:
      * @param name The name of the field to set.
      * @param value The value to set.
      * 
-     * @throws std::runtime_error if the field name is invalid or if the value is
-     *         outside the valid range for the field.
+     * @throws std::runtime_error if the field name is invalid, the field is not
+     *         a scalar, or the value is outside the valid range for the field.
      */
     void setField(const std::string& name, int64_t value);
 
@@ -44,9 +68,175 @@ public:
      * @param name The name of the field to get.
      * @return int64_t The value of the field.
      * 
-     * @throws std::runtime_error if the field name is invalid.
+     * @throws std::runtime_error if the field name is invalid or the field is
+     *         not a scalar.
      */
     int64_t getField(const std::string& name) const;
+
+    /**
+     * @brief Sets the value of a field through a pre-resolved handle.
+     * 
+     * Unlike the name-based overload this does no string work; resolve the
+     * handle once with MessageConfig::getFieldHandle() and reuse it.
+     * 
+     * @param field Handle of the field to set.
+     * @param value The value to set.
+     * 
+     * @throws std::runtime_error if the handle is invalid, the field is not a
+     *         scalar, or the value is outside the valid range for the field.
+     */
+    void setField(FieldHandle field, int64_t value);
+
+    /**
+     * @brief Gets the value of a field through a pre-resolved handle.
+     * 
+     * @param field Handle of the field to get.
+     * @return int64_t The value of the field.
+     * 
+     * @throws std::runtime_error if the handle is invalid or the field is not a
+     *         scalar.
+     */
+    int64_t getField(FieldHandle field) const;
+
+    /**
+     * @brief Sets every element of an array (or Bytes) field.
+     * 
+     * @param field Handle of the field to set.
+     * @param values The element values.
+     * @param count Number of values; must equal the field's element count.
+     * 
+     * @throws std::runtime_error if the handle is invalid, the field is a
+     *         scalar, the count does not match, or a value is outside the valid
+     *         range for the elements; the field is then left unchanged.
+     */
+    void setArray(FieldHandle field, const int64_t* values, size_t count);
+
+    /**
+     * @brief Sets every element of an array (or Bytes) field by name.
+     * 
+     * @see setArray(FieldHandle, const int64_t*, size_t)
+     */
+    void setArray(const std::string& name, const int64_t* values, size_t count);
+
+    /**
+     * @brief Gets every element of an array (or Bytes) field.
+     * 
+     * @param field Handle of the field to get.
+     * @param values Destination for the element values.
+     * @param count Room at @p values; must equal the field's element count.
+     * 
+     * @throws std::runtime_error if the handle is invalid, the field is a
+     *         scalar, or the count does not match.
+     */
+    void getArray(FieldHandle field, int64_t* values, size_t count) const;
+
+    /**
+     * @brief Gets every element of an array (or Bytes) field by name.
+     * 
+     * @see getArray(FieldHandle, int64_t*, size_t)
+     */
+    void getArray(const std::string& name, int64_t* values, size_t count) const;
+
+    /**
+     * @brief Sets one element of an array (or Bytes) field.
+     * 
+     * @param field Handle of the field to set.
+     * @param element Index of the element.
+     * @param value The value to set.
+     * 
+     * @throws std::runtime_error if the handle is invalid, the field is a
+     *         scalar, the element index is out of range, or the value is outside
+     *         the valid range for the elements.
+     */
+    void setElement(FieldHandle field, size_t element, int64_t value);
+
+    /**
+     * @brief Gets one element of an array (or Bytes) field.
+     * 
+     * @param field Handle of the field to get.
+     * @param element Index of the element.
+     * @return int64_t The element value.
+     * 
+     * @throws std::runtime_error if the handle is invalid, the field is a
+     *         scalar, or the element index is out of range.
+     */
+    int64_t getElement(FieldHandle field, size_t element) const;
+
+    /**
+     * @brief Copies raw bytes into a Bytes field.
+     * 
+     * @param field Handle of the field to set.
+     * @param data The bytes, in wire order.
+     * @param size Number of bytes; must equal the field's byte count.
+     * 
+     * @throws std::runtime_error if the handle is invalid, the field is not a
+     *         Bytes field, or the size does not match.
+     */
+    void setBytes(FieldHandle field, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Copies raw bytes into a Bytes field by name.
+     * 
+     * @see setBytes(FieldHandle, const uint8_t*, size_t)
+     */
+    void setBytes(const std::string& name, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Copies the raw bytes of a Bytes field out of the message.
+     * 
+     * @param field Handle of the field to get.
+     * @param data Destination for the bytes.
+     * @param size Room at @p data; must equal the field's byte count.
+     * 
+     * @throws std::runtime_error if the handle is invalid, the field is not a
+     *         Bytes field, or the size does not match.
+     */
+    void getBytes(FieldHandle field, uint8_t* data, size_t size) const;
+
+    /**
+     * @brief Copies the raw bytes of a Bytes field out of the message by name.
+     * 
+     * @see getBytes(FieldHandle, uint8_t*, size_t)
+     */
+    void getBytes(const std::string& name, uint8_t* data, size_t size) const;
+
+#if defined(__cpp_lib_span)
+    /**
+     * @brief Sets every element of an array (or Bytes) field from a span.
+     * 
+     * @see setArray(FieldHandle, const int64_t*, size_t)
+     */
+    void setArray(FieldHandle field, std::span<const int64_t> values) {
+        setArray(field, values.data(), values.size());
+    }
+
+    /**
+     * @brief Gets every element of an array (or Bytes) field into a span.
+     * 
+     * @see getArray(FieldHandle, int64_t*, size_t)
+     */
+    void getArray(FieldHandle field, std::span<int64_t> values) const {
+        getArray(field, values.data(), values.size());
+    }
+
+    /**
+     * @brief Copies raw bytes from a span into a Bytes field.
+     * 
+     * @see setBytes(FieldHandle, const uint8_t*, size_t)
+     */
+    void setBytes(FieldHandle field, std::span<const uint8_t> data) {
+        setBytes(field, data.data(), data.size());
+    }
+
+    /**
+     * @brief Copies the raw bytes of a Bytes field into a span.
+     * 
+     * @see getBytes(FieldHandle, uint8_t*, size_t)
+     */
+    void getBytes(FieldHandle field, std::span<uint8_t> data) const {
+        getBytes(field, data.data(), data.size());
+    }
+#endif
     
     /**
      * @brief Packs the message into a binary buffer.
@@ -68,6 +258,66 @@ public:
      */
     void unpack(const std::vector<uint8_t>& buffer);
 
+    /**
+     * @brief Gets the number of bytes the packed message occupies.
+     * 
+     * @return size_t The packed size in bytes (bits rounded up).
+     */
+    size_t getPackedSize() const;
+
+    /**
+     * @brief Packs the message into a caller-provided buffer.
+     * 
+     * Writes exactly getPackedSize() bytes at the start of the buffer, padding
+     * bits included, and never allocates. Bytes past the packed size are left
+     * untouched.
+     * 
+     * @param buffer Destination buffer.
+     * @param size Size of the destination buffer in bytes.
+     * @return size_t The number of bytes written.
+     * 
+     * @throws std::runtime_error if the buffer is too small to hold the message.
+     */
+    size_t packInto(uint8_t* buffer, size_t size) const;
+
+    /**
+     * @brief Unpacks the message from a caller-provided buffer in place.
+     * 
+     * @param buffer Source buffer, e.g. a slice of a ring or socket buffer.
+     * @param size Number of readable bytes at @p buffer.
+     * @return size_t The number of bytes consumed (getPackedSize()).
+     * 
+     * @throws std::runtime_error if the buffer is too small to hold the message.
+     */
+    size_t unpackFrom(const uint8_t* buffer, size_t size);
+
+#if defined(__cpp_lib_span)
+    /**
+     * @brief Packs the message into a caller-provided span.
+     * 
+     * @see packInto(uint8_t*, size_t)
+     */
+    size_t packInto(std::span<uint8_t> buffer) const {
+        return packInto(buffer.data(), buffer.size());
+    }
+
+    /**
+     * @brief Unpacks the message from a caller-provided span.
+     * 
+     * @see unpackFrom(const uint8_t*, size_t)
+     */
+    size_t unpackFrom(std::span<const uint8_t> buffer) {
+        return unpackFrom(buffer.data(), buffer.size());
+    }
+#endif
+
+    /**
+     * @brief Sets every field, and every element of array and Bytes fields, back to 0.
+     * 
+     * Keeps the value storage, so a message can be reused without allocating.
+     */
+    void reset();
+
     /**
      * @brief Gets the message configuration.
      * 
@@ -75,38 +325,63 @@ public:
      */
     const MessageConfig& getConfig() const;
 
+    /**
+     * @brief Gets the shared schema the message was created with.
+     * 
+     * @return MessageSchema The schema, or null if the message was constructed
+     *         from a plain MessageConfig reference.
+     */
+    const MessageSchema& getSchema() const;
+
 private:
-    const MessageConfig& config_;
+    MessageSchema schema_;
+    const MessageConfig* config_;
     std::vector<int64_t> field_values_;
+    // Array and Bytes fields in packed form, at MessageLayout::blockOffsets()
+    std::vector<uint8_t> block_data_;
     
     /**
      * @brief Gets the index of a field in the field_values_ vector.
      * 
-     * @param name The name of the field to find.
+     * @param field Handle of the field to find.
      * @return size_t The index of the field.
      * 
-     * @throws std::runtime_error if the field name is invalid.
+     * @throws std::runtime_error if the handle is invalid.
      */
-    size_t getFieldOffset(const std::string& name) const;
+    size_t getFieldOffset(FieldHandle field) const;
 
     /**
-     * @brief Validates that a field name exists in the configuration.
+     * @brief Gets the index of a scalar field.
      * 
-     * @param name The field name to validate.
+     * @throws std::runtime_error if the handle is invalid or the field is not a scalar.
+     */
+    size_t getScalarOffset(FieldHandle field) const;
+
+    /**
+     * @brief Gets the index of an array or Bytes field.
+     * 
+     * @param field Handle of the field to find.
+     * @param bytesOnly Whether only Bytes fields are accepted.
      * 
-     * @throws std::runtime_error if the field name is invalid.
+     * @throws std::runtime_error if the handle is invalid or the field is of the wrong kind.
+     */
+    size_t getBlockOffset(FieldHandle field, bool bytesOnly) const;
+
+    /**
+     * @brief Gets the packed storage of block field @p index.
      */
-    void validateFieldName(const std::string& name) const;
+    uint8_t* blockData(size_t index);
+    const uint8_t* blockData(size_t index) const;
 
     /**
      * @brief Validates that a value is within the valid range for a field.
      * 
-     * @param name The name of the field to validate against.
+     * @param index The index of the field to validate against.
      * @param value The value to validate.
      * 
      * @throws std::runtime_error if the value is outside the valid range.
      */
-    void validateFieldValue(const std::string& name, int64_t value) const;
+    void validateFieldValue(size_t index, int64_t value) const;
 };
 
 } // namespace BinaryMessageLibrary 
\ No newline at end of file
@@ -2,7 +2,13 @@
 
 #include "BinaryMessage.hpp"
 #include "MessageConfig.hpp"
+#include "MessagePool.hpp"
+#include "SchemaSnapshot.hpp"
 #include <nlohmann/json.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <memory>
@@ -16,6 +22,13 @@ namespace BinaryMessageLibrary {
  * This class manages multiple message definitions and provides methods to create
  * BinaryMessage objects for specific message types. The configuration file can
  * contain multiple message definitions, each with its own set of fields.
+ * Definitions can be replaced at runtime with loadConfigurations() while other
+ * threads keep using the factory.
+ *
+ * Processes that load many message types at startup can use
+ * loadConfigurationFile() with a snapshot path: the first start parses the JSON
+ * file and writes a binary SchemaSnapshot next to it, later starts map the
+ * snapshot and skip JSON parsing and validation as long as the file is unchanged.
  */
 class BinaryMessageFactory {
 public:
@@ -29,16 +42,55 @@ public:
      */
     explicit BinaryMessageFactory(const nlohmann::json& config);
 
+    /**
+     * @brief Constructs a factory without message types.
+     * 
+     * Types are added with loadConfigurations(), loadConfigurationFile() or
+     * loadSnapshot().
+     */
+    BinaryMessageFactory();
+
+    ~BinaryMessageFactory();
+
+    BinaryMessageFactory(const BinaryMessageFactory&) = delete;
+    BinaryMessageFactory& operator=(const BinaryMessageFactory&) = delete;
+
     /**
      * @brief Creates a new BinaryMessage object for the specified message type.
      * 
      * @param messageType The type of message to create.
-     * @return std::unique_ptr<BinaryMessage> A new BinaryMessage object.
+     * @return std::unique_ptr<BinaryMessage> A new BinaryMessage object. It shares
+     *         ownership of its schema and may outlive the factory.
      * 
      * @throws std::runtime_error if the message type is not found in the configuration.
      */
     std::unique_ptr<BinaryMessage> createMessage(const std::string& messageType) const;
 
+    /**
+     * @brief Takes a recyclable message of the specified type from the factory's pool.
+     * 
+     * Each message type has its own MessagePool, so once the pool has warmed up
+     * acquiring and releasing a message performs no heap allocation. The message
+     * starts with all fields set to 0 and returns to the pool when the handle is
+     * destroyed; the handle must not outlive the factory.
+     * 
+     * @param messageType The type of message to acquire.
+     * @return PooledMessage Handle to a pooled BinaryMessage object.
+     * 
+     * @throws std::runtime_error if the message type is not found in the configuration.
+     */
+    PooledMessage acquire(const std::string& messageType) const;
+
+    /**
+     * @brief Gets the pool backing acquire() for a specific message type.
+     * 
+     * @param messageType The type of message to get the pool for.
+     * @return MessagePool& The message pool, e.g. to reserve() ahead of time.
+     * 
+     * @throws std::runtime_error if the message type is not found in the configuration.
+     */
+    MessagePool& getMessagePool(const std::string& messageType) const;
+
     /**
      * @brief Gets the configuration for a specific message type.
      * 
@@ -49,6 +101,20 @@ public:
      */
     const MessageConfig& getMessageConfig(const std::string& messageType) const;
 
+    /**
+     * @brief Gets the shared schema for a specific message type.
+     * 
+     * Schemas are interned in SchemaRegistry::global(), so factories loaded from
+     * equal definitions share them. Holding the schema keeps it alive after the
+     * factory is gone.
+     * 
+     * @param messageType The type of message to get the schema for.
+     * @return MessageSchema The shared message configuration.
+     * 
+     * @throws std::runtime_error if the message type is not found in the configuration.
+     */
+    MessageSchema getSchema(const std::string& messageType) const;
+
     /**
      * @brief Checks if a message type exists in the configuration.
      * 
@@ -65,11 +131,23 @@ public:
      */
     std::vector<std::string> getMessageTypes() const;
 
-private:
-    std::unordered_map<std::string, MessageConfig> messageConfigs;
-
     /**
-     * @brief Loads message configurations from the JSON configuration.
+     * @brief Replaces the factory's message definitions, safely while it is in use.
+     * 
+     * The new type table is built and validated completely before it is
+     * published with a single atomic pointer swap, so a failed reload leaves
+     * the factory unchanged and readers observe either the old or the new set
+     * of types, never a mix. Readers (createMessage(), acquire(), getSchema(),
+     * getMessageConfig(), ...) never take a lock; only concurrent reloads are
+     * serialized. The old table is freed once every reader that could still
+     * see it has finished (RCU-style grace period).
+     * 
+     * Messages already created keep the schema they were created with. The
+     * pool of a replaced type, and the schema it holds, is retained while any of
+     * its messages is handed out and at least until the next reload, so pooled
+     * handles stay valid and references returned by getMessageConfig() or
+     * getMessagePool() survive one reload. A later reload releases the pool once
+     * all its messages have returned; hold getSchema() to keep a schema longer.
      * 
      * @param config JSON object containing message definitions.
      * 
@@ -77,6 +155,100 @@ private:
      */
     void loadConfigurations(const nlohmann::json& config);
 
+    /**
+     * @brief Replaces the factory's message definitions with those of a JSON file,
+     *        going through a binary snapshot when one is current.
+     * 
+     * The file is memory-mapped and checksummed. If @p snapshotPath names a
+     * snapshot made from exactly this file by the same snapshot format version,
+     * the types are loaded from it (see loadSnapshot()) and the JSON is not
+     * parsed. Otherwise the JSON is loaded as by loadConfigurations() and, when
+     * @p snapshotPath is given, a fresh snapshot is written there for the next
+     * start. The snapshot is written to a uniquely named temporary file and
+     * renamed over the old one, so concurrent starts each write their own file
+     * and readers see either the old or the new snapshot, never a partial one.
+     * If it cannot be written or replaced, the factory is loaded all the same.
+     * 
+     * @param path Path of the JSON configuration file.
+     * @param snapshotPath Path of the snapshot, or empty to load the JSON only.
+     * @return true if the types came from the snapshot, false if from the JSON.
+     * 
+     * @throws std::runtime_error if the file cannot be read or its configuration
+     *         is invalid.
+     */
+    bool loadConfigurationFile(const std::string& path, const std::string& snapshotPath = std::string());
+
+    /**
+     * @brief Replaces the factory's message definitions with those of a snapshot.
+     * 
+     * Safe while the factory is in use, like loadConfigurations(). Schemas are
+     * built directly from the snapshot's binary form.
+     * 
+     * @param data The snapshot, e.g. a MappedFile's contents.
+     * @param size Size of the snapshot in bytes.
+     * @param sourceChecksum SchemaSnapshot::checksum() of the configuration the
+     *        snapshot must have been made from.
+     * @return true if the snapshot was loaded; false if it is stale, in which
+     *         case the factory is unchanged.
+     * 
+     * @throws std::runtime_error if a snapshot that passes its checks is malformed.
+     */
+    bool loadSnapshot(const uint8_t* data, size_t size, uint64_t sourceChecksum);
+
+    /**
+     * @brief Appends a snapshot of the factory's current message definitions.
+     * 
+     * @param out Destination buffer.
+     * @param sourceChecksum SchemaSnapshot::checksum() of the configuration the
+     *        definitions were loaded from.
+     */
+    void writeSnapshot(std::vector<uint8_t>& out, uint64_t sourceChecksum) const;
+
+private:
+    struct TypeTable;
+
+    // Two sets of reader counters, alternated by the writer to detect the grace
+    // period. Each set is sharded by thread, one cache line per shard, so
+    // concurrent readers do not all update the same line.
+    static constexpr size_t kReaderShards = 16;
+
+    struct alignas(64) ReaderCount {
+        std::atomic<uint64_t> value{0};
+    };
+
+    /**
+     * @brief RAII read-side critical section pinning the current type table.
+     */
+    class ReadSection;
+
+    std::atomic<const TypeTable*> typeTable{nullptr};
+    std::atomic<uint64_t> readEpoch{0};
+    mutable ReaderCount readerCounts[2][kReaderShards];
+    std::mutex writerMutex;
+    std::unordered_map<const MessageConfig*, std::shared_ptr<MessagePool>> retiredPools;
+
+    /**
+     * @brief Blocks until no reader can still hold a previously published table.
+     */
+    void waitForReaders();
+
+    /**
+     * @brief Validates a JSON configuration and interns its schemas.
+     * 
+     * @throws std::runtime_error if the configuration is invalid.
+     */
+    SchemaSnapshot::TypeList buildTypes(const nlohmann::json& config);
+
+    /**
+     * @brief Publishes a new type table, reusing the pools of unchanged types.
+     */
+    void publish(SchemaSnapshot::TypeList types);
+
+    /**
+     * @brief Atomically replaces the snapshot file; failures are ignored.
+     */
+    static void writeSnapshotFile(const std::string& snapshotPath, const std::vector<uint8_t>& snapshot);
+
     /**
      * @brief Validates a message definition in the configuration.
      * 
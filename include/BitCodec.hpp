@@ -0,0 +1,345 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Word-at-a-time primitives for moving bit fields in and out of packed buffers.
+ *
+ * The wire layout numbers bits LSB-first within little-endian bytes: bit N of the
+ * message is bit (N % 8) of byte (N / 8). A field that starts at byte B with a bit
+ * shift S therefore occupies bits [S, S + width) of the little-endian 64-bit word
+ * loaded at B, plus the low bits of byte B + 8 when S + width exceeds 64.
+ *
+ * MSB-first messages number bits from the other end of each byte: bit N is bit
+ * 7 - (N % 8) of byte N / 8. The *Msb functions move fields of such messages
+ * through big-endian words, in which a field starting at byte B with bit shift
+ * S occupies the bits just below the top S bits of the word loaded at B, with
+ * the field's most significant bit first.
+ *
+ * All functions take the size of the buffer they operate on and never touch
+ * memory outside of it; words that would run past the end are assembled from the
+ * remaining bytes instead.
+ */
+namespace BitCodec {
+
+/**
+ * @brief Returns a mask with the low @p width bits set.
+ *
+ * @param width Number of bits, between 1 and 64.
+ */
+inline uint64_t lowMask(unsigned width) {
+    return width >= 64 ? ~0ULL : ((1ULL << width) - 1);
+}
+
+/**
+ * @brief Reverses the byte order of a 64-bit word.
+ */
+inline uint64_t byteSwap64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(word);
+#else
+    word = ((word & 0x00FF00FF00FF00FFULL) << 8) | ((word >> 8) & 0x00FF00FF00FF00FFULL);
+    word = ((word & 0x0000FFFF0000FFFFULL) << 16) | ((word >> 16) & 0x0000FFFF0000FFFFULL);
+    return (word << 32) | (word >> 32);
+#endif
+}
+
+/**
+ * @brief Reverses the bit order of a 64-bit word.
+ */
+inline uint64_t bitReverse64(uint64_t word) {
+    word = byteSwap64(word);
+    word = ((word & 0x0F0F0F0F0F0F0F0FULL) << 4) | ((word >> 4) & 0x0F0F0F0F0F0F0F0FULL);
+    word = ((word & 0x3333333333333333ULL) << 2) | ((word >> 2) & 0x3333333333333333ULL);
+    return ((word & 0x5555555555555555ULL) << 1) | ((word >> 1) & 0x5555555555555555ULL);
+}
+
+/**
+ * @brief Loads 8 bytes as a little-endian 64-bit word from an unaligned address.
+ */
+inline uint64_t loadLE64(const uint8_t* p) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+/**
+ * @brief Stores a 64-bit word as 8 little-endian bytes at an unaligned address.
+ */
+inline void storeLE64(uint8_t* p, uint64_t word) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    std::memcpy(p, &word, sizeof(word));
+}
+
+/**
+ * @brief Loads the first @p count (< 8) bytes at @p p as a little-endian word.
+ */
+inline uint64_t loadLEPartial(const uint8_t* p, size_t count) {
+    uint64_t word = 0;
+    for (size_t i = 0; i < count; ++i) {
+        word |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return word;
+}
+
+/**
+ * @brief Stores the low @p count (< 8) bytes of a word at @p p in little-endian order.
+ */
+inline void storeLEPartial(uint8_t* p, uint64_t word, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        p[i] = static_cast<uint8_t>(word >> (8 * i));
+    }
+}
+
+/**
+ * @brief Loads 8 bytes as a big-endian 64-bit word from an unaligned address.
+ */
+inline uint64_t loadBE64(const uint8_t* p) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__
+    word = byteSwap64(word);
+#endif
+    return word;
+}
+
+/**
+ * @brief Stores a 64-bit word as 8 big-endian bytes at an unaligned address.
+ */
+inline void storeBE64(uint8_t* p, uint64_t word) {
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__
+    word = byteSwap64(word);
+#endif
+    std::memcpy(p, &word, sizeof(word));
+}
+
+/**
+ * @brief Loads the first @p count (< 8) bytes at @p p into the top bytes of a
+ *        big-endian word.
+ */
+inline uint64_t loadBEPartial(const uint8_t* p, size_t count) {
+    uint64_t word = 0;
+    for (size_t i = 0; i < count; ++i) {
+        word |= static_cast<uint64_t>(p[i]) << (56 - 8 * i);
+    }
+    return word;
+}
+
+/**
+ * @brief Stores the top @p count (< 8) bytes of a word at @p p in big-endian order.
+ */
+inline void storeBEPartial(uint8_t* p, uint64_t word, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        p[i] = static_cast<uint8_t>(word >> (56 - 8 * i));
+    }
+}
+
+/**
+ * @brief Extracts a raw (zero-extended) field value from a packed buffer.
+ *
+ * @param buffer The packed buffer.
+ * @param size Size of the buffer in bytes; must cover the whole field.
+ * @param byteOffset Byte holding the field's lowest bit.
+ * @param shift Position of the field's lowest bit within that byte (0-7).
+ * @param mask Mask with the low bit_width bits set.
+ * @param crossesWord Whether shift + bit_width exceeds 64, i.e. the field
+ *        spills into byte byteOffset + 8.
+ * @return uint64_t The field bits, right-aligned.
+ */
+inline uint64_t extract(const uint8_t* buffer, size_t size, size_t byteOffset,
+                        unsigned shift, uint64_t mask, bool crossesWord) {
+    const uint8_t* p = buffer + byteOffset;
+    uint64_t word = byteOffset + 8 <= size ? loadLE64(p) : loadLEPartial(p, size - byteOffset);
+    uint64_t value = word >> shift;
+    if (crossesWord) {
+        value |= static_cast<uint64_t>(p[8]) << (64 - shift);
+    }
+    return value & mask;
+}
+
+/**
+ * @brief Writes a field value into a packed buffer, leaving all other bits intact.
+ *
+ * Parameters mirror extract(); bits of @p value above the field width are ignored.
+ */
+inline void deposit(uint8_t* buffer, size_t size, size_t byteOffset,
+                    unsigned shift, uint64_t mask, bool crossesWord, uint64_t value) {
+    uint8_t* p = buffer + byteOffset;
+    value &= mask;
+    if (byteOffset + 8 <= size) {
+        uint64_t word = loadLE64(p);
+        word = (word & ~(mask << shift)) | (value << shift);
+        storeLE64(p, word);
+    } else {
+        size_t count = size - byteOffset;
+        uint64_t word = loadLEPartial(p, count);
+        word = (word & ~(mask << shift)) | (value << shift);
+        storeLEPartial(p, word, count);
+    }
+    if (crossesWord) {
+        uint8_t highMask = static_cast<uint8_t>(mask >> (64 - shift));
+        uint8_t highBits = static_cast<uint8_t>(value >> (64 - shift));
+        p[8] = static_cast<uint8_t>((p[8] & ~highMask) | highBits);
+    }
+}
+
+/**
+ * @brief Extracts a raw (zero-extended) field value from an MSB-first buffer.
+ *
+ * @param buffer The packed buffer.
+ * @param size Size of the buffer in bytes; must cover the whole field.
+ * @param byteOffset Byte holding the field's first bit.
+ * @param shift Position of the field's first bit within that byte, counted
+ *        from the most significant bit (0-7).
+ * @param width Bit width of the field, between 1 and 64.
+ * @param crossesWord Whether shift + width exceeds 64.
+ * @return uint64_t The field bits, right-aligned, first bit most significant.
+ */
+inline uint64_t extractMsb(const uint8_t* buffer, size_t size, size_t byteOffset,
+                           unsigned shift, unsigned width, bool crossesWord) {
+    const uint8_t* p = buffer + byteOffset;
+    uint64_t word = byteOffset + 8 <= size ? loadBE64(p) : loadBEPartial(p, size - byteOffset);
+    uint64_t window = word << shift;
+    if (crossesWord) {
+        window |= static_cast<uint64_t>(p[8]) >> (8 - shift);
+    }
+    return window >> (64 - width);
+}
+
+/**
+ * @brief Writes a field value into an MSB-first buffer, leaving all other bits intact.
+ *
+ * Parameters mirror extractMsb(); bits of @p value above the field width are ignored.
+ */
+inline void depositMsb(uint8_t* buffer, size_t size, size_t byteOffset,
+                       unsigned shift, unsigned width, bool crossesWord, uint64_t value) {
+    uint8_t* p = buffer + byteOffset;
+    uint64_t mask = lowMask(width);
+    value &= mask;
+
+    // The word holds the field's top bits; a crossing field leaves the rest for byte 8
+    unsigned spill = crossesWord ? shift + width - 64 : 0;
+    uint64_t wordMask = crossesWord ? mask >> spill : mask << (64 - shift - width);
+    uint64_t wordBits = crossesWord ? value >> spill : value << (64 - shift - width);
+    if (byteOffset + 8 <= size) {
+        storeBE64(p, (loadBE64(p) & ~wordMask) | wordBits);
+    } else {
+        size_t count = size - byteOffset;
+        storeBEPartial(p, (loadBEPartial(p, count) & ~wordMask) | wordBits, count);
+    }
+    if (crossesWord) {
+        uint8_t lowMaskByte = static_cast<uint8_t>(0xFF << (8 - spill));
+        uint8_t lowBits = static_cast<uint8_t>(value << (8 - spill));
+        p[8] = static_cast<uint8_t>((p[8] & ~lowMaskByte) | lowBits);
+    }
+}
+
+/**
+ * @brief Sign-extends the low @p width bits of a raw field value.
+ */
+inline int64_t signExtend(uint64_t raw, unsigned width) {
+    unsigned signShift = 64 - width;
+    return static_cast<int64_t>(raw << signShift) >> signShift;
+}
+
+/**
+ * @brief Convenience wrapper around extract() addressed by absolute bit offset.
+ */
+inline uint64_t extractBits(const uint8_t* buffer, size_t size, size_t bitOffset, unsigned width) {
+    unsigned shift = static_cast<unsigned>(bitOffset % 8);
+    return extract(buffer, size, bitOffset / 8, shift, lowMask(width), shift + width > 64);
+}
+
+/**
+ * @brief Convenience wrapper around deposit() addressed by absolute bit offset.
+ */
+inline void depositBits(uint8_t* buffer, size_t size, size_t bitOffset, unsigned width, uint64_t value) {
+    unsigned shift = static_cast<unsigned>(bitOffset % 8);
+    deposit(buffer, size, bitOffset / 8, shift, lowMask(width), shift + width > 64, value);
+}
+
+/**
+ * @brief Packs a run of equal-width values back to back, LSB-first, from bit 0.
+ *
+ * Values are streamed through a 64-bit accumulator flushed with whole-word
+ * stores. Exactly (count * width + 7) / 8 bytes are written, padding bits zeroed.
+ *
+ * @param count Number of values.
+ * @param width Bit width of each value, between 1 and 64.
+ * @param valueAt Callable returning value i; bits above @p width are ignored.
+ * @param out Destination with room for (count * width + 7) / 8 bytes.
+ */
+template <typename ValueAt>
+void packRun(size_t count, unsigned width, ValueAt&& valueAt, uint8_t* out) {
+    uint64_t mask = lowMask(width);
+    uint64_t accumulator = 0;
+    unsigned filled = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t value = static_cast<uint64_t>(valueAt(i)) & mask;
+        accumulator |= value << filled;
+        if (filled + width >= 64) {
+            storeLE64(out, accumulator);
+            out += 8;
+            accumulator = filled == 0 ? 0 : value >> (64 - filled);
+            filled = filled + width - 64;
+        } else {
+            filled += width;
+        }
+    }
+    storeLEPartial(out, accumulator, (filled + 7) / 8);
+}
+
+/**
+ * @brief Unpacks a run of values written by packRun().
+ *
+ * Values whose 9-byte window lies inside the buffer are loaded without bounds
+ * checks, in groups of eight: a group spans exactly @p width bytes, so every
+ * group has the same per-value offsets and shifts.
+ *
+ * @param data The packed run.
+ * @param size Size of the run in bytes.
+ * @param count Number of values.
+ * @param width Bit width of each value, between 1 and 64.
+ * @param emit Callable invoked as emit(i, raw) with each zero-extended value.
+ */
+template <typename Emit>
+void unpackRun(const uint8_t* data, size_t size, size_t count, unsigned width, Emit&& emit) {
+    uint64_t mask = lowMask(width);
+    size_t unchecked = size < 9 ? 0 : std::min(count, ((size - 9) * 8) / width + 1);
+    size_t groups = unchecked / 8;
+    size_t offsets[8];
+    unsigned shifts[8];
+    for (unsigned j = 0; j < 8; ++j) {
+        offsets[j] = j * width / 8;
+        shifts[j] = j * width % 8;
+    }
+    bool crossesWord = width > 56;
+    for (size_t g = 0; g < groups; ++g) {
+        const uint8_t* base = data + g * width;
+        for (unsigned j = 0; j < 8; ++j) {
+            const uint8_t* p = base + offsets[j];
+            uint64_t value = loadLE64(p) >> shifts[j];
+            if (crossesWord && shifts[j] + width > 64) {
+                value |= static_cast<uint64_t>(p[8]) << (64 - shifts[j]);
+            }
+            emit(g * 8 + j, value & mask);
+        }
+    }
+    for (size_t i = groups * 8; i < count; ++i) {
+        emit(i, extractBits(data, size, i * width, width));
+    }
+}
+
+} // namespace BitCodec
+
+} // namespace BinaryMessageLibrary
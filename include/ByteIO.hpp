@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Varint.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Helpers for the fixed-width little-endian and varint fields of the
+ *        library's file formats (containers, column stores, schema caches).
+ */
+namespace ByteIO {
+
+inline void putU8(std::vector<uint8_t>& out, uint8_t value) {
+    out.push_back(value);
+}
+
+inline void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+inline void putU64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+inline void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    uint8_t bytes[Varint::kMaxBytes];
+    size_t size = Varint::encode(value, bytes);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+/**
+ * @brief Appends a varint length followed by the string's bytes.
+ */
+inline void putString(std::vector<uint8_t>& out, const std::string& value) {
+    putVarint(out, value.size());
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+inline uint32_t getU32(const uint8_t* in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+inline uint64_t getU64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Bounds-checked reader over the byte range [position, end) of a buffer.
+ *
+ * Every read that would run past the end throws std::runtime_error with a
+ * "Malformed <format>: truncated <what>" message.
+ */
+class Reader {
+public:
+    /**
+     * @param data The buffer.
+     * @param position Offset of the first byte to read.
+     * @param end Offset one past the last readable byte.
+     * @param format Name of the format, used in error messages.
+     */
+    Reader(const uint8_t* data, size_t position, size_t end, const char* format)
+        : data_(data), position_(position), end_(end), format_(format) {}
+
+    size_t position() const {
+        return position_;
+    }
+
+    size_t remaining() const {
+        return end_ - position_;
+    }
+
+    uint8_t u8(const char* what) {
+        need(1, what);
+        return data_[position_++];
+    }
+
+    uint32_t u32(const char* what) {
+        need(4, what);
+        uint32_t value = getU32(data_ + position_);
+        position_ += 4;
+        return value;
+    }
+
+    uint64_t u64(const char* what) {
+        need(8, what);
+        uint64_t value = getU64(data_ + position_);
+        position_ += 8;
+        return value;
+    }
+
+    uint64_t varint(const char* what) {
+        uint64_t value;
+        size_t used = Varint::decode(data_ + position_, end_ - position_, value);
+        if (used == 0) {
+            fail(std::string("truncated ") + what);
+        }
+        position_ += used;
+        return value;
+    }
+
+    std::string string(const char* what) {
+        uint64_t length = varint(what);
+        need(length, what);
+        std::string result(reinterpret_cast<const char*>(data_ + position_), static_cast<size_t>(length));
+        position_ += static_cast<size_t>(length);
+        return result;
+    }
+
+    /**
+     * @brief Skips @p size bytes and returns a pointer to the first of them.
+     */
+    const uint8_t* bytes(uint64_t size, const char* what) {
+        need(size, what);
+        const uint8_t* start = data_ + position_;
+        position_ += static_cast<size_t>(size);
+        return start;
+    }
+
+    /**
+     * @brief Throws a "Malformed <format>: <what>" error.
+     */
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error(std::string("Malformed ") + format_ + ": " + what);
+    }
+
+private:
+    const uint8_t* data_;
+    size_t position_;
+    size_t end_;
+    const char* format_;
+
+    void need(uint64_t size, const char* what) const {
+        if (size > end_ - position_) {
+            fail(std::string("truncated ") + what);
+        }
+    }
+};
+
+} // namespace ByteIO
+
+} // namespace BinaryMessageLibrary
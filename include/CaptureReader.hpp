@@ -0,0 +1,182 @@
+#pragma once
+
+#include "BinaryMessage.hpp"
+#include "FrameView.hpp"
+#include "MappedFile.hpp"
+#include "MessageConfig.hpp"
+#include "MessageView.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Zero-copy reader for capture files of back-to-back packed frames.
+ *
+ * A capture file is the concatenation of frames of one message type as written
+ * by BinaryMessage::pack() or packInto(). The reader memory-maps the file and
+ * hands out views into the mapping, which can go straight to
+ * BinaryMessage::unpackFrom(), or, as a whole (data(), size()), to BatchCodec or
+ * StreamDecoder. Nothing is read into the heap.
+ *
+ * Trailing bytes that do not form a whole frame, e.g. from a capture cut off
+ * mid-write, are not part of any frame.
+ */
+class CaptureReader {
+public:
+    /**
+     * @brief Forward iterator over the frames of a capture.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FrameView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const FrameView*;
+        using reference = FrameView;
+
+        Iterator() : position_(nullptr), frame_size_(0) {}
+        Iterator(const uint8_t* position, size_t frameSize) : position_(position), frame_size_(frameSize) {}
+
+        FrameView operator*() const {
+            return FrameView{position_, frame_size_};
+        }
+
+        Iterator& operator++() {
+            position_ += frame_size_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return position_ == other.position_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return position_ != other.position_;
+        }
+
+    private:
+        const uint8_t* position_;
+        size_t frame_size_;
+    };
+
+    /**
+     * @brief Maps a capture file of frames of the given message type.
+     *
+     * @param path Path of the capture file.
+     * @param config The message configuration of every frame; must outlive the reader.
+     * @param pattern Access pattern hint for the OS; sequential by default.
+     *
+     * @throws std::runtime_error if the file cannot be mapped or the message
+     *         type has a packed size of 0.
+     */
+    CaptureReader(const std::string& path, const MessageConfig& config,
+                  AccessPattern pattern = AccessPattern::Sequential);
+
+    /**
+     * @brief Gets the number of complete frames in the capture.
+     *
+     * @return size_t The frame count.
+     */
+    size_t getFrameCount() const;
+
+    /**
+     * @brief Gets the size of a single frame in bytes.
+     *
+     * @return size_t The frame size.
+     */
+    size_t getFrameSize() const;
+
+    /**
+     * @brief Gets the number of trailing bytes that do not form a whole frame.
+     *
+     * @return size_t Bytes after the last complete frame.
+     */
+    size_t getTrailingBytes() const;
+
+    /**
+     * @brief Gets a view of the frame at @p index.
+     *
+     * @param index Index of the frame.
+     * @return FrameView View into the mapping.
+     *
+     * @throws std::runtime_error if the index is out of range.
+     */
+    FrameView frame(size_t index) const;
+
+    /**
+     * @brief Unpacks the frame at @p index into a message, straight from the mapping.
+     *
+     * @param index Index of the frame.
+     * @param message Message of the capture's type to unpack into.
+     *
+     * @throws std::runtime_error if the index is out of range.
+     */
+    void unpack(size_t index, BinaryMessage& message) const;
+
+    /**
+     * @brief Gets a lazily decoding view of the frame at @p index.
+     *
+     * Reading a few fields through the view skips decoding the rest.
+     *
+     * @param index Index of the frame.
+     * @return MessageView View into the mapping.
+     *
+     * @throws std::runtime_error if the index is out of range.
+     */
+    MessageView view(size_t index) const;
+
+    /**
+     * @brief Gets an iterator to the first frame.
+     */
+    Iterator begin() const;
+
+    /**
+     * @brief Gets an iterator past the last complete frame.
+     */
+    Iterator end() const;
+
+    /**
+     * @brief Gets the mapped capture contents.
+     *
+     * @return const uint8_t* Pointer to the first frame, or null for an empty file.
+     */
+    const uint8_t* data() const;
+
+    /**
+     * @brief Gets the size of the capture file in bytes, trailing bytes included.
+     *
+     * @return size_t The file size.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Changes the access pattern hint, e.g. to random before seeking around.
+     *
+     * @param pattern The new access pattern.
+     */
+    void advise(AccessPattern pattern) const;
+
+    /**
+     * @brief Gets the message configuration of the frames.
+     *
+     * @return const MessageConfig& The message configuration.
+     */
+    const MessageConfig& getConfig() const;
+
+private:
+    MappedFile file_;
+    const MessageConfig& config_;
+    size_t frame_size_;
+    size_t frame_count_;
+};
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "BatchCodec.hpp"
+#include "FrameView.hpp"
+#include "MappedFile.hpp"
+#include "MessageConfig.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief How the values of one column are stored within a block.
+ */
+enum class ColumnEncoding : uint8_t {
+    /// The raw field bits, bit_width bits per value.
+    Plain = 0,
+    /// The distance of each value from the block minimum, in as few bits as the
+    /// block's value range needs.
+    FrameOfReference = 1,
+    /// The zigzag-encoded difference of each value from the previous one, in as
+    /// few bits as the largest difference needs. Suits sequence numbers and
+    /// timestamps.
+    Delta = 2,
+    /// Writer setting only: picks, per block and column, whichever of the
+    /// above takes the fewest bits.
+    Auto = 3
+};
+
+/**
+ * @brief Footer statistics of one column chunk.
+ *
+ * Values are in the form BatchCodec decodes them to: sign-extended for signed
+ * fields, zero-extended (and reinterpreted as int64_t) for unsigned ones.
+ */
+struct ColumnStats {
+    /// Number of values in the chunk.
+    uint64_t rowCount;
+
+    /// Smallest value in the chunk.
+    int64_t min;
+
+    /// Largest value in the chunk.
+    int64_t max;
+
+    /// Encoding of the chunk.
+    ColumnEncoding encoding;
+
+    /// Bits per stored value.
+    unsigned packedWidth;
+
+    /// Size of the chunk in bytes.
+    uint64_t byteSize;
+};
+
+/**
+ * @brief Bit-packed columnar file format for analytic scans over decoded fields.
+ *
+ * Rows are grouped into blocks; within a block each field is stored as its own
+ * contiguous chunk of values packed LSB-first at a fixed number of bits (the
+ * field's bit_width with Plain encoding, fewer with frame-of-reference or delta
+ * encoding). A scan over one field therefore reads only that field's chunks,
+ * and the per-chunk min/max statistics in the footer let it skip whole blocks.
+ *
+ * Layout (integers are little-endian, "varint" is LEB128, see Varint):
+ *
+ * @code
+ * header   "BMCS" | version u8
+ * block    chunk... (one per field, in field order, each padded to whole bytes)
+ * footer   schema (see SchemaEncoding) | block count varint | block entry...
+ * entry    offset u64 | row count varint | chunk entry... (one per field)
+ * chunk    encoding u8 | packed width u8 | reference u64 | min u64 | max u64 | byte size varint
+ * trailer  footer offset u64 | "BMCX"
+ * @endcode
+ *
+ * A stored value v decodes to reference + v (frame of reference) or to the
+ * running sum reference + unzigzag(v1) + ... + unzigzag(vi) (delta), with
+ * wrapping 64-bit arithmetic.
+ */
+namespace ColumnStore {
+
+/// Column store format version written by ColumnStoreWriter.
+constexpr uint8_t kVersion = 1;
+
+} // namespace ColumnStore
+
+/**
+ * @brief Writes rows of one message type as a column store.
+ *
+ * Rows are buffered one block at a time in per-field columns and encoded when
+ * the block is full; the footer is written by finish().
+ */
+class ColumnStoreWriter {
+public:
+    /// Default number of rows per block.
+    static constexpr size_t kDefaultBlockRows = 65536;
+
+    /**
+     * @brief Starts a column store for the given message type.
+     *
+     * @param out Output stream; must outlive the writer.
+     * @param config The message configuration; must outlive the writer.
+     * @param blockRows Maximum number of rows per block.
+     * @param encoding Encoding for all columns, or Auto to choose per chunk.
+     *
+     * @throws std::runtime_error if blockRows is 0 or the message has array or
+     *         Bytes fields.
+     */
+    ColumnStoreWriter(std::ostream& out, const MessageConfig& config,
+                      size_t blockRows = kDefaultBlockRows,
+                      ColumnEncoding encoding = ColumnEncoding::Auto);
+
+    /**
+     * @brief Finishes the store if finish() has not been called.
+     *
+     * Errors are swallowed; call finish() explicitly to observe them.
+     */
+    ~ColumnStoreWriter();
+
+    ColumnStoreWriter(const ColumnStoreWriter&) = delete;
+    ColumnStoreWriter& operator=(const ColumnStoreWriter&) = delete;
+
+    /**
+     * @brief Appends rows given as per-field columns.
+     *
+     * Values are truncated to their field width, as in BinaryMessage::pack().
+     *
+     * @param columns One input array per field, in field order, each holding at
+     *        least @p count values.
+     * @param count Number of rows.
+     *
+     * @throws std::runtime_error if the store has been finished or writing fails.
+     */
+    void append(const int64_t* const* columns, size_t count);
+
+    /**
+     * @brief Appends rows given as packed frames.
+     *
+     * @param frames Pointer to the first frame.
+     * @param count Number of frames.
+     * @param stride Distance in bytes between the starts of consecutive frames.
+     *
+     * @throws std::runtime_error if the stride is smaller than the frame size,
+     *         the store has been finished or writing fails.
+     */
+    void appendFrames(const uint8_t* frames, size_t count, size_t stride);
+
+    /**
+     * @brief Encodes and writes the buffered rows as a block, even if it is not full.
+     *
+     * @throws std::runtime_error if writing to the output fails.
+     */
+    void flush();
+
+    /**
+     * @brief Writes the last block, the footer and the trailer.
+     *
+     * @throws std::runtime_error if writing to the output fails.
+     */
+    void finish();
+
+    /**
+     * @brief Gets the number of rows appended so far.
+     */
+    uint64_t getRowCount() const;
+
+private:
+    struct BlockEntry {
+        uint64_t offset;
+        uint64_t rowCount;
+        std::vector<ColumnStats> chunks;
+        std::vector<uint64_t> references;
+    };
+
+    std::ostream& out_;
+    const MessageConfig& config_;
+    BatchCodec codec_;
+    size_t block_rows_;
+    ColumnEncoding encoding_;
+    std::vector<std::vector<int64_t>> columns_;
+    std::vector<int64_t*> column_pointers_;
+    size_t buffered_ = 0;
+    std::vector<uint8_t> chunk_;
+    std::vector<BlockEntry> blocks_;
+    uint64_t row_count_ = 0;
+    uint64_t offset_ = 0;
+    bool finished_ = false;
+
+    /**
+     * @brief Writes bytes to the output and advances the offset.
+     */
+    void emit(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Throws if the store has been finished.
+     */
+    void checkOpen() const;
+};
+
+/**
+ * @brief Reads column stores written by ColumnStoreWriter.
+ *
+ * The reader parses only the footer up front; column chunks are decoded on
+ * demand straight from the underlying bytes (or the file it memory-maps), so
+ * a query touches only the columns and blocks it reads.
+ */
+class ColumnStoreReader {
+public:
+    /**
+     * @brief Reads a column store from memory.
+     *
+     * @param data Store bytes; must stay valid while the reader is used.
+     * @param size Size of the store in bytes.
+     *
+     * @throws std::runtime_error if the store is malformed or unfinished.
+     */
+    ColumnStoreReader(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Memory-maps and reads a column store file.
+     *
+     * @param path Path of the column store file.
+     *
+     * @throws std::runtime_error if the file cannot be mapped or is malformed.
+     */
+    explicit ColumnStoreReader(const std::string& path);
+
+    ColumnStoreReader(const ColumnStoreReader&) = delete;
+    ColumnStoreReader& operator=(const ColumnStoreReader&) = delete;
+
+    /**
+     * @brief Gets the schema of the stored rows, interned in SchemaRegistry::global().
+     */
+    const MessageSchema& getSchema() const;
+
+    /**
+     * @brief Gets the total number of rows.
+     */
+    uint64_t getRowCount() const;
+
+    /**
+     * @brief Gets the number of blocks.
+     */
+    size_t getBlockCount() const;
+
+    /**
+     * @brief Gets the number of rows in a block.
+     *
+     * @throws std::runtime_error if the block is out of range.
+     */
+    uint64_t getBlockRowCount(size_t block) const;
+
+    /**
+     * @brief Gets the number of columns, i.e. the number of fields.
+     */
+    size_t getColumnCount() const;
+
+    /**
+     * @brief Gets the index of the column holding a field.
+     *
+     * @throws std::runtime_error if the schema has no such field.
+     */
+    size_t getColumnIndex(const std::string& fieldName) const;
+
+    /**
+     * @brief Gets the footer statistics of one column chunk.
+     *
+     * @throws std::runtime_error if the block or column is out of range.
+     */
+    const ColumnStats& getStats(size_t block, size_t column) const;
+
+    /**
+     * @brief Gets the encoded bytes of one column chunk.
+     *
+     * @throws std::runtime_error if the block or column is out of range.
+     */
+    FrameView getChunk(size_t block, size_t column) const;
+
+    /**
+     * @brief Decodes one column chunk.
+     *
+     * @param column Index of the column.
+     * @param block Index of the block.
+     * @param out Receives getBlockRowCount(block) values.
+     * @return size_t Number of values written.
+     *
+     * @throws std::runtime_error if the block or column is out of range.
+     */
+    size_t readColumn(size_t column, size_t block, int64_t* out) const;
+
+    /**
+     * @brief Decodes a whole column across all blocks.
+     *
+     * @throws std::runtime_error if the column is out of range.
+     */
+    std::vector<int64_t> readColumn(size_t column) const;
+
+    /**
+     * @brief Lists the blocks whose values of a column may fall in [lo, hi].
+     *
+     * Uses only the footer statistics. Bounds are compared as signed values for
+     * signed fields and as unsigned values for unsigned ones.
+     *
+     * @return std::vector<size_t> Indices of the blocks whose min/max range
+     *         overlaps [lo, hi], in ascending order.
+     *
+     * @throws std::runtime_error if the column is out of range.
+     */
+    std::vector<size_t> findBlocks(size_t column, int64_t lo, int64_t hi) const;
+
+private:
+    struct BlockEntry {
+        uint64_t offset;
+        uint64_t rowCount;
+        std::vector<ColumnStats> chunks;
+        std::vector<uint64_t> references;
+        std::vector<uint64_t> chunkOffsets;
+    };
+
+    MappedFile file_;
+    const uint8_t* data_;
+    size_t size_;
+    MessageSchema schema_;
+    std::unordered_map<std::string, size_t> column_ids_;
+    std::vector<BlockEntry> blocks_;
+    uint64_t row_count_ = 0;
+
+    /**
+     * @brief Parses the trailer and footer.
+     */
+    void open();
+
+    /**
+     * @brief Throws if the block or column is out of range.
+     */
+    void checkChunk(size_t block, size_t column) const;
+};
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "FieldConfig.hpp"
+#include "FieldHandle.hpp"
+#include "MessageConfig.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Schema with variable-length parts, compiled to a decoding program.
+ *
+ * Besides the scalar fields of a MessageConfig, the definition may contain
+ * presence-conditional fields and groups, and length-prefixed repeated groups:
+ *
+ * @code
+ * {"bit_order": "msb_first", "fields": [
+ *     {"name": "version", "bit_width": 4, "signed": false},
+ *     {"name": "has_ext", "bit_width": 1, "signed": false},
+ *     {"name": "count", "bit_width": 8, "signed": false},
+ *     {"name": "ext", "bit_width": 16, "signed": false, "present_if": "has_ext"},
+ *     {"name": "entries", "count_field": "count", "fields": [
+ *         {"name": "key", "bit_width": 8, "signed": false},
+ *         {"name": "value", "bit_width": 12, "signed": true}
+ *     ]}
+ * ]}
+ * @endcode
+ *
+ * A field or group with "present_if" is only on the wire when the named field
+ * is non-zero; a group with "count_field" repeats as many times as the named
+ * unsigned field says. Both name a scalar declared earlier in the same or an
+ * enclosing field list. Fields inside groups are named "group.field".
+ *
+ * At construction the definition is compiled into a flat instruction stream.
+ * Consecutive unconditional fields form a run whose bit offsets are fixed at
+ * compile time: a run is bounds-checked once and each of its fields is then a
+ * single load at a constant offset from the run's start. Conditions and
+ * repetitions become jumps, so decoding (see DynamicMessage) walks the stream
+ * without consulting the schema. The leading run starts at bit 0; its fields
+ * are also available as getPrefix(), whose offsets are absolute.
+ *
+ * Only scalar fields in the message's bit order (and its natural byte order)
+ * are supported.
+ */
+class DecodeProgram {
+public:
+    /**
+     * @brief Instruction opcodes.
+     */
+    enum class Op : uint8_t {
+        /// Bounds-checks a run of @c a bits and makes the run's start the load base.
+        Run,
+        /// Loads a field at bit offset @c a from the load base (LSB-first message).
+        Load,
+        /// Loads a field at bit offset @c a from the load base (MSB-first message).
+        LoadMsb,
+        /// Unless field @c slot is non-zero, records the fields in padSlots()[b, c)
+        /// as absent and jumps to @c a.
+        SkipUnless,
+        /// Repeats the body that follows as often as field @c slot says, counting the
+        /// iterations in group @c b; each iteration is at least @c c bits. Jumps to
+        /// @c a, past the matching Next, when the count is 0.
+        Repeat,
+        /// Ends a Repeat body; jumps back to @c a while iterations remain.
+        Next,
+        /// Ends the program.
+        End
+    };
+
+    /**
+     * @brief One decoding instruction; the meaning of the operands depends on the opcode.
+     */
+    struct Instruction {
+        Op op;
+        /// Load: field width in bits.
+        uint8_t width;
+        /// Load: sign-extension shift, 64 - width for signed fields, 0 otherwise.
+        uint8_t signShift;
+        /// Load: whether the field may be absent and so has a presence column.
+        uint8_t optional;
+        /// Load: destination field; SkipUnless and Repeat: field tested or counted.
+        uint32_t slot;
+        uint32_t a;
+        uint32_t b;
+        uint32_t c;
+    };
+
+    /**
+     * @brief Compiles a schema definition.
+     *
+     * @param definition Field array, or object with "fields" and an optional
+     *        message-wide "bit_order".
+     *
+     * @throws std::runtime_error if the definition is invalid: bad or duplicate
+     *         names, invalid widths, references to unknown or later fields, a
+     *         signed count field, an unsupported key, or a repeated group that
+     *         could take no bits per iteration.
+     */
+    explicit DecodeProgram(const nlohmann::json& definition);
+
+    /**
+     * @brief Gets every scalar field, nested ones included, in declaration order.
+     */
+    const std::vector<FieldConfig>& getFields() const {
+        return fields_;
+    }
+
+    /**
+     * @brief Resolves a field name ("group.field" for nested fields) to a handle.
+     *
+     * @throws std::runtime_error if there is no such field.
+     */
+    FieldHandle getFieldHandle(const std::string& name) const;
+
+    /**
+     * @brief Checks whether a repeated group of the given name exists.
+     */
+    bool hasGroup(const std::string& name) const;
+
+    /**
+     * @brief Gets the index of a repeated group.
+     *
+     * @throws std::runtime_error if there is no such repeated group.
+     */
+    size_t getGroupIndex(const std::string& name) const;
+
+    /**
+     * @brief Gets the number of repeated groups.
+     */
+    size_t getGroupCount() const {
+        return group_names_.size();
+    }
+
+    /**
+     * @brief Checks whether field @p slot may be absent from a message.
+     */
+    bool isOptional(size_t slot) const {
+        return optional_[slot] != 0;
+    }
+
+    /**
+     * @brief Gets the bit numbering of the message.
+     */
+    BitOrder getBitOrder() const {
+        return bit_order_;
+    }
+
+    /**
+     * @brief Gets the leading unconditional, unrepeated fields as a fixed message.
+     *
+     * Every message of this schema starts with these fields, so they can be read
+     * at O(1) offsets, e.g. with a MessageView, without running the program.
+     */
+    const MessageConfig& getPrefix() const {
+        return prefix_;
+    }
+
+    /**
+     * @brief Gets the compiled instruction stream.
+     */
+    const std::vector<Instruction>& getInstructions() const {
+        return instructions_;
+    }
+
+    /**
+     * @brief Fields recorded as absent by SkipUnless instructions.
+     */
+    const std::vector<uint32_t>& padSlots() const {
+        return pad_slots_;
+    }
+
+    /**
+     * @brief Gets the deepest nesting of repeated groups.
+     */
+    size_t getMaxDepth() const {
+        return max_depth_;
+    }
+
+private:
+    // Fields visible to present_if and count_field references
+    using Scope = std::unordered_map<std::string, uint32_t>;
+
+    std::vector<FieldConfig> fields_;
+    std::vector<uint8_t> optional_;
+    std::unordered_map<std::string, uint32_t> field_index_;
+    std::vector<std::string> group_names_;
+    std::unordered_map<std::string, uint32_t> group_index_;
+    std::vector<Instruction> instructions_;
+    std::vector<uint32_t> pad_slots_;
+    BitOrder bit_order_;
+    MessageConfig prefix_;
+    size_t max_depth_;
+    size_t open_run_;
+
+    // Compiles a field list and returns the bits it takes at least. Fields that get
+    // one value per pass through the list are appended to @p direct.
+    size_t compileList(const nlohmann::json& list, const std::string& path, Scope scope,
+                       size_t depth, bool optional, std::vector<uint32_t>& direct);
+    uint32_t compileScalar(const nlohmann::json& field, const std::string& name, bool optional,
+                           std::vector<uint32_t>& direct);
+    uint32_t resolve(const Scope& scope, const nlohmann::json& reference, const std::string& name) const;
+    size_t emit(Op op, uint32_t slot = 0, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0);
+    void closeRun();
+};
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "DecodeProgram.hpp"
+#include "FieldHandle.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_span)
+#include <span>
+#endif
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Decoded message of a schema with conditional fields and repeated groups.
+ *
+ * unpackFrom() runs the schema's DecodeProgram over a buffer and collects the
+ * values column-wise: every field gets one entry per pass through the field
+ * list that declares it. Top-level fields therefore have exactly one entry,
+ * fields of a repeated group one per iteration (across all iterations of any
+ * enclosing groups, in wire order), and fields that are absent because their
+ * condition did not hold get an entry with value 0 that isPresent() reports as
+ * absent. Column storage is kept between calls, so decoding a stream of
+ * messages into one DynamicMessage does not allocate once it has warmed up.
+ *
+ * The program must outlive the message.
+ */
+class DynamicMessage {
+public:
+    /**
+     * @brief Constructs an empty message for the given program.
+     *
+     * @param program The compiled schema; must outlive the message.
+     */
+    explicit DynamicMessage(const DecodeProgram& program);
+
+    /**
+     * @brief Decodes a message from the start of a buffer.
+     *
+     * @param buffer Source buffer.
+     * @param size Number of readable bytes at @p buffer.
+     * @return size_t The number of bytes the message occupies (bits rounded up).
+     *
+     * @throws std::runtime_error if the buffer ends before the message does; the
+     *         decoded values are then unspecified.
+     */
+    size_t unpackFrom(const uint8_t* buffer, size_t size);
+
+#if defined(__cpp_lib_span)
+    /**
+     * @brief Decodes a message from the start of a span.
+     *
+     * @see unpackFrom(const uint8_t*, size_t)
+     */
+    size_t unpackFrom(std::span<const uint8_t> buffer) {
+        return unpackFrom(buffer.data(), buffer.size());
+    }
+#endif
+
+    /**
+     * @brief Gets one entry of a field.
+     *
+     * @param field Handle of the field, from DecodeProgram::getFieldHandle().
+     * @param index Index of the entry; 0 for top-level fields.
+     * @return int64_t The value, or 0 if the field is absent there.
+     *
+     * @throws std::runtime_error if the handle or the index is invalid.
+     */
+    int64_t getField(FieldHandle field, size_t index = 0) const;
+
+    /**
+     * @brief Gets one entry of a field by name.
+     *
+     * @see getField(FieldHandle, size_t)
+     */
+    int64_t getField(const std::string& name, size_t index = 0) const;
+
+    /**
+     * @brief Checks whether an entry of a field was on the wire.
+     *
+     * @throws std::runtime_error if the handle or the index is invalid.
+     */
+    bool isPresent(FieldHandle field, size_t index = 0) const;
+
+    /**
+     * @brief Checks whether an entry of a field was on the wire, by name.
+     *
+     * @see isPresent(FieldHandle, size_t)
+     */
+    bool isPresent(const std::string& name, size_t index = 0) const;
+
+    /**
+     * @brief Gets every entry of a field.
+     *
+     * @throws std::runtime_error if the handle is invalid.
+     */
+    const std::vector<int64_t>& getValues(FieldHandle field) const;
+
+    /**
+     * @brief Gets the total number of iterations of a repeated group.
+     *
+     * @param group Name of the group.
+     * @return size_t Its iterations in the last decoded message, summed over all
+     *         iterations of enclosing groups.
+     *
+     * @throws std::runtime_error if there is no such repeated group.
+     */
+    size_t getGroupSize(const std::string& group) const;
+
+    /**
+     * @brief Gets the program the message decodes with.
+     */
+    const DecodeProgram& getProgram() const {
+        return program_;
+    }
+
+private:
+    const DecodeProgram& program_;
+    std::vector<std::vector<int64_t>> columns_;
+    // Presence of each entry, kept only for optional fields
+    std::vector<std::vector<uint8_t>> present_;
+    // Latest value of each field, read by SkipUnless and Repeat
+    std::vector<int64_t> registers_;
+    std::vector<size_t> group_sizes_;
+    // Iterations left in each executing Repeat, innermost last
+    std::vector<uint64_t> loops_;
+
+    size_t checkedField(FieldHandle field, size_t index) const;
+};
+
+} // namespace BinaryMessageLibrary
@@ -5,6 +5,50 @@
 
 namespace BinaryMessageLibrary {
 
+/**
+ * @brief Order in which bits are numbered within a byte.
+ *
+ * At message level this decides which physical bit the message's bit N is:
+ * bit N % 8 counted from the least significant end of byte N / 8 (LsbFirst) or
+ * from the most significant end (MsbFirst). At field level it decides whether
+ * the value's least or most significant bit is placed first.
+ */
+enum class BitOrder : uint8_t {
+    LsbFirst,
+    MsbFirst
+};
+
+/**
+ * @brief Order in which the bytes of a multi-byte field value are placed.
+ */
+enum class ByteOrder : uint8_t {
+    Little,
+    Big
+};
+
+/**
+ * @brief Gets the byte order that goes naturally with a bit order.
+ *
+ * Values laid out LSB-first are little-endian and values laid out MSB-first
+ * are big-endian, so only fields whose width is a multiple of 8 can have the
+ * other byte order.
+ */
+inline ByteOrder naturalByteOrder(BitOrder bitOrder) {
+    return bitOrder == BitOrder::MsbFirst ? ByteOrder::Big : ByteOrder::Little;
+}
+
+/**
+ * @brief What a field holds.
+ */
+enum class FieldKind : uint8_t {
+    /// One integer of up to 64 bits.
+    Scalar,
+    /// A fixed number of integers of the same width, packed back to back.
+    Array,
+    /// A fixed number of raw bytes, copied to and from the wire verbatim.
+    Bytes
+};
+
 /**
  * @brief Configuration class for a single field in a binary message.
  * 
@@ -25,6 +69,48 @@ public:
      */
     FieldConfig(const std::string& name, uint8_t bitWidth, bool isSigned);
 
+    /**
+     * @brief Constructs a new FieldConfig object with an explicit wire order.
+     * 
+     * The value's bytes are placed in @p byteOrder and the bits of each byte in
+     * @p bitOrder. Fields whose width is not a multiple of 8 are treated as a
+     * single run of bits, so they must use the natural byte order of their bit
+     * order.
+     * 
+     * @param name The name of the field.
+     * @param bitWidth The number of bits allocated for this field.
+     * @param isSigned Whether the field represents a signed value.
+     * @param bitOrder Order of the value's bits.
+     * @param byteOrder Order of the value's bytes.
+     * 
+     * @throws std::runtime_error if bitWidth is 0, or if @p byteOrder is not the
+     *         natural byte order of @p bitOrder and bitWidth is not a multiple of 8.
+     */
+    FieldConfig(const std::string& name, uint8_t bitWidth, bool isSigned,
+                BitOrder bitOrder, ByteOrder byteOrder);
+
+    /**
+     * @brief Constructs a new FieldConfig object of any kind.
+     * 
+     * For arrays, @p bitWidth, @p isSigned and the orders describe each
+     * element. Bytes fields hold @p count unsigned 8-bit elements in the
+     * natural byte order of @p bitOrder.
+     * 
+     * @param name The name of the field.
+     * @param kind The kind of field.
+     * @param bitWidth The number of bits of each element.
+     * @param count The number of elements; 1 for scalars.
+     * @param isSigned Whether the elements are signed.
+     * @param bitOrder Order of each element's bits.
+     * @param byteOrder Order of each element's bytes.
+     * 
+     * @throws std::runtime_error if bitWidth is 0 or the combination is invalid
+     *         for the kind (a scalar with a count other than 1, an empty array,
+     *         a Bytes field whose elements are not unsigned bytes).
+     */
+    FieldConfig(const std::string& name, FieldKind kind, uint8_t bitWidth, uint32_t count,
+                bool isSigned, BitOrder bitOrder, ByteOrder byteOrder);
+
     /**
      * @brief Gets the name of the field.
      * 
@@ -35,10 +121,37 @@ public:
     /**
      * @brief Gets the bit width of the field.
      * 
-     * @return uint8_t The number of bits allocated for this field.
+     * @return uint8_t The number of bits allocated for this field, or for each
+     *         element of an array or Bytes field.
      */
     uint8_t getBitWidth() const;
 
+    /**
+     * @brief Gets the kind of the field.
+     * 
+     * @return FieldKind The field kind.
+     */
+    FieldKind getKind() const { return kind_; }
+
+    /**
+     * @brief Checks if the field holds a single integer.
+     */
+    bool isScalar() const { return kind_ == FieldKind::Scalar; }
+
+    /**
+     * @brief Gets the number of elements of the field.
+     * 
+     * @return uint32_t The element count; 1 for scalars.
+     */
+    uint32_t getCount() const { return count_; }
+
+    /**
+     * @brief Gets the number of bits the field occupies in a packed message.
+     * 
+     * @return size_t The element width times the element count.
+     */
+    size_t getTotalBits() const { return static_cast<size_t>(bit_width_) * count_; }
+
     /**
      * @brief Checks if the field is signed.
      * 
@@ -48,7 +161,21 @@ public:
     bool isSigned() const;
 
     /**
-     * @brief Validates a value against the field's constraints.
+     * @brief Gets the order of the field value's bits on the wire.
+     * 
+     * @return BitOrder The bit order.
+     */
+    BitOrder getBitOrder() const;
+
+    /**
+     * @brief Gets the order of the field value's bytes on the wire.
+     * 
+     * @return ByteOrder The byte order.
+     */
+    ByteOrder getByteOrder() const;
+
+    /**
+     * @brief Validates a value (of an array element, for arrays) against the field's constraints.
      * 
      * @param value The value to validate.
      * @return true if the value is within the valid range for this field.
@@ -108,6 +235,10 @@ private:
     std::string name_;
     uint8_t bit_width_;
     bool is_signed_;
+    BitOrder bit_order_;
+    ByteOrder byte_order_;
+    FieldKind kind_;
+    uint32_t count_;
 };
 
 } // namespace BinaryMessageLibrary 
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Pre-resolved reference to a field of a MessageConfig.
+ *
+ * A handle is obtained once by name through MessageConfig::getFieldHandle() and
+ * then used for field access without any string hashing or comparison. It is
+ * simply the field's position in the configuration, so it is only meaningful for
+ * the configuration (or an identical one) it was resolved against.
+ */
+class FieldHandle {
+public:
+    /**
+     * @brief Constructs an invalid handle.
+     */
+    constexpr FieldHandle() : index_(kInvalidIndex) {}
+
+    /**
+     * @brief Constructs a handle referring to the field at @p index.
+     *
+     * @param index Position of the field in its MessageConfig.
+     */
+    constexpr explicit FieldHandle(uint32_t index) : index_(index) {}
+
+    /**
+     * @brief Gets the position of the field in its configuration.
+     *
+     * @return size_t The field index.
+     */
+    constexpr size_t index() const { return index_; }
+
+    /**
+     * @brief Checks whether the handle refers to a field at all.
+     *
+     * @return true if the handle was resolved from a configuration.
+     * @return false if the handle is default constructed.
+     */
+    constexpr bool isValid() const { return index_ != kInvalidIndex; }
+
+    constexpr bool operator==(FieldHandle other) const { return index_ == other.index_; }
+    constexpr bool operator!=(FieldHandle other) const { return index_ != other.index_; }
+
+private:
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    uint32_t index_;
+};
+
+} // namespace BinaryMessageLibrary
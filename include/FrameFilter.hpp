@@ -0,0 +1,165 @@
+#pragma once
+
+#include "MessageConfig.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Comparison applied by a FrameFilter predicate.
+ */
+enum class CompareOp {
+    Equal,
+    NotEqual,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual
+};
+
+/**
+ * @brief Selects packed frames by comparing fields against constants, without unpacking.
+ *
+ * A filter is built against a message configuration and holds a conjunction of
+ * predicates, each comparing one field with a constant. Predicates are compiled
+ * when added: signed fields are mapped to unsigned keys by flipping their sign
+ * bit, constants outside a field's range are folded (a predicate that always
+ * holds is dropped, one that never holds empties the filter), and what remains
+ * is a single unsigned range test per field.
+ *
+ * Batches are evaluated 64 frames at a time, one predicate after the other,
+ * with SimdKernels::matchRange(); only the fields named by predicates are read,
+ * and the remaining predicates are skipped for a group of frames as soon as
+ * none of them matches. Results are a selection bitmap or a list of indices.
+ *
+ * Frames are laid out at a fixed stride as for BatchCodec: the frame buffer must
+ * hold at least (count - 1) * stride + the packed frame size bytes.
+ *
+ * @code
+ * FrameFilter filter(config);
+ * filter.where("error_code", CompareOp::NotEqual, 0)
+ *       .where("temperature", CompareOp::Less, -100);
+ * std::vector<size_t> hits;
+ * filter.selectIndices(frames, count, frameSize, hits);
+ * @endcode
+ */
+class FrameFilter {
+public:
+    /**
+     * @brief Constructs a filter that accepts every frame.
+     *
+     * @param config The message configuration; must outlive the filter.
+     */
+    explicit FrameFilter(const MessageConfig& config);
+
+    /**
+     * @brief Adds a predicate; a frame is selected only if all predicates hold.
+     *
+     * The constant is compared with the field's value as BinaryMessage would
+     * return it: sign-extended for signed fields, zero-extended for unsigned ones
+     * (reinterpreted as unsigned for 64-bit unsigned fields).
+     *
+     * @param fieldName Name of the field to test.
+     * @param op The comparison.
+     * @param value The constant to compare against.
+     * @return FrameFilter& This filter, for chaining.
+     *
+     * @throws std::runtime_error if the configuration has no such field or the
+     *         field is not a scalar.
+     */
+    FrameFilter& where(const std::string& fieldName, CompareOp op, int64_t value);
+
+    /**
+     * @brief Tests a single packed frame.
+     *
+     * @param frame The packed frame.
+     * @param size Size of the frame buffer in bytes.
+     * @return true if the frame satisfies all predicates.
+     *
+     * @throws std::runtime_error if the buffer is smaller than the packed frame size.
+     */
+    bool matches(const uint8_t* frame, size_t size) const;
+
+    /**
+     * @brief Evaluates the filter over a batch of frames into a selection bitmap.
+     *
+     * Bit (i % 64) of bitmap[i / 64] is set when frame i is selected; bits past
+     * @p count in the last word are cleared.
+     *
+     * @param frames Pointer to the first frame.
+     * @param count Number of frames.
+     * @param stride Distance in bytes between the starts of consecutive frames.
+     * @param bitmap Output with room for (count + 63) / 64 words.
+     * @return size_t Number of selected frames.
+     *
+     * @throws std::runtime_error if the stride is smaller than the frame size.
+     */
+    size_t selectBitmap(const uint8_t* frames, size_t count, size_t stride, uint64_t* bitmap) const;
+
+    /**
+     * @brief Evaluates the filter over a batch of frames into a list of indices.
+     *
+     * @param frames Pointer to the first frame.
+     * @param count Number of frames.
+     * @param stride Distance in bytes between the starts of consecutive frames.
+     * @param indices Replaced with the indices of the selected frames, ascending.
+     * @return size_t Number of selected frames.
+     *
+     * @throws std::runtime_error if the stride is smaller than the frame size.
+     */
+    size_t selectIndices(const uint8_t* frames, size_t count, size_t stride, std::vector<size_t>& indices) const;
+
+    /**
+     * @brief Gets the number of predicates left after folding constants.
+     */
+    size_t getPredicateCount() const;
+
+    /**
+     * @brief Checks whether a predicate can never hold, so no frame is selected.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Gets the message configuration the filter was built for.
+     */
+    const MessageConfig& getConfig() const;
+
+private:
+    struct Predicate {
+        size_t byteOffset;
+        unsigned shift;
+        uint64_t mask;
+        bool crossesWord;
+        uint64_t flip;
+        uint64_t lo;
+        uint64_t span;
+        bool negate;
+        // Field index, for fields outside the default wire order; SIZE_MAX otherwise
+        size_t orderedField;
+    };
+
+    const MessageConfig& config_;
+    std::vector<Predicate> predicates_;
+    bool empty_ = false;
+
+    /**
+     * @brief Evaluates all predicates for up to 64 frames starting at @p first.
+     */
+    uint64_t matchGroup(const uint8_t* frames, size_t first, size_t count, size_t stride,
+                        size_t extent) const;
+
+    /**
+     * @brief Reads the raw bits of a predicate's field from one frame.
+     */
+    uint64_t extractRaw(const Predicate& p, const uint8_t* frame, size_t size) const;
+
+    /**
+     * @brief Validates that frames fit at the given stride.
+     */
+    void validateStride(size_t count, size_t stride) const;
+};
+
+} // namespace BinaryMessageLibrary
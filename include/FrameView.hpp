@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Non-owning view of one packed frame.
+ */
+struct FrameView {
+    /// First byte of the frame.
+    const uint8_t* data;
+
+    /// Size of the frame in bytes.
+    size_t size;
+};
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Expected access pattern of a mapped file, passed to the OS as a hint.
+ */
+enum class AccessPattern {
+    Normal,     ///< No particular pattern.
+    Sequential, ///< Read front to back; the OS may read ahead aggressively.
+    Random      ///< Read at random offsets; read-ahead is wasted.
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * Uses mmap() on POSIX systems and a file mapping on Windows. The contents are
+ * paged in on demand and never copied into the process heap. An empty file maps
+ * to a null data() pointer with size() 0.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Constructs an object that maps nothing.
+     */
+    MappedFile();
+
+    /**
+     * @brief Maps a file read-only.
+     *
+     * @param path Path of the file to map.
+     * @param pattern Access pattern hint for the OS.
+     *
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path, AccessPattern pattern = AccessPattern::Normal);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Gets the mapped contents.
+     *
+     * @return const uint8_t* Pointer to the first byte, or null if nothing is mapped.
+     */
+    const uint8_t* data() const;
+
+    /**
+     * @brief Gets the size of the mapping.
+     *
+     * @return size_t The file size in bytes.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Changes the access pattern hint for the whole mapping.
+     *
+     * This is only advice; it is silently ignored where unsupported.
+     *
+     * @param pattern The new access pattern.
+     */
+    void advise(AccessPattern pattern) const;
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+#if defined(_WIN32)
+    void* file_;
+    void* mapping_;
+#endif
+
+    /**
+     * @brief Releases the mapping and any OS handles.
+     */
+    void close();
+};
+
+} // namespace BinaryMessageLibrary
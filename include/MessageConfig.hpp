@@ -1,9 +1,14 @@
 #pragma once
 
 #include "FieldConfig.hpp"
+#include "FieldHandle.hpp"
+#include "MessageLayout.hpp"
+#include "UnpackProgram.hpp"
 #include <nlohmann/json.hpp>
 #include <vector>
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 namespace BinaryMessageLibrary {
 
@@ -26,17 +31,44 @@ public:
     /**
      * @brief Constructs a new MessageConfig object from a JSON configuration.
      * 
-     * @param config JSON array containing field configurations.
+     * The configuration is either an array of fields or an object holding the
+     * array under "fields" together with the message's "bit_order"
+     * ("lsb_first", the default, or "msb_first") and "byte_order" ("little" or
+     * "big", defaulting to the one that goes with the bit order). Each field
+     * takes the same two keys next to "bit_width" and "signed" to override the
+     * message's orders; a byte order that does not go with the field's bit
+     * order is only valid for widths that are multiples of 8.
+     * 
+     * A field with a "count" is an array of that many elements of "bit_width"
+     * bits each. A field with "bytes" (and no "bit_width"), or with a
+     * "bit_width" above 64 that is a multiple of 8, is an unsigned blob of that
+     * many bytes kept in the message's bit order.
+     * 
+     * @param config JSON field array, or object containing one.
      * 
      * @throws std::runtime_error if the JSON configuration is invalid or if any field
      *         configuration is invalid (e.g., duplicate field names, invalid bit widths).
      */
     explicit MessageConfig(const nlohmann::json& config);
 
+    /**
+     * @brief Constructs a configuration from fields that are already built.
+     * 
+     * Used where schemas come from a binary form rather than JSON (see
+     * SchemaEncoding::decodeConfig()); the fields are laid out in the order given.
+     * 
+     * @param fields The fields of the message.
+     * @param bitOrder Bit numbering of the message.
+     * @param byteOrder Message-wide default byte order of multi-byte fields.
+     * 
+     * @throws std::runtime_error if two fields share a name or the layout is too large.
+     */
+    MessageConfig(std::vector<FieldConfig> fields, BitOrder bitOrder, ByteOrder byteOrder);
+
     /**
      * @brief Sets the message configuration from a JSON configuration.
      * 
-     * @param config JSON array containing field configurations.
+     * @param config JSON field array, or object containing one; see MessageConfig(const nlohmann::json&).
      * 
      * @throws std::runtime_error if the JSON configuration is invalid or if any field
      *         configuration is invalid (e.g., duplicate field names, invalid bit widths).
@@ -78,9 +110,70 @@ public:
      */
     bool hasField(const std::string& name) const;
 
+    /**
+     * @brief Resolves a field name to a handle for string-free field access.
+     * 
+     * The lookup goes through a hash index built by setConfig(), so it is O(1)
+     * on average regardless of the number of fields.
+     * 
+     * @param name The name of the field to resolve.
+     * @return FieldHandle Handle referring to the field.
+     * 
+     * @throws std::runtime_error if no field with the given name exists.
+     */
+    FieldHandle getFieldHandle(const std::string& name) const;
+
+    /**
+     * @brief Gets the field configuration referred to by a handle.
+     * 
+     * @param handle The handle of the field to get.
+     * @return const FieldConfig& Reference to the field configuration.
+     * 
+     * @throws std::runtime_error if the handle does not refer to a field of
+     *         this configuration.
+     */
+    const FieldConfig& getFieldConfig(FieldHandle handle) const;
+
+    /**
+     * @brief Gets the bit numbering of the message.
+     * 
+     * @return BitOrder The message-wide bit order.
+     */
+    BitOrder getBitOrder() const;
+
+    /**
+     * @brief Gets the message-wide default byte order of multi-byte fields.
+     * 
+     * @return ByteOrder The message-wide byte order.
+     */
+    ByteOrder getByteOrder() const;
+
+    /**
+     * @brief Gets the precompiled layout plan for the message.
+     * 
+     * The plan is rebuilt whenever setConfig() runs and is immutable otherwise.
+     * 
+     * @return const MessageLayout& The layout plan.
+     */
+    const MessageLayout& getLayout() const;
+
+    /**
+     * @brief Gets the layout lowered to an unpacking program.
+     * 
+     * Rebuilt together with the layout; BinaryMessage::unpackFrom() runs it.
+     * 
+     * @return const UnpackProgram& The unpacking program.
+     */
+    const UnpackProgram& getUnpackProgram() const;
+
 private:
     std::vector<FieldConfig> fields_;
+    std::unordered_map<std::string, uint32_t> field_index_;
     size_t total_bits_;
+    BitOrder bit_order_;
+    ByteOrder byte_order_;
+    MessageLayout layout_;
+    UnpackProgram unpack_program_;
 
     /**
      * @brief Validates the JSON configuration.
@@ -97,4 +190,12 @@ private:
     void calculateTotalBits();
 };
 
+/**
+ * @brief Shared, immutable message configuration.
+ * 
+ * Schemas are handed out by SchemaRegistry and BinaryMessageFactory; every
+ * message created from one keeps it alive.
+ */
+using MessageSchema = std::shared_ptr<const MessageConfig>;
+
 } // namespace BinaryMessageLibrary 
\ No newline at end of file
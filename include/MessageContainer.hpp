@@ -0,0 +1,346 @@
+#pragma once
+
+#include "BinaryMessage.hpp"
+#include "BinaryMessageFactory.hpp"
+#include "FrameView.hpp"
+#include "MappedFile.hpp"
+#include "MessageConfig.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Self-describing container for streams of mixed message types.
+ *
+ * Layout (integers are little-endian, "varint" is LEB128, see Varint):
+ *
+ * @code
+ * header   "BMSC" | version u8 | type count varint | type...
+ * type     name | schema (see SchemaEncoding)
+ * name     length varint | UTF-8 bytes
+ * block    0x01 | body size u32 | frame count u32 | frame...
+ * frame    type id varint | payload size varint | payload (packed message)
+ * index    0x02 | body size u32 | block count varint | (offset u64 | first frame u64)...
+ * trailer  index offset u64 | "BMSX"
+ * @endcode
+ *
+ * Type ids are positions in the header's type table. Blocks hold a bounded
+ * number of frames and are listed in the index, which lets readers seek to a
+ * frame without scanning the stream. The index and trailer are written by
+ * ContainerWriter::finish(); a stream without them (e.g. still being written)
+ * can still be read front to back.
+ */
+namespace Container {
+
+/// Container format version written by ContainerWriter.
+constexpr uint8_t kVersion = 1;
+
+} // namespace Container
+
+/**
+ * @brief A frame read from a container.
+ */
+struct ContainerFrame {
+    /// Index of the type in the container's type table.
+    uint32_t typeId;
+
+    /// Position of the frame in the stream.
+    uint64_t index;
+
+    /// The packed message, viewed in place.
+    FrameView payload;
+};
+
+/**
+ * @brief Writes mixed-type message streams in the container format.
+ *
+ * Frames are collected in a reused block buffer and written to the output one
+ * block at a time, so steady-state writing does not allocate.
+ */
+class ContainerWriter {
+public:
+    /// Default maximum number of frames per block.
+    static constexpr size_t kDefaultBlockFrames = 4096;
+
+    /**
+     * @brief Starts a container holding every message type of a factory.
+     *
+     * Types are numbered in name order. The header is written immediately.
+     *
+     * @param out Output stream; must outlive the writer.
+     * @param factory Factory whose message types are registered.
+     * @param blockFrames Maximum number of frames per block.
+     *
+     * @throws std::runtime_error if blockFrames is 0.
+     */
+    ContainerWriter(std::ostream& out, const BinaryMessageFactory& factory,
+                    size_t blockFrames = kDefaultBlockFrames);
+
+    /**
+     * @brief Starts a container holding the given message types, numbered in order.
+     *
+     * @param out Output stream; must outlive the writer.
+     * @param types Pairs of type name and schema.
+     * @param blockFrames Maximum number of frames per block.
+     *
+     * @throws std::runtime_error if blockFrames is 0, a schema is null or a
+     *         name is repeated.
+     */
+    ContainerWriter(std::ostream& out, const std::vector<std::pair<std::string, MessageSchema>>& types,
+                    size_t blockFrames = kDefaultBlockFrames);
+
+    /**
+     * @brief Finishes the container if finish() has not been called.
+     *
+     * Errors are swallowed; call finish() explicitly to observe them.
+     */
+    ~ContainerWriter();
+
+    ContainerWriter(const ContainerWriter&) = delete;
+    ContainerWriter& operator=(const ContainerWriter&) = delete;
+
+    /**
+     * @brief Gets the type id of a registered message type.
+     *
+     * @throws std::runtime_error if the type is not registered.
+     */
+    uint32_t getTypeId(const std::string& messageType) const;
+
+    /**
+     * @brief Appends a message, identifying its type by its schema.
+     *
+     * Messages sharing a registered type's MessageConfig object are matched
+     * directly; any other message is matched by its encoded schema, so a plain
+     * MessageConfig with the same layout resolves to the first such type.
+     *
+     * @throws std::runtime_error if the message's type is not registered or the
+     *         container has been finished.
+     */
+    void write(const BinaryMessage& message);
+
+    /**
+     * @brief Appends a message under an explicit type id.
+     *
+     * @throws std::runtime_error if the type id is out of range or the container
+     *         has been finished.
+     */
+    void write(uint32_t typeId, const BinaryMessage& message);
+
+    /**
+     * @brief Appends an already packed frame.
+     *
+     * @param typeId Type id of the frame.
+     * @param payload The packed message.
+     * @param size Size of the packed message in bytes.
+     *
+     * @throws std::runtime_error if the type id is out of range or the container
+     *         has been finished.
+     */
+    void writeFrame(uint32_t typeId, const uint8_t* payload, size_t size);
+
+    /**
+     * @brief Writes the current block, even if it is not full.
+     *
+     * @throws std::runtime_error if writing to the output fails.
+     */
+    void flush();
+
+    /**
+     * @brief Writes the last block, the block index and the trailer.
+     *
+     * @throws std::runtime_error if writing to the output fails.
+     */
+    void finish();
+
+    /**
+     * @brief Gets the number of frames written so far.
+     */
+    uint64_t getFrameCount() const;
+
+private:
+    std::ostream& out_;
+    size_t block_frames_;
+    std::vector<std::pair<std::string, MessageSchema>> types_;
+    std::unordered_map<const MessageConfig*, uint32_t> type_ids_;
+    std::unordered_map<std::string, uint32_t> layout_ids_;
+    std::vector<uint8_t> block_;
+    uint32_t block_frame_count_ = 0;
+    uint64_t frame_count_ = 0;
+    uint64_t offset_ = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> index_;
+    bool finished_ = false;
+
+    /**
+     * @brief Writes bytes to the output and advances the offset.
+     */
+    void emit(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Writes the magic, version and type table.
+     */
+    void writeHeader();
+
+    /**
+     * @brief Appends a frame header and reserves @p size payload bytes in the block.
+     *
+     * @return uint8_t* Where the payload goes.
+     */
+    uint8_t* beginFrame(uint32_t typeId, size_t size);
+
+    /**
+     * @brief Counts a completed frame and flushes the block when it is full.
+     */
+    void endFrame();
+};
+
+/**
+ * @brief Reads containers written by ContainerWriter without copying frames.
+ *
+ * The reader walks a byte range (or a file it memory-maps) and hands out frames
+ * as views into it; reading a frame performs no allocation. Schemas from the
+ * header are interned in SchemaRegistry::global(), so they are shared with
+ * factories loaded from the same definitions.
+ */
+class ContainerReader {
+public:
+    /**
+     * @brief Reads a container from memory.
+     *
+     * @param data Container bytes; must stay valid while the reader is used.
+     * @param size Size of the container in bytes.
+     *
+     * @throws std::runtime_error if the header or the index is malformed.
+     */
+    ContainerReader(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Memory-maps and reads a container file.
+     *
+     * @param path Path of the container file.
+     *
+     * @throws std::runtime_error if the file cannot be mapped or is malformed.
+     */
+    explicit ContainerReader(const std::string& path);
+
+    ContainerReader(const ContainerReader&) = delete;
+    ContainerReader& operator=(const ContainerReader&) = delete;
+
+    /**
+     * @brief Gets the number of message types in the container.
+     */
+    size_t getTypeCount() const;
+
+    /**
+     * @brief Gets the name of a message type.
+     *
+     * @throws std::runtime_error if the type id is out of range.
+     */
+    const std::string& getTypeName(uint32_t typeId) const;
+
+    /**
+     * @brief Gets the schema of a message type.
+     *
+     * @throws std::runtime_error if the type id is out of range.
+     */
+    const MessageSchema& getSchema(uint32_t typeId) const;
+
+    /**
+     * @brief Gets the id of a message type by name.
+     *
+     * @throws std::runtime_error if the container has no such type.
+     */
+    uint32_t getTypeId(const std::string& messageType) const;
+
+    /**
+     * @brief Reads the next frame.
+     *
+     * A block cut off at the end of an unfinished container ends the stream.
+     *
+     * @param frame Receives the frame.
+     * @return true if a frame was read; false at the end of the stream.
+     *
+     * @throws std::runtime_error if a block or frame is malformed.
+     */
+    bool next(ContainerFrame& frame);
+
+    /**
+     * @brief Reads the next frame and unpacks it into a message of its type.
+     *
+     * @param frame Receives the frame.
+     * @param message Message to unpack into; its schema must encode the same
+     *        layout as the frame's type, though it need not be the same object.
+     * @return true if a frame was read; false at the end of the stream.
+     *
+     * @throws std::runtime_error if the frame is malformed or of another type
+     *         than the message.
+     */
+    bool next(ContainerFrame& frame, BinaryMessage& message);
+
+    /**
+     * @brief Checks whether the container has a block index (was finished).
+     */
+    bool hasIndex() const;
+
+    /**
+     * @brief Gets the total number of frames, from the block index.
+     *
+     * @throws std::runtime_error if the container has no index.
+     */
+    uint64_t getFrameCount() const;
+
+    /**
+     * @brief Positions the reader so that next() returns frame @p index.
+     *
+     * Jumps to the right block through the index and skips frames within it.
+     *
+     * @throws std::runtime_error if the container has no index or the index is
+     *         past the last frame.
+     */
+    void seek(uint64_t index);
+
+    /**
+     * @brief Positions the reader at the first frame.
+     */
+    void rewind();
+
+private:
+    struct TypeEntry {
+        std::string name;
+        MessageSchema schema;
+        std::string layout;
+    };
+
+    MappedFile file_;
+    const uint8_t* data_;
+    size_t size_;
+    std::vector<TypeEntry> types_;
+    std::unordered_map<std::string, uint32_t> type_ids_;
+    std::vector<std::pair<uint64_t, uint64_t>> index_;
+    uint64_t total_frames_ = 0;
+    bool has_index_ = false;
+
+    size_t first_block_;
+    size_t blocks_end_;
+    size_t position_;
+    size_t block_end_ = 0;
+    uint32_t block_remaining_ = 0;
+    uint64_t next_index_ = 0;
+
+    /**
+     * @brief Parses the header and, if present, the trailer and block index.
+     */
+    void open();
+
+    /**
+     * @brief Moves to the block starting at @p offset; false if it is cut off.
+     */
+    bool enterBlock(size_t offset);
+};
+
+} // namespace BinaryMessageLibrary
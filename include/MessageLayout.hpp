@@ -0,0 +1,487 @@
+#pragma once
+
+#include "FieldConfig.hpp"
+#include "BitCodec.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Precompiled, immutable field layout plan for a message.
+ *
+ * The plan is derived once from a list of field configurations and stores, for
+ * every field in declaration order, everything the codec needs to move the field
+ * with a single word load or store: the byte holding the field's first bit, the
+ * bit shift within that byte, the value mask, the sign-extension shift and whether
+ * the field spills past the 64-bit word loaded at its byte offset.
+ *
+ * Messages are LSB-first unless built with BitOrder::MsbFirst, in which case the
+ * same offsets and shifts count bits from the most significant end of each byte
+ * and fields move through big-endian words (see BitCodec). Fields whose own bit
+ * or byte order differs from the message's are bit-reversed or byte-swapped on
+ * their way in and out; orderFlags() records which fields need what.
+ *
+ * Array and Bytes fields ("block" fields) are laid out as one run of bits. A
+ * BinaryMessage keeps each block in its packed form, re-based to bit 0 and in
+ * the message's bit order, so packing and unpacking a block is a bit-shifted
+ * word copy (a plain memcpy when it starts on a byte boundary) however many
+ * elements it has; elements are only decoded when they are read.
+ *
+ * The data is kept as parallel arrays (struct-of-arrays) so that walking one
+ * attribute across all fields touches contiguous memory.
+ */
+class MessageLayout {
+public:
+    /**
+     * @brief Constructs an empty layout with no fields.
+     */
+    MessageLayout();
+
+    /// orderFlags() bit: the message is MSB-first, so the field moves through big-endian words.
+    static constexpr uint8_t kMsbFirst = 0x01;
+    /// orderFlags() bit: the field's bit order differs from the message's.
+    static constexpr uint8_t kReverseBits = 0x02;
+    /// orderFlags() bit: the field's byte order is not the natural one for its bit order.
+    static constexpr uint8_t kSwapBytes = 0x04;
+    /// orderFlags() bit: the field is an Array or Bytes field, packed as a block.
+    static constexpr uint8_t kBlock = 0x08;
+
+    /**
+     * @brief Builds the layout plan for the given fields.
+     *
+     * Fields are laid out back to back in the order given.
+     *
+     * @param fields The field configurations to lay out.
+     * @param bitOrder Bit numbering of the message.
+     */
+    explicit MessageLayout(const std::vector<FieldConfig>& fields, BitOrder bitOrder = BitOrder::LsbFirst);
+
+    /**
+     * @brief Gets the number of fields in the layout.
+     *
+     * @return size_t The number of fields.
+     */
+    size_t size() const { return byte_offsets_.size(); }
+
+    /**
+     * @brief Gets the total number of bits covered by the layout.
+     *
+     * @return size_t Total number of bits.
+     */
+    size_t getTotalBits() const { return total_bits_; }
+
+    /**
+     * @brief Gets the number of bytes needed to hold a packed message.
+     *
+     * @return size_t Total number of bytes (bits rounded up).
+     */
+    size_t getTotalBytes() const { return (total_bits_ + 7) / 8; }
+
+    /**
+     * @brief Checks whether any field is an Array or Bytes field.
+     *
+     * Components that treat each field as one integer column (BatchCodec,
+     * FrameFilter, ColumnStore, generated codecs) only accept layouts without.
+     */
+    bool hasBlocks() const { return block_field_count_ != 0; }
+
+    /**
+     * @brief Checks whether field @p index is a scalar.
+     */
+    bool isScalar(size_t index) const { return (order_flags_[index] & kBlock) == 0; }
+
+    /**
+     * @brief Number of elements of each field; 1 for scalars.
+     */
+    const std::vector<uint32_t>& elementCounts() const { return element_counts_; }
+
+    /**
+     * @brief Byte offset of each block field's storage within a message's
+     *        block storage; 0 for scalars.
+     */
+    const std::vector<uint32_t>& blockOffsets() const { return block_offsets_; }
+
+    /**
+     * @brief Gets the number of bytes of block storage a message needs.
+     */
+    size_t getBlockBytes() const { return block_bytes_; }
+
+    /**
+     * @brief Gets the number of bytes of block field @p index's storage.
+     */
+    size_t getBlockSize(size_t index) const {
+        return (static_cast<size_t>(bit_widths_[index]) * element_counts_[index] + 7) / 8;
+    }
+
+    /**
+     * @brief Gets the bit numbering of the message.
+     */
+    BitOrder getBitOrder() const { return bit_order_; }
+
+    /**
+     * @brief Whether every field uses the default LSB-first, little-endian wire order.
+     *
+     * Only such layouts can use the little-endian word kernels (SimdKernels,
+     * generated codecs) that read fields straight from byteOffsets() and shifts().
+     */
+    bool hasDefaultOrder() const { return default_order_; }
+
+    /**
+     * @brief Byte offset of each field's first bit.
+     */
+    const std::vector<uint32_t>& byteOffsets() const { return byte_offsets_; }
+
+    /**
+     * @brief Bit position of each field's first bit within its first byte (0-7),
+     *        counted in the message's bit order.
+     */
+    const std::vector<uint8_t>& shifts() const { return shifts_; }
+
+    /**
+     * @brief Bit width of each field, or of each element of a block field.
+     */
+    const std::vector<uint8_t>& bitWidths() const { return bit_widths_; }
+
+    /**
+     * @brief Mask with the low bit_width bits set, per field.
+     */
+    const std::vector<uint64_t>& masks() const { return masks_; }
+
+    /**
+     * @brief Shift used to sign-extend each field: 64 - bit_width for signed
+     *        fields, 0 for unsigned ones.
+     */
+    const std::vector<uint8_t>& signShifts() const { return sign_shifts_; }
+
+    /**
+     * @brief Non-zero for fields whose bits spill past the 64-bit word loaded
+     *        at their byte offset.
+     */
+    const std::vector<uint8_t>& crossesWord() const { return crosses_word_; }
+
+    /**
+     * @brief Combination of kMsbFirst, kReverseBits, kSwapBytes and kBlock per
+     *        field; 0 for scalar fields in the default wire order.
+     */
+    const std::vector<uint8_t>& orderFlags() const { return order_flags_; }
+
+    /**
+     * @brief Reads scalar field @p index from a packed buffer without sign extension.
+     *
+     * @param index Index of the field in the layout.
+     * @param buffer The packed buffer.
+     * @param size Size of the buffer; must be at least getTotalBytes().
+     * @return uint64_t The field bits, zero-extended.
+     */
+    uint64_t extractRaw(size_t index, const uint8_t* buffer, size_t size) const {
+        uint8_t flags = order_flags_[index];
+        if (flags == 0) {
+            return BitCodec::extract(buffer, size, byte_offsets_[index], shifts_[index],
+                                     masks_[index], crosses_word_[index] != 0);
+        }
+        uint64_t raw = flags & kMsbFirst
+            ? BitCodec::extractMsb(buffer, size, byte_offsets_[index], shifts_[index],
+                                   bit_widths_[index], crosses_word_[index] != 0)
+            : BitCodec::extract(buffer, size, byte_offsets_[index], shifts_[index],
+                                masks_[index], crosses_word_[index] != 0);
+        return flags == kMsbFirst ? raw : reorder(index, raw);
+    }
+
+    /**
+     * @brief Reads scalar field @p index from a packed buffer, sign-extending signed fields.
+     *
+     * @param index Index of the field in the layout.
+     * @param buffer The packed buffer.
+     * @param size Size of the buffer; must be at least getTotalBytes().
+     * @return int64_t The field value.
+     */
+    int64_t extract(size_t index, const uint8_t* buffer, size_t size) const {
+        uint64_t raw = extractRaw(index, buffer, size);
+        unsigned signShift = sign_shifts_[index];
+        return static_cast<int64_t>(raw << signShift) >> signShift;
+    }
+
+    /**
+     * @brief Writes scalar field @p index into a packed buffer, leaving other bits intact.
+     *
+     * @param index Index of the field in the layout.
+     * @param buffer The packed buffer.
+     * @param size Size of the buffer; must be at least getTotalBytes().
+     * @param value The value to write; bits above the field width are ignored.
+     */
+    void deposit(size_t index, uint8_t* buffer, size_t size, int64_t value) const {
+        uint8_t flags = order_flags_[index];
+        uint64_t raw = reorder(index, static_cast<uint64_t>(value) & masks_[index]);
+        if (flags & kMsbFirst) {
+            BitCodec::depositMsb(buffer, size, byte_offsets_[index], shifts_[index],
+                                 bit_widths_[index], crosses_word_[index] != 0, raw);
+        } else {
+            BitCodec::deposit(buffer, size, byte_offsets_[index], shifts_[index], masks_[index],
+                              crosses_word_[index] != 0, raw);
+        }
+    }
+
+    /**
+     * @brief Copies block field @p index out of a packed buffer into its storage form.
+     *
+     * @param index Index of an Array or Bytes field.
+     * @param buffer The packed buffer.
+     * @param size Size of the buffer; must be at least getTotalBytes().
+     * @param block Destination with room for getBlockSize(index) bytes; padding
+     *        bits of the last byte are cleared.
+     */
+    void extractBlock(size_t index, const uint8_t* buffer, size_t size, uint8_t* block) const;
+
+    /**
+     * @brief Reads element @p element of block field @p index from its storage.
+     *
+     * @param index Index of an Array or Bytes field.
+     * @param block The field's storage.
+     * @param element Index of the element.
+     * @return int64_t The element value, sign-extended for signed arrays.
+     */
+    int64_t extractElement(size_t index, const uint8_t* block, size_t element) const {
+        size_t bit = element * bit_widths_[index];
+        unsigned shift = static_cast<unsigned>(bit % 8);
+        unsigned width = bit_widths_[index];
+        uint64_t raw = bit_order_ == BitOrder::MsbFirst
+            ? BitCodec::extractMsb(block, getBlockSize(index), bit / 8, shift, width, shift + width > 64)
+            : BitCodec::extract(block, getBlockSize(index), bit / 8, shift, masks_[index], shift + width > 64);
+        raw = reorder(index, raw);
+        unsigned signShift = sign_shifts_[index];
+        return static_cast<int64_t>(raw << signShift) >> signShift;
+    }
+
+    /**
+     * @brief Writes element @p element of block field @p index into its storage.
+     *
+     * @param index Index of an Array or Bytes field.
+     * @param block The field's storage.
+     * @param element Index of the element.
+     * @param value The value to write; bits above the element width are ignored.
+     */
+    void depositElement(size_t index, uint8_t* block, size_t element, int64_t value) const {
+        size_t bit = element * bit_widths_[index];
+        unsigned shift = static_cast<unsigned>(bit % 8);
+        unsigned width = bit_widths_[index];
+        uint64_t raw = reorder(index, static_cast<uint64_t>(value) & masks_[index]);
+        if (bit_order_ == BitOrder::MsbFirst) {
+            BitCodec::depositMsb(block, getBlockSize(index), bit / 8, shift, width, shift + width > 64, raw);
+        } else {
+            BitCodec::deposit(block, getBlockSize(index), bit / 8, shift, masks_[index], shift + width > 64, raw);
+        }
+    }
+
+    /**
+     * @brief Decodes every element of block field @p index from its storage.
+     *
+     * @param index Index of an Array or Bytes field.
+     * @param block The field's storage.
+     * @param values Destination for elementCounts()[index] values.
+     */
+    void extractElements(size_t index, const uint8_t* block, int64_t* values) const;
+
+    /**
+     * @brief Encodes every element of block field @p index into its storage.
+     *
+     * @param index Index of an Array or Bytes field.
+     * @param block The field's storage, getBlockSize(index) bytes.
+     * @param values elementCounts()[index] values; bits above the element
+     *        width are ignored.
+     */
+    void depositElements(size_t index, uint8_t* block, const int64_t* values) const;
+
+    /**
+     * @brief Packs a complete message into @p buffer.
+     *
+     * Fields are streamed through a 64-bit accumulator that is flushed with one
+     * word store each time it fills up, so no byte is read or written twice and
+     * the buffer does not need to be cleared first. Exactly getTotalBytes() bytes
+     * are written, padding bits included. MSB-first messages fill the accumulator
+     * from the top and flush it as big-endian words. Block fields are fed to the
+     * accumulator 64 bits at a time, or copied with memcpy when the accumulator
+     * is on a byte boundary.
+     *
+     * @param valueAt Callable returning the int64_t value of scalar field i.
+     * @param blockAt Callable returning the storage of block field i (see
+     *        extractBlock()), or nullptr to pack it as zeros.
+     * @param buffer Destination with room for getTotalBytes() bytes.
+     */
+    template <typename ValueAt, typename BlockAt>
+    void pack(ValueAt&& valueAt, BlockAt&& blockAt, uint8_t* buffer) const {
+        if (bit_order_ == BitOrder::MsbFirst) {
+            packWith<MsbWriter>(valueAt, blockAt, buffer);
+        } else {
+            packWith<LsbWriter>(valueAt, blockAt, buffer);
+        }
+    }
+
+    /**
+     * @brief Packs a complete message whose block fields, if any, are all zero.
+     *
+     * @see pack(ValueAt&&, BlockAt&&, uint8_t*)
+     */
+    template <typename ValueAt>
+    void pack(ValueAt&& valueAt, uint8_t* buffer) const {
+        pack(valueAt, [](size_t) -> const uint8_t* { return nullptr; }, buffer);
+    }
+
+private:
+    std::vector<uint32_t> byte_offsets_;
+    std::vector<uint8_t> shifts_;
+    std::vector<uint8_t> bit_widths_;
+    std::vector<uint64_t> masks_;
+    std::vector<uint8_t> sign_shifts_;
+    std::vector<uint8_t> crosses_word_;
+    std::vector<uint8_t> order_flags_;
+    std::vector<uint32_t> element_counts_;
+    std::vector<uint32_t> block_offsets_;
+    size_t total_bits_;
+    size_t block_bytes_;
+    size_t block_field_count_;
+    BitOrder bit_order_;
+    bool default_order_;
+
+    // Converts raw field bits between the field's order and the message's; the
+    // conversion is its own inverse, so it serves both directions
+    uint64_t reorder(size_t index, uint64_t raw) const {
+        uint8_t flags = order_flags_[index];
+        unsigned unused = 64 - bit_widths_[index];
+        if (flags & kSwapBytes) {
+            raw = BitCodec::byteSwap64(raw) >> unused;
+        }
+        if (flags & kReverseBits) {
+            raw = BitCodec::bitReverse64(raw) >> unused;
+        }
+        return raw;
+    }
+
+    // Accumulates an LSB-first bit stream and flushes it as little-endian words
+    struct LsbWriter {
+        static constexpr uint8_t kNativeFlags = 0;
+
+        uint8_t* out;
+        uint64_t accumulator = 0;
+        unsigned filled = 0;
+
+        void put(uint64_t value, unsigned width) {
+            accumulator |= value << filled;
+            if (filled + width >= 64) {
+                BitCodec::storeLE64(out, accumulator);
+                out += 8;
+                accumulator = filled == 0 ? 0 : value >> (64 - filled);
+                filled = filled + width - 64;
+            } else {
+                filled += width;
+            }
+        }
+
+        void putBlock(const uint8_t* block, size_t bits) {
+            size_t bytes = bits / 8;
+            unsigned tail = static_cast<unsigned>(bits % 8);
+            if (filled % 8 == 0) {
+                BitCodec::storeLEPartial(out, accumulator, filled / 8);
+                out += filled / 8;
+                if (block != nullptr) {
+                    std::memcpy(out, block, bytes);
+                } else {
+                    std::memset(out, 0, bytes);
+                }
+                out += bytes;
+                accumulator = block != nullptr && tail != 0 ? block[bytes] & BitCodec::lowMask(tail) : 0;
+                filled = tail;
+                return;
+            }
+            size_t words = bits / 64;
+            for (size_t w = 0; w < words; ++w) {
+                put(block != nullptr ? BitCodec::loadLE64(block + 8 * w) : 0, 64);
+            }
+            unsigned rest = static_cast<unsigned>(bits % 64);
+            if (rest != 0) {
+                uint64_t last = block != nullptr ? BitCodec::loadLEPartial(block + 8 * words, (rest + 7) / 8) : 0;
+                put(last & BitCodec::lowMask(rest), rest);
+            }
+        }
+
+        void finish() {
+            BitCodec::storeLEPartial(out, accumulator, (filled + 7) / 8);
+        }
+    };
+
+    // Accumulates an MSB-first bit stream from the top and flushes it as big-endian words
+    struct MsbWriter {
+        static constexpr uint8_t kNativeFlags = kMsbFirst;
+
+        uint8_t* out;
+        uint64_t accumulator = 0;
+        unsigned filled = 0;
+
+        void put(uint64_t value, unsigned width) {
+            if (filled + width >= 64) {
+                unsigned spill = filled + width - 64;
+                accumulator |= value >> spill;
+                BitCodec::storeBE64(out, accumulator);
+                out += 8;
+                accumulator = spill == 0 ? 0 : value << (64 - spill);
+                filled = spill;
+            } else {
+                accumulator |= value << (64 - filled - width);
+                filled += width;
+            }
+        }
+
+        void putBlock(const uint8_t* block, size_t bits) {
+            size_t bytes = bits / 8;
+            unsigned tail = static_cast<unsigned>(bits % 8);
+            if (filled % 8 == 0) {
+                BitCodec::storeBEPartial(out, accumulator, filled / 8);
+                out += filled / 8;
+                if (block != nullptr) {
+                    std::memcpy(out, block, bytes);
+                } else {
+                    std::memset(out, 0, bytes);
+                }
+                out += bytes;
+                uint8_t top = block != nullptr && tail != 0 ? static_cast<uint8_t>(block[bytes] & (0xFF00 >> tail)) : 0;
+                accumulator = static_cast<uint64_t>(top) << 56;
+                filled = tail;
+                return;
+            }
+            size_t words = bits / 64;
+            for (size_t w = 0; w < words; ++w) {
+                put(block != nullptr ? BitCodec::loadBE64(block + 8 * w) : 0, 64);
+            }
+            unsigned rest = static_cast<unsigned>(bits % 64);
+            if (rest != 0) {
+                uint64_t last = block != nullptr ? BitCodec::loadBEPartial(block + 8 * words, (rest + 7) / 8) : 0;
+                put(last >> (64 - rest), rest);
+            }
+        }
+
+        void finish() {
+            BitCodec::storeBEPartial(out, accumulator, (filled + 7) / 8);
+        }
+    };
+
+    template <typename Writer, typename ValueAt, typename BlockAt>
+    void packWith(ValueAt& valueAt, BlockAt& blockAt, uint8_t* buffer) const {
+        Writer writer{buffer};
+        for (size_t i = 0; i < byte_offsets_.size(); ++i) {
+            uint8_t flags = order_flags_[i];
+            unsigned width = bit_widths_[i];
+            if (flags == Writer::kNativeFlags) {
+                writer.put(static_cast<uint64_t>(valueAt(i)) & masks_[i], width);
+            } else if (flags & kBlock) {
+                writer.putBlock(blockAt(i), static_cast<size_t>(width) * element_counts_[i]);
+            } else {
+                writer.put(reorder(i, static_cast<uint64_t>(valueAt(i)) & masks_[i]), width);
+            }
+        }
+        writer.finish();
+    }
+};
+
+} // namespace BinaryMessageLibrary
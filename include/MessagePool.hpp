@@ -0,0 +1,144 @@
+#pragma once
+
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+
+namespace BinaryMessageLibrary {
+
+class MessagePool;
+
+/**
+ * @brief Deleter that hands a pooled message back to its pool instead of freeing it.
+ */
+class MessageRecycler {
+public:
+    MessageRecycler() : pool_(nullptr), shard_(0) {}
+    MessageRecycler(MessagePool* pool, size_t shard) : pool_(pool), shard_(shard) {}
+
+    void operator()(BinaryMessage* message) const;
+
+private:
+    MessagePool* pool_;
+    size_t shard_;
+};
+
+/**
+ * @brief Recyclable handle to a BinaryMessage owned by a MessagePool.
+ *
+ * Behaves like std::unique_ptr<BinaryMessage>; when the handle is destroyed or
+ * reset, the message is reset to all-zero values and returned to its pool.
+ */
+using PooledMessage = std::unique_ptr<BinaryMessage, MessageRecycler>;
+
+/**
+ * @brief Pool of reusable BinaryMessage objects of a single message type.
+ *
+ * Messages are constructed in the pool's own block storage and recycled through
+ * free lists, so once the pool is warm, acquire() and releasing a handle perform
+ * no heap allocation at all. Resetting a recycled message is a single fill of
+ * its value array.
+ *
+ * The pool is thread-safe. To keep threads from contending, it is split into
+ * shards, each with its own lock, storage and free list; a thread always acquires
+ * from the shard assigned to it, and a message always returns to the shard it
+ * came from. Handles must not outlive the pool.
+ */
+class MessagePool {
+public:
+    /**
+     * @brief Constructs an empty pool for the given message configuration.
+     *
+     * @param config The message configuration; must outlive the pool.
+     * @param shardCount Number of independent shards; 0 selects one per
+     *        hardware thread.
+     */
+    explicit MessagePool(const MessageConfig& config, size_t shardCount = 0);
+
+    /**
+     * @brief Constructs an empty pool whose messages share ownership of a schema.
+     *
+     * @param schema The shared message configuration.
+     * @param shardCount Number of independent shards; 0 selects one per
+     *        hardware thread.
+     *
+     * @throws std::runtime_error if the schema is null.
+     */
+    explicit MessagePool(MessageSchema schema, size_t shardCount = 0);
+
+    MessagePool(const MessagePool&) = delete;
+    MessagePool& operator=(const MessagePool&) = delete;
+
+    /**
+     * @brief Takes a message from the pool, creating one if the pool is empty.
+     *
+     * The message has all fields set to 0.
+     *
+     * @return PooledMessage Handle that returns the message on destruction.
+     */
+    PooledMessage acquire();
+
+    /**
+     * @brief Pre-creates messages in the calling thread's shard.
+     *
+     * @param count Number of idle messages the shard should hold at least.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Gets the number of messages the pool has created so far.
+     *
+     * @return size_t Total messages, idle and in use.
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @brief Gets the number of idle messages ready to be acquired.
+     *
+     * @return size_t Messages currently in the free lists.
+     */
+    size_t getAvailable() const;
+
+    /**
+     * @brief Gets the message configuration the pool creates messages for.
+     *
+     * @return const MessageConfig& The message configuration.
+     */
+    const MessageConfig& getConfig() const;
+
+private:
+    friend class MessageRecycler;
+
+    // Padded to a cache line so shards used by different threads do not share one
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::deque<BinaryMessage> storage;
+        std::vector<BinaryMessage*> free;
+    };
+
+    MessageSchema schema_;
+    const MessageConfig* config_;
+    size_t shard_count_;
+    std::unique_ptr<Shard[]> shards_;
+
+    /**
+     * @brief Gets the shard assigned to the calling thread.
+     */
+    size_t currentShard() const;
+
+    /**
+     * @brief Constructs a new message in a shard's storage; the shard lock must be held.
+     */
+    BinaryMessage* createMessage(Shard& shard);
+
+    /**
+     * @brief Resets a message and puts it back on its shard's free list.
+     */
+    void release(BinaryMessage* message, size_t shard);
+};
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "FieldHandle.hpp"
+#include "FrameView.hpp"
+#include "MessageConfig.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Read-only view of a packed message that decodes fields on access.
+ *
+ * Unlike BinaryMessage::unpack(), which decodes every field up front, a view
+ * only remembers the buffer and its configuration. Each getField() call reads
+ * the one requested field through its precomputed layout entry (a word load,
+ * a shift and a mask), so reading a few fields of a wide message costs the
+ * same no matter how many fields it has.
+ *
+ * A view is two pointers and a size; it owns nothing. The buffer and the
+ * configuration must outlive it.
+ */
+class MessageView {
+public:
+    /**
+     * @brief Constructs a view of a packed message.
+     *
+     * @param config The message configuration.
+     * @param buffer The packed message.
+     * @param size Number of readable bytes at @p buffer.
+     *
+     * @throws std::runtime_error if the buffer is too small to hold the message.
+     */
+    MessageView(const MessageConfig& config, const uint8_t* buffer, size_t size);
+
+    /**
+     * @brief Constructs a view of a packed frame, e.g. from CaptureReader.
+     *
+     * @throws std::runtime_error if the frame is too small to hold the message.
+     */
+    MessageView(const MessageConfig& config, FrameView frame);
+
+    /**
+     * @brief Decodes one field by name.
+     *
+     * @param name The name of the field.
+     * @return int64_t The field value, as BinaryMessage::getField() would return it.
+     *
+     * @throws std::runtime_error if the field name is invalid or the field is
+     *         not a scalar.
+     */
+    int64_t getField(const std::string& name) const;
+
+    /**
+     * @brief Decodes one field through a pre-resolved handle.
+     *
+     * @param field Handle of the field.
+     * @return int64_t The field value, as BinaryMessage::getField() would return it.
+     *
+     * @throws std::runtime_error if the handle is invalid or the field is not a scalar.
+     */
+    int64_t getField(FieldHandle field) const {
+        const auto& layout = config_->getLayout();
+        if (field.index() >= layout.size() || !layout.isScalar(field.index())) {
+            throwInvalidHandle();
+        }
+        return layout.extract(field.index(), buffer_, size_);
+    }
+
+    /**
+     * @brief Gets the message configuration.
+     */
+    const MessageConfig& getConfig() const {
+        return *config_;
+    }
+
+    /**
+     * @brief Gets the viewed buffer.
+     */
+    const uint8_t* data() const {
+        return buffer_;
+    }
+
+    /**
+     * @brief Gets the number of bytes the packed message occupies.
+     */
+    size_t getPackedSize() const {
+        return config_->getLayout().getTotalBytes();
+    }
+
+protected:
+    const MessageConfig* config_;
+    const uint8_t* buffer_;
+    size_t size_;
+
+    [[noreturn]] static void throwInvalidHandle();
+};
+
+/**
+ * @brief View of a packed message that also patches fields in place.
+ *
+ * setField() rewrites only the bits of one field in the existing buffer (a
+ * read-modify-write of the word holding it), leaving every other bit as it
+ * was. Values are validated as by BinaryMessage::setField(). This suits
+ * forwarding paths that change a hop count or a flag in each frame without
+ * unpacking and repacking it.
+ */
+class MutableMessageView : public MessageView {
+public:
+    /**
+     * @brief Constructs a mutable view of a packed message.
+     *
+     * @param config The message configuration.
+     * @param buffer The packed message.
+     * @param size Number of writable bytes at @p buffer.
+     *
+     * @throws std::runtime_error if the buffer is too small to hold the message.
+     */
+    MutableMessageView(const MessageConfig& config, uint8_t* buffer, size_t size);
+
+    /**
+     * @brief Patches one field by name.
+     *
+     * @param name The name of the field.
+     * @param value The new value.
+     *
+     * @throws std::runtime_error if the field name is invalid or if the value is
+     *         outside the valid range for the field; the buffer is left unchanged.
+     */
+    void setField(const std::string& name, int64_t value);
+
+    /**
+     * @brief Patches one field through a pre-resolved handle.
+     *
+     * @param field Handle of the field.
+     * @param value The new value.
+     *
+     * @throws std::runtime_error if the handle is invalid, the field is not a
+     *         scalar, or the value is outside the valid range for the field; the
+     *         buffer is left unchanged.
+     */
+    void setField(FieldHandle field, int64_t value) {
+        const auto& layout = config_->getLayout();
+        size_t index = field.index();
+        if (index >= layout.size() || !layout.isScalar(index)) {
+            throwInvalidHandle();
+        }
+        if (!config_->getFields()[index].isValidValue(value)) {
+            throwOutOfRange(index, value);
+        }
+        layout.deposit(index, writable_, size_, value);
+    }
+
+    using MessageView::data;
+
+    /**
+     * @brief Gets the viewed buffer for writing.
+     */
+    uint8_t* data() {
+        return writable_;
+    }
+
+private:
+    uint8_t* writable_;
+
+    [[noreturn]] void throwOutOfRange(size_t index, int64_t value) const;
+};
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ByteIO.hpp"
+#include "MessageConfig.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Compact binary form of a message schema, embedded by the file formats.
+ *
+ * @code
+ * schema   message flags u8 | field count varint | field...
+ * field    name (varint length | bytes) | bit_width varint | flags u8 [| count varint]
+ * @endcode
+ *
+ * Message flags: bit 0 MSB-first bit order, bit 1 big-endian byte order.
+ * Field flags: bit 0 signed, bit 1 MSB-first, bit 2 big-endian, bit 3 array,
+ * bit 4 bytes; array and bytes fields are followed by their element count.
+ */
+namespace SchemaEncoding {
+
+/**
+ * @brief Appends the binary form of a message configuration.
+ *
+ * @param out Destination buffer.
+ * @param config The message configuration to encode.
+ */
+void encode(std::vector<uint8_t>& out, const MessageConfig& config);
+
+/**
+ * @brief Reads a schema written by encode() and returns its JSON definition.
+ *
+ * The definition is in the format accepted by MessageConfig and
+ * SchemaRegistry::intern().
+ *
+ * @param reader Reader positioned at the schema; advanced past it.
+ * @return nlohmann::json The message definition: a plain field array unless
+ *         the schema uses a non-default wire order.
+ *
+ * @throws std::runtime_error if the schema is truncated.
+ */
+nlohmann::json decode(ByteIO::Reader& reader);
+
+/**
+ * @brief Reads a schema written by encode() straight into a message configuration.
+ *
+ * Equivalent to building a MessageConfig from decode(), without the JSON round
+ * trip; used where schemas are loaded in bulk (see SchemaSnapshot).
+ *
+ * @param reader Reader positioned at the schema; advanced past it.
+ * @return MessageConfig The message configuration.
+ *
+ * @throws std::runtime_error if the schema is truncated or invalid.
+ */
+MessageConfig decodeConfig(ByteIO::Reader& reader);
+
+} // namespace SchemaEncoding
+
+} // namespace BinaryMessageLibrary
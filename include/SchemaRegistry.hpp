@@ -0,0 +1,104 @@
+#pragma once
+
+#include "MessageConfig.hpp"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Interns message schemas so identical definitions share one MessageConfig.
+ *
+ * intern() parses and validates a definition only the first time it is seen;
+ * later calls with an equal definition return the same MessageSchema.
+ * Schemas are identified by their SchemaEncoding form, so definitions that
+ * spell the same layout differently (e.g. with or without default orders),
+ * and schemas read from a SchemaSnapshot, share one MessageSchema too. The
+ * registry holds schemas weakly: a schema is destroyed once the last message,
+ * factory or codec using it lets go, and interning the definition again then
+ * builds a fresh one.
+ *
+ * The registry is thread-safe.
+ */
+class SchemaRegistry {
+public:
+    SchemaRegistry() = default;
+
+    SchemaRegistry(const SchemaRegistry&) = delete;
+    SchemaRegistry& operator=(const SchemaRegistry&) = delete;
+
+    /**
+     * @brief Gets the process-wide registry used by BinaryMessageFactory.
+     *
+     * @return SchemaRegistry& The global registry.
+     */
+    static SchemaRegistry& global();
+
+    /**
+     * @brief Returns the shared schema for a message definition, creating it if needed.
+     *
+     * @param definition JSON array containing field configurations, as accepted
+     *        by MessageConfig.
+     * @return MessageSchema The interned schema.
+     *
+     * @throws std::runtime_error if the definition is invalid.
+     */
+    MessageSchema intern(const nlohmann::json& definition);
+
+    /**
+     * @brief Returns the shared schema for a schema in binary form, creating it if needed.
+     *
+     * The binary form is the one written by SchemaEncoding::encode(); a miss
+     * builds the configuration with SchemaEncoding::decodeConfig(), without
+     * going through JSON. The result is shared with equal schemas interned
+     * from JSON.
+     *
+     * @param encoded The encoded schema.
+     * @param size Size of the encoded schema in bytes.
+     * @return MessageSchema The interned schema.
+     *
+     * @throws std::runtime_error if the encoded schema is malformed or invalid.
+     */
+    MessageSchema internEncoded(const uint8_t* encoded, size_t size);
+
+    /**
+     * @brief Gets the number of schemas currently alive in the registry.
+     *
+     * @return size_t Number of live interned schemas.
+     */
+    size_t size() const;
+
+private:
+    using SchemaTable = std::unordered_map<std::string, std::weak_ptr<const MessageConfig>>;
+
+    mutable std::mutex mutex_;
+    // Keyed by SchemaEncoding form; aliases_ maps JSON text to the same
+    // schemas, so repeated intern() calls skip building the configuration
+    SchemaTable schemas_;
+    SchemaTable aliases_;
+    size_t prune_threshold_ = 16;
+
+    /**
+     * @brief Returns the schema equal to a freshly built one, storing it if it
+     *        is new; the caller holds the mutex.
+     */
+    MessageSchema internBuilt(MessageSchema schema);
+
+    /**
+     * @brief Stores a schema under a key of one of the tables; the caller
+     *        holds the mutex.
+     */
+    void insert(SchemaTable& table, std::string key, const MessageSchema& schema);
+
+    /**
+     * @brief Drops entries whose schema has been destroyed.
+     */
+    void pruneExpired();
+};
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "MessageConfig.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Binary snapshot of a factory's message types, for fast startup.
+ *
+ * Layout (integers are little-endian, "varint" is LEB128, see Varint):
+ *
+ * @code
+ * header   "BMSS" | version u8 | source checksum u64 | body size u64 | body checksum u64
+ * body     type count varint | type...
+ * type     name (varint length | bytes) | schema size varint | schema (see SchemaEncoding)
+ * @endcode
+ *
+ * The source checksum identifies the JSON configuration the snapshot was made
+ * from; a snapshot only stands in for that exact text. The body checksum
+ * catches truncated or damaged files. Both checksums are 64-bit FNV-1a.
+ * Schemas are read straight from the snapshot's bytes (typically a MappedFile)
+ * into MessageConfig objects, without parsing or building any JSON.
+ */
+namespace SchemaSnapshot {
+
+/// Snapshot format version; snapshots of any other version are stale.
+constexpr uint8_t kVersion = 1;
+
+/// Message types in the order they are written or read.
+using TypeList = std::vector<std::pair<std::string, MessageSchema>>;
+
+/**
+ * @brief Computes the checksum used for sources and snapshot bodies.
+ *
+ * @param data The bytes to checksum.
+ * @param size Number of bytes.
+ * @return uint64_t The 64-bit FNV-1a hash of the bytes.
+ */
+uint64_t checksum(const uint8_t* data, size_t size);
+
+/**
+ * @brief Appends a snapshot of the given message types.
+ *
+ * @param out Destination buffer.
+ * @param types The message types and their schemas.
+ * @param sourceChecksum Checksum of the configuration the types were loaded from.
+ */
+void encode(std::vector<uint8_t>& out, const TypeList& types, uint64_t sourceChecksum);
+
+/**
+ * @brief Reads a snapshot, if it is current.
+ *
+ * Schemas are interned with SchemaRegistry::internEncoded(), so loading the
+ * same snapshot again shares them.
+ *
+ * @param data The snapshot.
+ * @param size Size of the snapshot in bytes.
+ * @param sourceChecksum Checksum of the configuration the snapshot must match.
+ * @param types Receives the message types; left unchanged unless the snapshot
+ *        is current and well-formed.
+ * @return true if the types were read; false if the snapshot is stale: not a
+ *         snapshot, of another version, made from another source, or
+ *         failing its body checksum.
+ *
+ * @throws std::runtime_error if a snapshot that passes its checks is malformed.
+ */
+bool decode(const uint8_t* data, size_t size, uint64_t sourceChecksum, TypeList& types);
+
+} // namespace SchemaSnapshot
+
+} // namespace BinaryMessageLibrary
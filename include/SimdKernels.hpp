@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Instruction set levels the column extraction kernels can run at.
+ */
+enum class SimdLevel {
+    Scalar,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @brief Vectorized kernels that pull one field out of many packed frames.
+ *
+ * Extracting the same field from N frames laid out at a constant stride is a
+ * strided gather of 64-bit words followed by a shift, a mask and a sign
+ * extension, all with the same parameters. The kernels here do exactly that,
+ * using AVX2 or AVX-512 gathers when the CPU supports them (detected once at
+ * runtime) and a portable scalar loop otherwise. Every level produces results
+ * bit-identical to the scalar loop.
+ *
+ * The kernels only handle fields that fit in the 64-bit word loaded at their
+ * byte offset (i.e. not MessageLayout::crossesWord()), and read a full 8-byte
+ * word from every frame, so the caller must ensure those words are in bounds.
+ */
+namespace SimdKernels {
+
+/**
+ * @brief Detects the best instruction set level supported by this CPU and OS.
+ *
+ * @return SimdLevel The highest usable level; Scalar on non-x86 builds.
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief Gets the level used by the dispatching extractColumn() overload.
+ *
+ * This is detectSimdLevel(), computed once on first use.
+ *
+ * @return SimdLevel The active level.
+ */
+SimdLevel activeSimdLevel();
+
+/**
+ * @brief Gets a printable name for a level ("scalar", "avx2", "avx512").
+ */
+const char* simdLevelName(SimdLevel level);
+
+/**
+ * @brief Extracts one field from @p count frames into a column.
+ *
+ * For frame i the word at @p words + i * @p stride is loaded little-endian and
+ * the result is ((word >> shift) & mask), sign-extended by @p signShift
+ * (64 - bit_width for signed fields, 0 for unsigned ones).
+ *
+ * @param words Address of the field's first byte in the first frame.
+ * @param count Number of frames.
+ * @param stride Distance in bytes between consecutive frames.
+ * @param shift Bit position of the field within its first byte.
+ * @param mask Mask with the low bit_width bits set.
+ * @param signShift Sign-extension shift.
+ * @param out Output column with room for @p count values.
+ */
+void extractColumn(const uint8_t* words, size_t count, size_t stride,
+                   unsigned shift, uint64_t mask, unsigned signShift, int64_t* out);
+
+/**
+ * @brief Same as extractColumn() but at an explicit level.
+ *
+ * Levels the CPU does not support fall back to the best supported one, so this
+ * is safe to call with any level, e.g. to compare kernels against each other.
+ */
+void extractColumn(SimdLevel level, const uint8_t* words, size_t count, size_t stride,
+                   unsigned shift, uint64_t mask, unsigned signShift, int64_t* out);
+
+/**
+ * @brief Tests one field of up to 64 frames against an unsigned key range.
+ *
+ * For frame i the field is extracted as in extractColumn() (without sign
+ * extension) and turned into a key with key = raw ^ @p flip. Bit i of the result
+ * is set when lo <= key <= lo + span, evaluated as (key - lo) <= span in
+ * wrapping 64-bit arithmetic. Passing the field's sign bit as @p flip maps
+ * two's-complement values to keys in the same order, so any comparison against
+ * a constant reduces to one such range test.
+ *
+ * @param words Address of the field's first byte in the first frame.
+ * @param count Number of frames, at most 64.
+ * @param stride Distance in bytes between consecutive frames.
+ * @param shift Bit position of the field within its first byte.
+ * @param mask Mask with the low bit_width bits set.
+ * @param flip Value XOR-ed into each raw field value.
+ * @param lo Lowest key in the range.
+ * @param span Highest key in the range minus @p lo.
+ * @return uint64_t Bitmap of the matching frames.
+ */
+uint64_t matchRange(const uint8_t* words, size_t count, size_t stride,
+                    unsigned shift, uint64_t mask, uint64_t flip, uint64_t lo, uint64_t span);
+
+/**
+ * @brief Same as matchRange() but at an explicit level.
+ *
+ * Levels the CPU does not support fall back to the best supported one.
+ */
+uint64_t matchRange(SimdLevel level, const uint8_t* words, size_t count, size_t stride,
+                    unsigned shift, uint64_t mask, uint64_t flip, uint64_t lo, uint64_t span);
+
+} // namespace SimdKernels
+
+} // namespace BinaryMessageLibrary
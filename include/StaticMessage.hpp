@@ -0,0 +1,266 @@
+#pragma once
+
+#include "BitCodec.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Declares a tag type naming a field of a StaticMessage.
+ *
+ * The library targets C++17, which has no string literal template arguments, so
+ * field names are carried by small tag types instead:
+ *
+ * @code
+ * BINARY_MESSAGE_FIELD_NAME(Temperature, "temperature");
+ * using Sensor = StaticMessage<Field<SensorId, 6>, Field<Temperature, 10, true>>;
+ * @endcode
+ */
+#define BINARY_MESSAGE_FIELD_NAME(Tag, text) \
+    struct Tag {                             \
+        static constexpr const char* value = text; \
+    }
+
+/**
+ * @brief Compile-time description of a single field.
+ *
+ * @tparam Name Tag type declared with BINARY_MESSAGE_FIELD_NAME.
+ * @tparam Width Number of bits allocated for the field (1-64).
+ * @tparam Signed Whether the field represents a signed value.
+ */
+template <typename Name, unsigned Width, bool Signed = false>
+struct Field {
+    static_assert(Width >= 1 && Width <= 64, "Field bit width must be between 1 and 64");
+
+    using name_type = Name;
+    static constexpr unsigned bit_width = Width;
+    static constexpr bool is_signed = Signed;
+
+    static constexpr int64_t max_value =
+        Signed ? static_cast<int64_t>((1ULL << (Width - 1)) - 1)
+               : (Width >= 64 ? INT64_MAX : static_cast<int64_t>((1ULL << (Width % 64)) - 1));
+    static constexpr int64_t min_value = Signed ? -max_value - 1 : 0;
+};
+
+/**
+ * @brief Binary message whose schema is fixed at compile time.
+ *
+ * StaticMessage produces exactly the same wire format as a BinaryMessage built
+ * from the equivalent JSON definition (see schema()), but every field offset,
+ * shift and mask is a compile-time constant, so pack() and unpack() compile to
+ * straight-line shift/mask code with no lookups or loops. Static messages use the
+ * default LSB-first, little-endian wire order.
+ *
+ * @tparam Fields The message fields, as Field<> instantiations, in wire order;
+ *         no two may share a name tag.
+ */
+template <typename... Fields>
+class StaticMessage {
+public:
+    /// Number of fields in the message.
+    static constexpr size_t kFieldCount = sizeof...(Fields);
+
+    /// Total number of bits of a packed message.
+    static constexpr size_t kTotalBits = (size_t{0} + ... + Fields::bit_width);
+
+    /// Number of bytes of a packed message (bits rounded up).
+    static constexpr size_t kPackedSize = (kTotalBits + 7) / 8;
+
+    /**
+     * @brief Constructs a message with all fields set to 0.
+     */
+    StaticMessage() : values_{} {}
+
+    /**
+     * @brief Sets the value of the field named by tag @p Name.
+     *
+     * @param value The value to set.
+     *
+     * @throws std::runtime_error if the value is outside the valid range for
+     *         the field.
+     */
+    template <typename Name>
+    void set(int64_t value) {
+        static_assert(indexOf<Name>() < kFieldCount, "No field with this name in the message");
+        set<indexOf<Name>()>(value);
+    }
+
+    /**
+     * @brief Gets the value of the field named by tag @p Name.
+     */
+    template <typename Name>
+    int64_t get() const {
+        static_assert(indexOf<Name>() < kFieldCount, "No field with this name in the message");
+        return values_[indexOf<Name>()];
+    }
+
+    /**
+     * @brief Sets the value of the field at position @p Index.
+     *
+     * @throws std::runtime_error if the value is outside the valid range for
+     *         the field.
+     */
+    template <size_t Index>
+    void set(int64_t value) {
+        using F = FieldAt<Index>;
+        if (value < F::min_value || value > F::max_value) {
+            throw std::runtime_error("Value " + std::to_string(value) +
+                                     " out of range for field " + F::name_type::value);
+        }
+        values_[Index] = value;
+    }
+
+    /**
+     * @brief Gets the value of the field at position @p Index.
+     */
+    template <size_t Index>
+    int64_t get() const {
+        return values_[Index];
+    }
+
+    /**
+     * @brief Packs the message into a fixed-size array.
+     *
+     * @return std::array<uint8_t, kPackedSize> The packed message.
+     */
+    std::array<uint8_t, kPackedSize> pack() const {
+        std::array<uint8_t, kPackedSize> buffer{};
+        packFields(buffer.data(), std::index_sequence_for<Fields...>{});
+        return buffer;
+    }
+
+    /**
+     * @brief Packs the message into a caller-provided buffer.
+     *
+     * @param buffer Destination buffer.
+     * @param size Size of the destination buffer in bytes.
+     * @return size_t The number of bytes written (kPackedSize).
+     *
+     * @throws std::runtime_error if the buffer is too small to hold the message.
+     */
+    size_t packInto(uint8_t* buffer, size_t size) const {
+        if (size < kPackedSize) {
+            throw std::runtime_error("Buffer too small for message");
+        }
+        auto packed = pack();
+        std::copy(packed.begin(), packed.end(), buffer);
+        return kPackedSize;
+    }
+
+    /**
+     * @brief Unpacks the message from a caller-provided buffer.
+     *
+     * @param buffer Source buffer.
+     * @param size Number of readable bytes at @p buffer.
+     * @return size_t The number of bytes consumed (kPackedSize).
+     *
+     * @throws std::runtime_error if the buffer is too small to hold the message.
+     */
+    size_t unpackFrom(const uint8_t* buffer, size_t size) {
+        if (size < kPackedSize) {
+            throw std::runtime_error("Buffer too small for message");
+        }
+        unpackFields(buffer, std::index_sequence_for<Fields...>{});
+        return kPackedSize;
+    }
+
+    /**
+     * @brief Gets the name of the field at position @p index.
+     */
+    static const char* fieldName(size_t index) {
+        static constexpr const char* names[] = {Fields::name_type::value...};
+        return names[index];
+    }
+
+    /**
+     * @brief Gets the bit offset of the field at position @p Index.
+     */
+    template <size_t Index>
+    static constexpr size_t bitOffset() {
+        constexpr size_t widths[] = {Fields::bit_width...};
+        size_t offset = 0;
+        for (size_t i = 0; i < Index; ++i) {
+            offset += widths[i];
+        }
+        return offset;
+    }
+
+    /**
+     * @brief Describes the message in the JSON format accepted by MessageConfig.
+     *
+     * @return nlohmann::json The equivalent runtime message definition.
+     */
+    static nlohmann::json schema() {
+        nlohmann::json fields = nlohmann::json::array();
+        (fields.push_back({{"name", Fields::name_type::value},
+                           {"bit_width", Fields::bit_width},
+                           {"signed", Fields::is_signed}}), ...);
+        return fields;
+    }
+
+private:
+    template <size_t Index>
+    using FieldAt = std::tuple_element_t<Index, std::tuple<Fields...>>;
+
+    // Number of fields named by tag Name
+    template <typename Name>
+    static constexpr size_t kNameCount = (size_t{0} + ... + size_t{std::is_same_v<Name, typename Fields::name_type>});
+
+    static_assert(((kNameCount<typename Fields::name_type> == 1) && ...),
+                  "Each field of a StaticMessage needs its own name tag");
+
+    template <typename Name>
+    static constexpr size_t indexOf() {
+        constexpr bool matches[] = {std::is_same_v<Name, typename Fields::name_type>...};
+        size_t index = kFieldCount;
+        for (size_t i = 0; i < kFieldCount; ++i) {
+            if (matches[i]) {
+                index = i;
+            }
+        }
+        return index;
+    }
+
+    template <size_t Index>
+    void packField(uint8_t* buffer) const {
+        using F = FieldAt<Index>;
+        constexpr size_t offset = bitOffset<Index>();
+        constexpr unsigned shift = offset % 8;
+        BitCodec::deposit(buffer, kPackedSize, offset / 8, shift, BitCodec::lowMask(F::bit_width),
+                          shift + F::bit_width > 64, static_cast<uint64_t>(values_[Index]));
+    }
+
+    template <size_t Index>
+    void unpackField(const uint8_t* buffer) {
+        using F = FieldAt<Index>;
+        constexpr size_t offset = bitOffset<Index>();
+        constexpr unsigned shift = offset % 8;
+        constexpr unsigned signShift = F::is_signed ? 64 - F::bit_width : 0;
+        uint64_t raw = BitCodec::extract(buffer, kPackedSize, offset / 8, shift,
+                                         BitCodec::lowMask(F::bit_width), shift + F::bit_width > 64);
+        values_[Index] = static_cast<int64_t>(raw << signShift) >> signShift;
+    }
+
+    template <size_t... Indices>
+    void packFields(uint8_t* buffer, std::index_sequence<Indices...>) const {
+        (packField<Indices>(buffer), ...);
+    }
+
+    template <size_t... Indices>
+    void unpackFields(const uint8_t* buffer, std::index_sequence<Indices...>) {
+        (unpackField<Indices>(buffer), ...);
+    }
+
+    std::array<int64_t, kFieldCount> values_;
+};
+
+} // namespace BinaryMessageLibrary
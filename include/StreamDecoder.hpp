@@ -0,0 +1,155 @@
+#pragma once
+
+#include "BatchCodec.hpp"
+#include "MessageConfig.hpp"
+#include "ThreadPool.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Order in which StreamDecoder::forEachChunk() hands chunks to the consumer.
+ */
+enum class StreamOrder {
+    Unordered,  ///< Chunks are delivered as soon as they are decoded, concurrently.
+    InputOrder  ///< Chunks are delivered one at a time, in input order.
+};
+
+/**
+ * @brief A decoded chunk of a frame stream, as passed to a chunk consumer.
+ */
+struct DecodedChunk {
+    /// Index of the chunk's first frame within the stream.
+    size_t firstFrame;
+
+    /// Number of frames in the chunk.
+    size_t frameCount;
+
+    /// One column per field, in field order, each holding frameCount values.
+    /// Only valid for the duration of the consumer call.
+    const int64_t* const* columns;
+
+    /// Index of the worker that decoded the chunk, for per-thread consumer state.
+    size_t worker;
+};
+
+/**
+ * @brief Decodes large captures of back-to-back same-typed frames on all cores.
+ *
+ * The stream is cut into chunks of getChunkFrames() frames that are decoded with
+ * a BatchCodec on a work-stealing ThreadPool. Each worker owns its scratch
+ * columns, so decoding needs no synchronization and no allocation per chunk.
+ *
+ * A decoder runs one stream at a time; its methods must not be called
+ * concurrently.
+ */
+class StreamDecoder {
+public:
+    /// Default number of frames per chunk.
+    static constexpr size_t kDefaultChunkFrames = 16384;
+
+    /**
+     * @brief Constructs a decoder and starts its worker threads.
+     *
+     * @param config The message configuration of every frame; must outlive the decoder.
+     * @param threadCount Number of workers, the calling thread included; 0
+     *        selects one per hardware thread.
+     * @param chunkFrames Number of frames per chunk.
+     *
+     * @throws std::runtime_error if chunkFrames is 0 or the frame size is 0.
+     */
+    explicit StreamDecoder(const MessageConfig& config, size_t threadCount = 0,
+                           size_t chunkFrames = kDefaultChunkFrames);
+
+    /**
+     * @brief Gets the number of complete frames in a buffer of @p size bytes.
+     *
+     * Trailing bytes that do not form a whole frame are ignored by all decode
+     * methods.
+     *
+     * @param size Size of the stream in bytes.
+     * @return size_t Number of frames.
+     */
+    size_t getFrameCount(size_t size) const;
+
+    /**
+     * @brief Decodes a stream into per-field columns in input order.
+     *
+     * @param data Pointer to the first frame.
+     * @param size Size of the stream in bytes.
+     * @param columns One output array per field, in field order, each holding
+     *        at least getFrameCount(size) values.
+     * @return size_t Number of frames decoded.
+     */
+    size_t decode(const uint8_t* data, size_t size, int64_t* const* columns);
+
+    /**
+     * @brief Decodes a stream into newly allocated per-field columns in input order.
+     *
+     * @param data Pointer to the first frame.
+     * @param size Size of the stream in bytes.
+     * @return std::vector<std::vector<int64_t>> One column per field.
+     */
+    std::vector<std::vector<int64_t>> decode(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Decodes a stream chunk by chunk and passes each chunk to a consumer.
+     *
+     * With StreamOrder::InputOrder, consumer calls are serialized and follow the
+     * input order while later chunks are decoded in the background. With
+     * StreamOrder::Unordered, the consumer is called concurrently from all
+     * workers and must be thread-safe; DecodedChunk::worker can index
+     * per-thread state.
+     *
+     * @param data Pointer to the first frame.
+     * @param size Size of the stream in bytes.
+     * @param consumer Callback receiving every decoded chunk.
+     * @param order Delivery order.
+     *
+     * @throws Any exception thrown by the consumer; chunks not yet delivered
+     *         are dropped.
+     */
+    void forEachChunk(const uint8_t* data, size_t size,
+                      const std::function<void(const DecodedChunk&)>& consumer,
+                      StreamOrder order = StreamOrder::InputOrder);
+
+    /**
+     * @brief Gets the number of workers.
+     *
+     * @return size_t Number of workers, the calling thread included.
+     */
+    size_t getThreadCount() const;
+
+    /**
+     * @brief Gets the number of frames per chunk.
+     *
+     * @return size_t Chunk size in frames.
+     */
+    size_t getChunkFrames() const;
+
+    /**
+     * @brief Gets the batch codec used to decode chunks.
+     *
+     * @return const BatchCodec& The codec.
+     */
+    const BatchCodec& getCodec() const;
+
+private:
+    // pointers always address columns; decode() aims outputs at the caller's
+    // columns instead, so the two never see each other's targets
+    struct Scratch {
+        std::vector<std::vector<int64_t>> columns;
+        std::vector<int64_t*> pointers;
+        std::vector<int64_t*> outputs;
+    };
+
+    BatchCodec codec_;
+    size_t chunk_frames_;
+    ThreadPool pool_;
+    std::vector<Scratch> scratch_;
+};
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,224 @@
+#pragma once
+
+#include "MessageConfig.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Binds the fields of a message configuration to the members of a struct.
+ *
+ * Members are bound to fields by name once, through member pointers; packing
+ * and unpacking then go straight between the struct and the wire in a single
+ * pass over the layout, with no name lookups and no intermediate BinaryMessage.
+ *
+ * @code
+ * struct Sensor { uint8_t id; int16_t temperature; bool alarm; };
+ *
+ * StructBinding<Sensor> binding(config);
+ * binding.bind(&Sensor::id, "sensor_id")
+ *        .bind(&Sensor::temperature, "temperature")
+ *        .bind(&Sensor::alarm, "alarm");
+ *
+ * binding.pack(sensor, buffer, size);
+ * binding.unpack(buffer, size, sensor);
+ * @endcode
+ *
+ * Members may be integers, enums or bool, and must be wide enough to hold every
+ * value of their field. Fields without a member are packed as 0 and skipped
+ * when unpacking.
+ *
+ * @tparam T The struct type.
+ */
+template <typename T>
+class StructBinding {
+public:
+    /**
+     * @brief Constructs a binding with no members bound.
+     *
+     * @param config The message configuration; must outlive the binding.
+     */
+    explicit StructBinding(const MessageConfig& config)
+        : config_(config), members_(config.getFields().size()) {}
+
+    /**
+     * @brief Binds a struct member to a field.
+     *
+     * @param member Pointer to the member.
+     * @param fieldName Name of the field.
+     * @return StructBinding& This binding, for chaining.
+     *
+     * @throws std::runtime_error if the field does not exist, is not a scalar,
+     *         is already bound, or has values the member type cannot hold.
+     */
+    template <typename M>
+    StructBinding& bind(M T::*member, const std::string& fieldName) {
+        static_assert(std::is_integral<M>::value || std::is_enum<M>::value,
+                      "Bound members must be integers, enums or bool");
+        static_assert(sizeof(member) <= sizeof(Member::pointer), "Unsupported member pointer size");
+
+        size_t index = config_.getFieldHandle(fieldName).index();
+        if (members_[index].load) {
+            throw std::runtime_error("Field " + fieldName + " is already bound");
+        }
+        const FieldConfig& field = config_.getFields()[index];
+        if (!field.isScalar()) {
+            throw std::runtime_error("Field " + fieldName + " is not a scalar");
+        }
+        if (!holdsField<M>(field)) {
+            throw std::runtime_error("Member type too narrow for field " + fieldName);
+        }
+
+        Member& bound = members_[index];
+        std::memcpy(bound.pointer, &member, sizeof(member));
+        bound.load = &loadMember<M>;
+        bound.store = &storeMember<M>;
+        return *this;
+    }
+
+    /**
+     * @brief Gets the number of bytes a packed message occupies.
+     */
+    size_t getPackedSize() const {
+        return config_.getLayout().getTotalBytes();
+    }
+
+    /**
+     * @brief Packs a struct into a caller-provided buffer.
+     *
+     * Writes exactly getPackedSize() bytes; bytes past it are left untouched.
+     *
+     * @param object The struct to pack.
+     * @param buffer Destination buffer.
+     * @param size Size of the destination buffer in bytes.
+     * @return size_t The number of bytes written.
+     *
+     * @throws std::runtime_error if the buffer is too small or a member value is
+     *         outside the valid range for its field; the buffer contents are
+     *         then unspecified.
+     */
+    size_t pack(const T& object, uint8_t* buffer, size_t size) const {
+        const auto& layout = config_.getLayout();
+        size_t totalBytes = layout.getTotalBytes();
+        if (size < totalBytes) {
+            throw std::runtime_error("Buffer too small for message");
+        }
+        const auto& fields = config_.getFields();
+        layout.pack([&](size_t i) -> int64_t {
+            const Member& member = members_[i];
+            if (!member.load) {
+                return 0;
+            }
+            int64_t value = member.load(object, member.pointer);
+            if (!fields[i].isValidValue(value)) {
+                throw std::runtime_error("Value " + std::to_string(value) +
+                                         " out of range for field " + fields[i].name());
+            }
+            return value;
+        }, buffer);
+        return totalBytes;
+    }
+
+    /**
+     * @brief Packs a struct into a newly allocated buffer.
+     *
+     * @throws std::runtime_error if a member value is outside the valid range
+     *         for its field.
+     */
+    std::vector<uint8_t> pack(const T& object) const {
+        std::vector<uint8_t> buffer(getPackedSize());
+        pack(object, buffer.data(), buffer.size());
+        return buffer;
+    }
+
+    /**
+     * @brief Unpacks a message into the bound members of a struct.
+     *
+     * Members that are not bound are left unchanged.
+     *
+     * @param buffer Source buffer.
+     * @param size Number of readable bytes at @p buffer.
+     * @param object The struct to fill.
+     * @return size_t The number of bytes consumed (getPackedSize()).
+     *
+     * @throws std::runtime_error if the buffer is too small to hold the message.
+     */
+    size_t unpack(const uint8_t* buffer, size_t size, T& object) const {
+        const auto& layout = config_.getLayout();
+        size_t totalBytes = layout.getTotalBytes();
+        if (size < totalBytes) {
+            throw std::runtime_error("Buffer too small for message");
+        }
+        for (size_t i = 0; i < members_.size(); ++i) {
+            const Member& member = members_[i];
+            if (member.store) {
+                member.store(object, member.pointer, layout.extract(i, buffer, size));
+            }
+        }
+        return totalBytes;
+    }
+
+    /**
+     * @brief Gets the message configuration the binding was built for.
+     */
+    const MessageConfig& getConfig() const {
+        return config_;
+    }
+
+private:
+    // A bound member: its member pointer, type-erased, and accessors for its type
+    struct Member {
+        alignas(std::max_align_t) unsigned char pointer[sizeof(int T::*) * 2] = {};
+        int64_t (*load)(const T&, const unsigned char*) = nullptr;
+        void (*store)(T&, const unsigned char*, int64_t) = nullptr;
+    };
+
+    const MessageConfig& config_;
+    std::vector<Member> members_;
+
+    template <typename M>
+    static M T::*memberPointer(const unsigned char* pointer) {
+        M T::*member;
+        std::memcpy(&member, pointer, sizeof(member));
+        return member;
+    }
+
+    template <typename M>
+    static int64_t loadMember(const T& object, const unsigned char* pointer) {
+        return static_cast<int64_t>(object.*memberPointer<M>(pointer));
+    }
+
+    template <typename M>
+    static void storeMember(T& object, const unsigned char* pointer, int64_t value) {
+        if constexpr (std::is_same<M, bool>::value) {
+            object.*memberPointer<M>(pointer) = value != 0;
+        } else {
+            object.*memberPointer<M>(pointer) = static_cast<M>(value);
+        }
+    }
+
+    // Whether every value of the field survives a round trip through M
+    template <typename M>
+    static bool holdsField(const FieldConfig& field) {
+        if constexpr (std::is_same<M, bool>::value) {
+            return field.getMinValue() == 0 && field.getMaxValue() == 1;
+        } else if constexpr (std::is_enum<M>::value) {
+            return holdsField<std::underlying_type_t<M>>(field);
+        } else if constexpr (std::is_signed<M>::value) {
+            return field.getMinValue() >= static_cast<int64_t>(std::numeric_limits<M>::min()) &&
+                   field.getMaxValue() <= static_cast<int64_t>(std::numeric_limits<M>::max());
+        } else {
+            return field.getMinValue() >= 0 &&
+                   static_cast<uint64_t>(field.getMaxValue()) <= std::numeric_limits<M>::max();
+        }
+    }
+};
+
+} // namespace BinaryMessageLibrary
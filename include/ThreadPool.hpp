@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief Fixed-size work-stealing thread pool for data-parallel jobs.
+ *
+ * run() executes task indices [0, taskCount) on all workers, the calling thread
+ * included, and returns when every task has finished. Each worker starts with an
+ * equal contiguous range of indices and works through it front to back; a worker
+ * that runs dry steals the back half of another worker's remaining range. Ranges
+ * are single 64-bit atomics, so taking or stealing a task never locks.
+ *
+ * One job runs at a time; concurrent run() calls are serialized.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Task callback: the task index and the index of the worker running it.
+     *
+     * Worker indices are in [0, getThreadCount()) and identify per-thread
+     * scratch state; no two tasks with the same worker index run concurrently.
+     */
+    using Task = std::function<void(size_t task, size_t worker)>;
+
+    /**
+     * @brief Starts the pool.
+     *
+     * @param threadCount Total number of workers, including the thread calling
+     *        run(); 0 selects one per hardware thread.
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+
+    /**
+     * @brief Stops and joins all worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Gets the number of workers, including the calling thread.
+     *
+     * @return size_t Number of workers.
+     */
+    size_t getThreadCount() const;
+
+    /**
+     * @brief Runs tasks [0, taskCount) in parallel and waits for them.
+     *
+     * @param taskCount Number of tasks.
+     * @param task Callback invoked once per task index.
+     *
+     * @throws std::runtime_error if taskCount does not fit in 32 bits.
+     * @throws Any exception thrown by a task; the first one is rethrown after
+     *         all workers have stopped, and tasks not yet started are skipped.
+     */
+    void run(size_t taskCount, const Task& task);
+
+private:
+    // Remaining task range of one worker, packed as (begin << 32) | end
+    struct alignas(64) WorkRange {
+        std::atomic<uint64_t> range{0};
+    };
+
+    size_t thread_count_;
+    std::unique_ptr<WorkRange[]> ranges_;
+    std::vector<std::thread> threads_;
+
+    std::mutex run_mutex_;
+    std::mutex state_mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_ = 0;
+    size_t busy_workers_ = 0;
+    bool stopping_ = false;
+
+    const Task* task_ = nullptr;
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+
+    /**
+     * @brief Main loop of a background worker.
+     */
+    void workerLoop(size_t worker);
+
+    /**
+     * @brief Runs tasks from the worker's own range and steals until none are left.
+     */
+    void work(size_t worker);
+
+    /**
+     * @brief Takes the next task from the front of a worker's own range.
+     */
+    bool takeOwn(size_t worker, uint32_t& task);
+
+    /**
+     * @brief Moves the back half of another worker's range into this worker's.
+     */
+    bool steal(size_t worker, uint32_t& task);
+};
+
+} // namespace BinaryMessageLibrary
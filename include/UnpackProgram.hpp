@@ -0,0 +1,101 @@
+#pragma once
+
+#include "MessageLayout.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief A fixed message layout lowered to a straight-line unpacking program.
+ *
+ * MessageLayout::extract() works out per field, at every call, whether the field
+ * needs reordering, which word load is safe at the end of the buffer and whether
+ * the field spills past that word. The program settles all of that once: it
+ * loads each 64-bit window of the message a single time and cuts every scalar
+ * field lying entirely inside the window out of that register with two shifts,
+ * which also sign-extend. Adjacent fields, byte-aligned ones in particular, so
+ * share one wide load. Windows that would run past the end of the message use
+ * a partial load decided at compile time. Fields that spill past their window
+ * or need bit reversal or byte swapping, and block fields, are delegated to the
+ * layout.
+ *
+ * The interpreter threads its dispatch through computed gotos where the
+ * compiler supports them, and falls back to a switch loop otherwise.
+ */
+class UnpackProgram {
+public:
+    /**
+     * @brief Instruction opcodes.
+     */
+    enum class Op : uint8_t {
+        /// Loads the little-endian word at byte @c offset into the register.
+        Word,
+        /// Loads the @c count (< 8) bytes at byte @c offset as a little-endian word.
+        WordTail,
+        /// Loads the big-endian word at byte @c offset into the register.
+        WordMsb,
+        /// Loads the @c count (< 8) bytes at byte @c offset into the top of a big-endian word.
+        WordMsbTail,
+        /// Stores (register << @c left) >> @c right to field @c slot, zero-extended.
+        Unsigned,
+        /// Stores (register << @c left) >> @c right to field @c slot, sign-extended.
+        Signed,
+        /// Stores MessageLayout::extract() of field @c slot.
+        Extract,
+        /// Copies block field @c slot to its storage with MessageLayout::extractBlock().
+        Block,
+        /// Ends the program.
+        End
+    };
+
+    /**
+     * @brief One unpacking instruction; the meaning of the operands depends on the opcode.
+     */
+    struct Instruction {
+        Op op;
+        uint8_t left;
+        uint8_t right;
+        uint8_t count;
+        uint32_t slot;
+        uint32_t offset;
+    };
+
+    /**
+     * @brief Constructs a program for a message without fields.
+     */
+    UnpackProgram();
+
+    /**
+     * @brief Lowers a layout to an unpacking program.
+     *
+     * @param layout The layout to compile; run() must be given the same one.
+     */
+    explicit UnpackProgram(const MessageLayout& layout);
+
+    /**
+     * @brief Unpacks every field of a message.
+     *
+     * @param layout The layout the program was compiled from.
+     * @param buffer The packed message; the caller has checked that it holds
+     *        at least layout.getTotalBytes() bytes.
+     * @param size Size of the buffer.
+     * @param values Destination for the value of each scalar field, indexed by field.
+     * @param blocks Block storage of the message (see MessageLayout::blockOffsets()).
+     */
+    void run(const MessageLayout& layout, const uint8_t* buffer, size_t size,
+             int64_t* values, uint8_t* blocks) const;
+
+    /**
+     * @brief Gets the compiled instruction stream.
+     */
+    const std::vector<Instruction>& getInstructions() const {
+        return instructions_;
+    }
+
+private:
+    std::vector<Instruction> instructions_;
+};
+
+} // namespace BinaryMessageLibrary
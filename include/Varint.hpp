@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace BinaryMessageLibrary {
+
+/**
+ * @brief LEB128 variable-length encoding of unsigned integers.
+ *
+ * Each byte carries 7 value bits, least significant group first; the high bit
+ * is set on every byte except the last. Values below 128 take a single byte and
+ * a 64-bit value takes at most kMaxBytes.
+ */
+namespace Varint {
+
+/// Maximum encoded size of a 64-bit value.
+constexpr size_t kMaxBytes = 10;
+
+/**
+ * @brief Gets the number of bytes encode() writes for @p value.
+ */
+inline size_t encodedSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+/**
+ * @brief Encodes @p value at @p out, which must have room for encodedSize(value) bytes.
+ *
+ * @return size_t The number of bytes written.
+ */
+inline size_t encode(uint64_t value, uint8_t* out) {
+    size_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+/**
+ * @brief Decodes a value from at most @p size bytes at @p in.
+ *
+ * @param in Encoded bytes.
+ * @param size Number of readable bytes at @p in.
+ * @param value Receives the decoded value.
+ * @return size_t The number of bytes consumed, or 0 if the input is truncated
+ *         or longer than kMaxBytes.
+ */
+inline size_t decode(const uint8_t* in, size_t size, uint64_t& value) {
+    uint64_t result = 0;
+    size_t limit = size < kMaxBytes ? size : kMaxBytes;
+    for (size_t i = 0; i < limit; ++i) {
+        result |= static_cast<uint64_t>(in[i] & 0x7F) << (7 * i);
+        if ((in[i] & 0x80) == 0) {
+            value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace Varint
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,145 @@
+#include "BatchCodec.hpp"
+#include "BitCodec.hpp"
+#include "SimdKernels.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+namespace BinaryMessageLibrary {
+
+namespace {
+
+// Number of leading frames whose word window (8 bytes, plus the spill byte for
+// word-crossing fields) lies entirely inside the frame buffer and can therefore
+// be loaded without bounds checks
+size_t countUncheckedFrames(size_t count, size_t stride, size_t frameSize,
+                            size_t byteOffset, size_t window) {
+    if (count == 0) {
+        return 0;
+    }
+    size_t extent = (count - 1) * stride + frameSize;
+    if (extent < byteOffset + window) {
+        return 0;
+    }
+    if (stride == 0) {
+        return count;
+    }
+    return std::min(count, (extent - byteOffset - window) / stride + 1);
+}
+
+} // namespace
+
+BatchCodec::BatchCodec(const MessageConfig& config) : config_(config) {
+    if (config_.getLayout().hasBlocks()) {
+        throw std::runtime_error("Batch codecs do not support array or bytes fields");
+    }
+}
+
+size_t BatchCodec::getFrameSize() const {
+    return config_.getLayout().getTotalBytes();
+}
+
+size_t BatchCodec::getColumnCount() const {
+    return config_.getLayout().size();
+}
+
+void BatchCodec::decode(const uint8_t* frames, size_t count, size_t stride, int64_t* const* columns) const {
+    validateStride(count, stride);
+
+    const auto& layout = config_.getLayout();
+    size_t frameSize = layout.getTotalBytes();
+
+    for (size_t f = 0; f < layout.size(); ++f) {
+        size_t byteOffset = layout.byteOffsets()[f];
+        unsigned shift = layout.shifts()[f];
+        uint64_t mask = layout.masks()[f];
+        unsigned signShift = layout.signShifts()[f];
+        bool crossesWord = layout.crossesWord()[f] != 0;
+        int64_t* column = columns[f];
+
+        // The kernels below read little-endian words; other wire orders go
+        // through the layout's own word paths
+        if (layout.orderFlags()[f] != 0) {
+            decodeOrderedColumn(f, frames, count, stride, column);
+            continue;
+        }
+
+        size_t unchecked = countUncheckedFrames(count, stride, frameSize, byteOffset, crossesWord ? 9 : 8);
+        const uint8_t* base = frames + byteOffset;
+
+        // Keep the word-crossing test out of the inner loops; fields within a
+        // single word go to the vectorized gather kernels
+        if (crossesWord) {
+            unsigned highShift = 64 - shift;
+            for (size_t i = 0; i < unchecked; ++i) {
+                const uint8_t* p = base + i * stride;
+                uint64_t raw = ((BitCodec::loadLE64(p) >> shift) |
+                                (static_cast<uint64_t>(p[8]) << highShift)) & mask;
+                column[i] = static_cast<int64_t>(raw << signShift) >> signShift;
+            }
+        } else {
+            SimdKernels::extractColumn(base, unchecked, stride, shift, mask, signShift, column);
+        }
+
+        // Frames near the end of the buffer take the bounds-checked path
+        for (size_t i = unchecked; i < count; ++i) {
+            column[i] = layout.extract(f, frames + i * stride, frameSize);
+        }
+    }
+}
+
+std::vector<std::vector<int64_t>> BatchCodec::decode(const uint8_t* frames, size_t count, size_t stride) const {
+    std::vector<std::vector<int64_t>> columns(getColumnCount(), std::vector<int64_t>(count));
+    std::vector<int64_t*> pointers;
+    pointers.reserve(columns.size());
+    for (auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+    decode(frames, count, stride, pointers.data());
+    return columns;
+}
+
+void BatchCodec::encode(const int64_t* const* columns, size_t count, uint8_t* frames, size_t stride) const {
+    validateStride(count, stride);
+
+    const auto& layout = config_.getLayout();
+    for (size_t i = 0; i < count; ++i) {
+        layout.pack([columns, i](size_t f) { return columns[f][i]; }, frames + i * stride);
+    }
+}
+
+void BatchCodec::decodeOrderedColumn(size_t field, const uint8_t* frames, size_t count, size_t stride,
+                                     int64_t* column) const {
+    const auto& layout = config_.getLayout();
+    size_t frameSize = layout.getTotalBytes();
+    size_t byteOffset = layout.byteOffsets()[field];
+    unsigned shift = layout.shifts()[field];
+    unsigned width = layout.bitWidths()[field];
+    unsigned signShift = layout.signShifts()[field];
+    size_t unchecked = 0;
+
+    // Plain MSB-first fields within one word: a big-endian load and two shifts
+    if (layout.orderFlags()[field] == MessageLayout::kMsbFirst && layout.crossesWord()[field] == 0) {
+        unchecked = countUncheckedFrames(count, stride, frameSize, byteOffset, 8);
+        const uint8_t* base = frames + byteOffset;
+        for (size_t i = 0; i < unchecked; ++i) {
+            uint64_t raw = (BitCodec::loadBE64(base + i * stride) << shift) >> (64 - width);
+            column[i] = static_cast<int64_t>(raw << signShift) >> signShift;
+        }
+    }
+    for (size_t i = unchecked; i < count; ++i) {
+        column[i] = layout.extract(field, frames + i * stride, frameSize);
+    }
+}
+
+const MessageConfig& BatchCodec::getConfig() const {
+    return config_;
+}
+
+void BatchCodec::validateStride(size_t count, size_t stride) const {
+    if (count > 1 && stride < getFrameSize()) {
+        throw std::runtime_error("Frame stride " + std::to_string(stride) +
+                                 " smaller than frame size " + std::to_string(getFrameSize()));
+    }
+}
+
+} // namespace BinaryMessageLibrary
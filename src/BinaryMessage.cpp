@@ -1,118 +1,230 @@
 #include "BinaryMessage.hpp"
 #include "MessageConfig.hpp"
-#include <stdexcept>
-#include <bitset>
 #include <algorithm>
+#include <stdexcept>
+#include <utility>
 
 namespace BinaryMessageLibrary {
 
 BinaryMessage::BinaryMessage(const MessageConfig& config)
-    : config_(config), field_values_(config.getFields().size(), 0) {}
+    : config_(&config), field_values_(config.getFields().size(), 0),
+      block_data_(config.getLayout().getBlockBytes(), 0) {}
+
+BinaryMessage::BinaryMessage(MessageSchema schema)
+    : schema_(std::move(schema)), config_(schema_.get()) {
+    if (!config_) {
+        throw std::runtime_error("Message schema must not be null");
+    }
+    field_values_.assign(config_->getFields().size(), 0);
+    block_data_.assign(config_->getLayout().getBlockBytes(), 0);
+}
 
 void BinaryMessage::setField(const std::string& name, int64_t value) {
-    validateFieldValue(name, value);
-    size_t index = getFieldOffset(name);
-    field_values_[index] = value;
+    FieldHandle field;
+    try {
+        field = config_->getFieldHandle(name);
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("Invalid field name: " + name);
+    }
+    setField(field, value);
 }
 
 int64_t BinaryMessage::getField(const std::string& name) const {
-    size_t index = getFieldOffset(name);
-    return field_values_[index];
+    return getField(config_->getFieldHandle(name));
 }
 
-std::vector<uint8_t> BinaryMessage::pack() const {
-    size_t total_bits = config_.getTotalBits();
-    size_t total_bytes = (total_bits + 7) / 8;
-    std::vector<uint8_t> buffer(total_bytes, 0);
-
-    size_t current_bit = 0;
-    for (size_t i = 0; i < config_.getFields().size(); ++i) {
-        const auto& field = config_.getFields()[i];
-        int64_t value = field_values_[i];
-        
-        // Handle signed values
-        if (field.is_signed()) {
-            uint64_t mask = (1ULL << field.bit_width()) - 1;
-            value &= mask;
-        }
+void BinaryMessage::setField(FieldHandle field, int64_t value) {
+    size_t index = getScalarOffset(field);
+    validateFieldValue(index, value);
+    field_values_[index] = value;
+}
+
+int64_t BinaryMessage::getField(FieldHandle field) const {
+    return field_values_[getScalarOffset(field)];
+}
 
-        // Pack bits into buffer
-        for (size_t bit = 0; bit < field.bit_width(); ++bit) {
-            size_t byte_index = (current_bit + bit) / 8;
-            size_t bit_index = (current_bit + bit) % 8;
-            
-            if (value & (1ULL << bit)) {
-                buffer[byte_index] |= (1 << bit_index);
-            }
+void BinaryMessage::setArray(FieldHandle field, const int64_t* values, size_t count) {
+    size_t index = getBlockOffset(field, false);
+    const auto& layout = config_->getLayout();
+    if (count != layout.elementCounts()[index]) {
+        throw std::runtime_error("Field " + config_->getFields()[index].name() + " has " +
+                                 std::to_string(layout.elementCounts()[index]) + " elements, not " +
+                                 std::to_string(count));
+    }
+    // The range is worked out once rather than per element
+    const FieldConfig& fieldConfig = config_->getFields()[index];
+    int64_t minValue = fieldConfig.getMinValue();
+    int64_t maxValue = fieldConfig.getMaxValue();
+    for (size_t e = 0; e < count; ++e) {
+        if (values[e] < minValue || values[e] > maxValue) {
+            validateFieldValue(index, values[e]);
         }
-        
-        current_bit += field.bit_width();
     }
+    layout.depositElements(index, blockData(index), values);
+}
+
+void BinaryMessage::setArray(const std::string& name, const int64_t* values, size_t count) {
+    setArray(config_->getFieldHandle(name), values, count);
+}
+
+void BinaryMessage::getArray(FieldHandle field, int64_t* values, size_t count) const {
+    size_t index = getBlockOffset(field, false);
+    const auto& layout = config_->getLayout();
+    if (count != layout.elementCounts()[index]) {
+        throw std::runtime_error("Field " + config_->getFields()[index].name() + " has " +
+                                 std::to_string(layout.elementCounts()[index]) + " elements, not " +
+                                 std::to_string(count));
+    }
+    layout.extractElements(index, blockData(index), values);
+}
+
+void BinaryMessage::getArray(const std::string& name, int64_t* values, size_t count) const {
+    getArray(config_->getFieldHandle(name), values, count);
+}
+
+void BinaryMessage::setElement(FieldHandle field, size_t element, int64_t value) {
+    size_t index = getBlockOffset(field, false);
+    const auto& layout = config_->getLayout();
+    if (element >= layout.elementCounts()[index]) {
+        throw std::runtime_error("Element " + std::to_string(element) + " out of range for field " +
+                                 config_->getFields()[index].name());
+    }
+    validateFieldValue(index, value);
+    layout.depositElement(index, blockData(index), element, value);
+}
+
+int64_t BinaryMessage::getElement(FieldHandle field, size_t element) const {
+    size_t index = getBlockOffset(field, false);
+    const auto& layout = config_->getLayout();
+    if (element >= layout.elementCounts()[index]) {
+        throw std::runtime_error("Element " + std::to_string(element) + " out of range for field " +
+                                 config_->getFields()[index].name());
+    }
+    return layout.extractElement(index, blockData(index), element);
+}
+
+void BinaryMessage::setBytes(FieldHandle field, const uint8_t* data, size_t size) {
+    size_t index = getBlockOffset(field, true);
+    size_t bytes = config_->getLayout().getBlockSize(index);
+    if (size != bytes) {
+        throw std::runtime_error("Field " + config_->getFields()[index].name() + " has " +
+                                 std::to_string(bytes) + " bytes, not " + std::to_string(size));
+    }
+    // Byte elements are stored as they are on the wire, whatever the bit order
+    std::copy_n(data, size, blockData(index));
+}
+
+void BinaryMessage::setBytes(const std::string& name, const uint8_t* data, size_t size) {
+    setBytes(config_->getFieldHandle(name), data, size);
+}
 
+void BinaryMessage::getBytes(FieldHandle field, uint8_t* data, size_t size) const {
+    size_t index = getBlockOffset(field, true);
+    size_t bytes = config_->getLayout().getBlockSize(index);
+    if (size != bytes) {
+        throw std::runtime_error("Field " + config_->getFields()[index].name() + " has " +
+                                 std::to_string(bytes) + " bytes, not " + std::to_string(size));
+    }
+    std::copy_n(blockData(index), size, data);
+}
+
+void BinaryMessage::getBytes(const std::string& name, uint8_t* data, size_t size) const {
+    getBytes(config_->getFieldHandle(name), data, size);
+}
+
+std::vector<uint8_t> BinaryMessage::pack() const {
+    std::vector<uint8_t> buffer(getPackedSize());
+    packInto(buffer.data(), buffer.size());
     return buffer;
 }
 
 void BinaryMessage::unpack(const std::vector<uint8_t>& buffer) {
-    size_t total_bits = config_.getTotalBits();
-    size_t required_bytes = (total_bits + 7) / 8;
-    
-    if (buffer.size() < required_bytes) {
+    unpackFrom(buffer.data(), buffer.size());
+}
+
+size_t BinaryMessage::getPackedSize() const {
+    return config_->getLayout().getTotalBytes();
+}
+
+size_t BinaryMessage::packInto(uint8_t* buffer, size_t size) const {
+    const auto& layout = config_->getLayout();
+    size_t total_bytes = layout.getTotalBytes();
+
+    if (size < total_bytes) {
         throw std::runtime_error("Buffer too small for message");
     }
 
-    size_t current_bit = 0;
-    for (size_t i = 0; i < config_.getFields().size(); ++i) {
-        const auto& field = config_.getFields()[i];
-        int64_t value = 0;
-
-        // Unpack bits from buffer
-        for (size_t bit = 0; bit < field.bit_width(); ++bit) {
-            size_t byte_index = (current_bit + bit) / 8;
-            size_t bit_index = (current_bit + bit) % 8;
-            
-            if (buffer[byte_index] & (1 << bit_index)) {
-                value |= (1ULL << bit);
-            }
-        }
+    layout.pack([this](size_t i) { return field_values_[i]; },
+                [this](size_t i) { return blockData(i); }, buffer);
 
-        // Handle signed values
-        if (field.is_signed() && (value & (1ULL << (field.bit_width() - 1)))) {
-            value |= ~((1ULL << field.bit_width()) - 1);
-        }
+    return total_bytes;
+}
 
-        field_values_[i] = value;
-        current_bit += field.bit_width();
+size_t BinaryMessage::unpackFrom(const uint8_t* buffer, size_t size) {
+    const auto& layout = config_->getLayout();
+    size_t total_bytes = layout.getTotalBytes();
+    
+    if (size < total_bytes) {
+        throw std::runtime_error("Buffer too small for message");
     }
+
+    config_->getUnpackProgram().run(layout, buffer, size, field_values_.data(), block_data_.data());
+
+    return total_bytes;
+}
+
+void BinaryMessage::reset() {
+    std::fill(field_values_.begin(), field_values_.end(), 0);
+    std::fill(block_data_.begin(), block_data_.end(), 0);
 }
 
 const MessageConfig& BinaryMessage::getConfig() const {
-    return config_;
+    return *config_;
 }
 
-size_t BinaryMessage::getFieldOffset(const std::string& name) const {
-    const auto& fields = config_.getFields();
-    auto it = std::find_if(fields.begin(), fields.end(),
-        [&name](const FieldConfig& field) { return field.name() == name; });
-    
-    if (it == fields.end()) {
-        throw std::runtime_error("Field not found: " + name);
+const MessageSchema& BinaryMessage::getSchema() const {
+    return schema_;
+}
+
+size_t BinaryMessage::getFieldOffset(FieldHandle field) const {
+    if (field.index() >= field_values_.size()) {
+        throw std::runtime_error("Invalid field handle");
     }
-    
-    return std::distance(fields.begin(), it);
+    return field.index();
 }
 
-void BinaryMessage::validateFieldName(const std::string& name) const {
-    if (!config_.hasField(name)) {
-        throw std::runtime_error("Invalid field name: " + name);
+size_t BinaryMessage::getScalarOffset(FieldHandle field) const {
+    size_t index = getFieldOffset(field);
+    if (!config_->getLayout().isScalar(index)) {
+        throw std::runtime_error("Field " + config_->getFields()[index].name() +
+                                 " is not a scalar; use the array or bytes accessors");
+    }
+    return index;
+}
+
+size_t BinaryMessage::getBlockOffset(FieldHandle field, bool bytesOnly) const {
+    size_t index = getFieldOffset(field);
+    FieldKind kind = config_->getFields()[index].getKind();
+    if (kind == FieldKind::Scalar || (bytesOnly && kind != FieldKind::Bytes)) {
+        throw std::runtime_error("Field " + config_->getFields()[index].name() +
+                                 (bytesOnly ? " is not a bytes field" : " is not an array or bytes field"));
     }
+    return index;
+}
+
+uint8_t* BinaryMessage::blockData(size_t index) {
+    return block_data_.data() + config_->getLayout().blockOffsets()[index];
+}
+
+const uint8_t* BinaryMessage::blockData(size_t index) const {
+    return block_data_.data() + config_->getLayout().blockOffsets()[index];
 }
 
-void BinaryMessage::validateFieldValue(const std::string& name, int64_t value) const {
-    validateFieldName(name);
-    const auto& field = config_.getFieldConfig(name);
+void BinaryMessage::validateFieldValue(size_t index, int64_t value) const {
+    const auto& field = config_->getFields()[index];
     if (!field.isValidValue(value)) {
         throw std::runtime_error("Value " + std::to_string(value) + 
-                               " out of range for field " + name);
+                               " out of range for field " + field.name());
     }
 }
 
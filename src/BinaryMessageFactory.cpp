@@ -1,60 +1,302 @@
 #include "BinaryMessageFactory.hpp"
+#include "MappedFile.hpp"
+#include "SchemaRegistry.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
 #include <stdexcept>
+#include <thread>
 #include <unordered_set>
+#include <utility>
 
 namespace BinaryMessageLibrary {
 
+struct BinaryMessageFactory::TypeTable {
+    std::unordered_map<std::string, MessageSchema> schemas;
+    std::unordered_map<std::string, std::shared_ptr<MessagePool>> pools;
+
+    const MessageSchema& schema(const std::string& messageType) const {
+        auto it = schemas.find(messageType);
+        if (it == schemas.end()) {
+            throw std::runtime_error("Message type '" + messageType + "' not found in configuration");
+        }
+        return it->second;
+    }
+};
+
+namespace {
+
+// Threads are numbered round robin the first time they read any factory, which
+// spreads them evenly over the reader counter shards
+size_t readerSlot() {
+    static std::atomic<size_t> next_slot{0};
+    thread_local size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+// A retired pool can go once nothing but the retired list refers to it and
+// none of its messages is handed out
+bool isIdle(const std::shared_ptr<MessagePool>& pool) {
+    return pool.use_count() == 1 && pool->getAvailable() == pool->getCapacity();
+}
+
+} // namespace
+
+class BinaryMessageFactory::ReadSection {
+public:
+    explicit ReadSection(const BinaryMessageFactory& factory)
+        : count_(factory.readerCounts[factory.readEpoch.load() & 1][readerSlot() % kReaderShards].value) {
+        // Announce the reader before loading the table, so a writer that swaps
+        // the table afterwards is guaranteed to wait for us
+        count_.fetch_add(1);
+        table_ = factory.typeTable.load();
+    }
+
+    ~ReadSection() {
+        count_.fetch_sub(1, std::memory_order_release);
+    }
+
+    ReadSection(const ReadSection&) = delete;
+    ReadSection& operator=(const ReadSection&) = delete;
+
+    const TypeTable& table() const {
+        return *table_;
+    }
+
+private:
+    std::atomic<uint64_t>& count_;
+    const TypeTable* table_;
+};
+
 BinaryMessageFactory::BinaryMessageFactory(const nlohmann::json& config) {
     loadConfigurations(config);
 }
 
+BinaryMessageFactory::BinaryMessageFactory() {
+    publish(SchemaSnapshot::TypeList());
+}
+
+BinaryMessageFactory::~BinaryMessageFactory() {
+    delete typeTable.load();
+}
+
 std::unique_ptr<BinaryMessage> BinaryMessageFactory::createMessage(const std::string& messageType) const {
-    if (!hasMessageType(messageType)) {
+    return std::make_unique<BinaryMessage>(getSchema(messageType));
+}
+
+PooledMessage BinaryMessageFactory::acquire(const std::string& messageType) const {
+    // Acquire inside the read section, so a reload cannot release the pool first
+    ReadSection read(*this);
+    const auto& pools = read.table().pools;
+    auto it = pools.find(messageType);
+    if (it == pools.end()) {
         throw std::runtime_error("Message type '" + messageType + "' not found in configuration");
     }
-    return std::make_unique<BinaryMessage>(getMessageConfig(messageType));
+    return it->second->acquire();
 }
 
-const MessageConfig& BinaryMessageFactory::getMessageConfig(const std::string& messageType) const {
-    auto it = messageConfigs.find(messageType);
-    if (it == messageConfigs.end()) {
+MessagePool& BinaryMessageFactory::getMessagePool(const std::string& messageType) const {
+    ReadSection read(*this);
+    const auto& pools = read.table().pools;
+    auto it = pools.find(messageType);
+    if (it == pools.end()) {
         throw std::runtime_error("Message type '" + messageType + "' not found in configuration");
     }
-    return it->second;
+    return *it->second;
+}
+
+const MessageConfig& BinaryMessageFactory::getMessageConfig(const std::string& messageType) const {
+    ReadSection read(*this);
+    return *read.table().schema(messageType);
+}
+
+MessageSchema BinaryMessageFactory::getSchema(const std::string& messageType) const {
+    ReadSection read(*this);
+    return read.table().schema(messageType);
 }
 
 bool BinaryMessageFactory::hasMessageType(const std::string& messageType) const {
-    return messageConfigs.find(messageType) != messageConfigs.end();
+    ReadSection read(*this);
+    return read.table().schemas.count(messageType) != 0;
 }
 
 std::vector<std::string> BinaryMessageFactory::getMessageTypes() const {
+    ReadSection read(*this);
+    const auto& schemas = read.table().schemas;
     std::vector<std::string> types;
-    types.reserve(messageConfigs.size());
-    for (const auto& pair : messageConfigs) {
+    types.reserve(schemas.size());
+    for (const auto& pair : schemas) {
         types.push_back(pair.first);
     }
     return types;
 }
 
 void BinaryMessageFactory::loadConfigurations(const nlohmann::json& config) {
+    publish(buildTypes(config));
+}
+
+bool BinaryMessageFactory::loadConfigurationFile(const std::string& path, const std::string& snapshotPath) {
+    MappedFile source(path, AccessPattern::Sequential);
+    uint64_t sourceChecksum = SchemaSnapshot::checksum(source.data(), source.size());
+
+    if (!snapshotPath.empty()) {
+        try {
+            MappedFile snapshot(snapshotPath, AccessPattern::Sequential);
+            if (loadSnapshot(snapshot.data(), snapshot.size(), sourceChecksum)) {
+                return true;
+            }
+        } catch (const std::runtime_error&) {
+            // A missing or unreadable snapshot is rebuilt from the JSON below
+        }
+    }
+
+    nlohmann::json config;
+    try {
+        const char* text = reinterpret_cast<const char*>(source.data());
+        config = nlohmann::json::parse(text, text + source.size());
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Invalid configuration file " + path + ": " + e.what());
+    }
+    SchemaSnapshot::TypeList types = buildTypes(config);
+
+    if (!snapshotPath.empty()) {
+        std::vector<uint8_t> snapshot;
+        SchemaSnapshot::encode(snapshot, types, sourceChecksum);
+        writeSnapshotFile(snapshotPath, snapshot);
+    }
+
+    publish(std::move(types));
+    return false;
+}
+
+bool BinaryMessageFactory::loadSnapshot(const uint8_t* data, size_t size, uint64_t sourceChecksum) {
+    SchemaSnapshot::TypeList types;
+    if (!SchemaSnapshot::decode(data, size, sourceChecksum, types)) {
+        return false;
+    }
+    publish(std::move(types));
+    return true;
+}
+
+void BinaryMessageFactory::writeSnapshot(std::vector<uint8_t>& out, uint64_t sourceChecksum) const {
+    ReadSection read(*this);
+    SchemaSnapshot::TypeList types(read.table().schemas.begin(), read.table().schemas.end());
+    SchemaSnapshot::encode(out, types, sourceChecksum);
+}
+
+void BinaryMessageFactory::writeSnapshotFile(const std::string& snapshotPath, const std::vector<uint8_t>& snapshot) {
+    // A temporary name of its own, so concurrent starts never write the same file
+    std::random_device random;
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%08x%08x.tmp", random(), random());
+    std::filesystem::path temporary(snapshotPath + suffix);
+
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(snapshot.data()), static_cast<std::streamsize>(snapshot.size()));
+    out.close();
+    // std::filesystem::rename replaces an existing snapshot on every platform,
+    // unlike std::rename with the Windows CRT
+    std::error_code error;
+    if (out) {
+        std::filesystem::rename(temporary, std::filesystem::path(snapshotPath), error);
+    }
+    if (!out || error) {
+        std::filesystem::remove(temporary, error);
+    }
+}
+
+SchemaSnapshot::TypeList BinaryMessageFactory::buildTypes(const nlohmann::json& config) {
     if (!config.is_object()) {
         throw std::runtime_error("Configuration must be a JSON object");
     }
 
+    SchemaSnapshot::TypeList types;
+    types.reserve(config.size());
     for (const auto& [messageType, messageDef] : config.items()) {
         validateMessageDefinition(messageType, messageDef);
-        messageConfigs[messageType] = MessageConfig(messageDef);
+        types.emplace_back(messageType, SchemaRegistry::global().intern(messageDef));
+    }
+    return types;
+}
+
+void BinaryMessageFactory::publish(SchemaSnapshot::TypeList types) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    const TypeTable* current = typeTable.load();
+
+    auto table = std::make_unique<TypeTable>();
+    for (auto& [messageType, schema] : types) {
+        // Unchanged types keep their pool, and with it any idle messages
+        std::shared_ptr<MessagePool> pool;
+        if (current != nullptr) {
+            auto it = current->pools.find(messageType);
+            if (it != current->pools.end() && current->schemas.at(messageType) == schema) {
+                pool = it->second;
+            }
+        }
+        if (!pool) {
+            // Reloads that flip between definitions get their earlier pool back
+            auto retired = retiredPools.find(schema.get());
+            if (retired != retiredPools.end()) {
+                pool = std::move(retired->second);
+                retiredPools.erase(retired);
+            } else {
+                pool = std::make_shared<MessagePool>(schema);
+            }
+        }
+        table->schemas.emplace(messageType, std::move(schema));
+        table->pools.emplace(std::move(messageType), std::move(pool));
+    }
+
+    typeTable.store(table.release());
+    if (current == nullptr) {
+        return;
+    }
+
+    waitForReaders();
+    // Pools retired by earlier reloads are released once all their messages
+    // are back; no reader can reach them any more
+    for (auto it = retiredPools.begin(); it != retiredPools.end();) {
+        it = isIdle(it->second) ? retiredPools.erase(it) : std::next(it);
+    }
+    // Pools of replaced types may still have messages handed out, and each
+    // holds its schema, so keep them (and references into them) valid for now
+    for (const auto& [messageType, pool] : current->pools) {
+        if (pool.use_count() == 1) {
+            retiredPools.emplace(&pool->getConfig(), pool);
+        }
+    }
+    delete current;
+}
+
+void BinaryMessageFactory::waitForReaders() {
+    // Flip the epoch twice, each time waiting for the counter new readers no
+    // longer use to drain. Any reader that loaded the old table incremented one
+    // of the two counters before the swap, so it has finished afterwards.
+    for (int round = 0; round < 2; ++round) {
+        uint64_t epoch = readEpoch.fetch_add(1);
+        for (auto& shard : readerCounts[epoch & 1]) {
+            while (shard.value.load() != 0) {
+                std::this_thread::yield();
+            }
+        }
     }
 }
 
 void BinaryMessageFactory::validateMessageDefinition(const std::string& messageType, const nlohmann::json& messageDef) {
-    if (!messageDef.is_array()) {
+    // Either a field array or an object holding one next to the wire order
+    const nlohmann::json* fieldList = &messageDef;
+    if (messageDef.is_object() && messageDef.contains("fields")) {
+        fieldList = &messageDef["fields"];
+    }
+    if (!fieldList->is_array()) {
         throw std::runtime_error("Message definition for '" + messageType + "' must be an array");
     }
 
     // Check for duplicate field names
     std::unordered_set<std::string> fieldNames;
-    for (const auto& field : messageDef) {
+    for (const auto& field : *fieldList) {
         if (!field.is_object()) {
             throw std::runtime_error("Field definition in message '" + messageType + "' must be an object");
         }
@@ -63,12 +305,23 @@ void BinaryMessageFactory::validateMessageDefinition(const std::string& messageT
             throw std::runtime_error("Field in message '" + messageType + "' must have a string 'name'");
         }
 
-        if (!field.contains("bit_width") || !field["bit_width"].is_number_unsigned()) {
-            throw std::runtime_error("Field in message '" + messageType + "' must have an unsigned 'bit_width'");
+        // Byte blobs are sized by "bytes" alone; everything else needs a width and signedness
+        if (field.contains("bytes")) {
+            if (!field["bytes"].is_number_unsigned()) {
+                throw std::runtime_error("Field in message '" + messageType + "' must have an unsigned 'bytes'");
+            }
+        } else {
+            if (!field.contains("bit_width") || !field["bit_width"].is_number_unsigned()) {
+                throw std::runtime_error("Field in message '" + messageType + "' must have an unsigned 'bit_width'");
+            }
+
+            if (!field.contains("signed") || !field["signed"].is_boolean()) {
+                throw std::runtime_error("Field in message '" + messageType + "' must have a boolean 'signed'");
+            }
         }
 
-        if (!field.contains("signed") || !field["signed"].is_boolean()) {
-            throw std::runtime_error("Field in message '" + messageType + "' must have a boolean 'signed'");
+        if (field.contains("count") && !field["count"].is_number_unsigned()) {
+            throw std::runtime_error("Field in message '" + messageType + "' must have an unsigned 'count'");
         }
 
         std::string fieldName = field["name"];
@@ -0,0 +1,70 @@
+#include "CaptureReader.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace BinaryMessageLibrary {
+
+CaptureReader::CaptureReader(const std::string& path, const MessageConfig& config, AccessPattern pattern)
+    : file_(path, pattern),
+      config_(config),
+      frame_size_(config.getLayout().getTotalBytes()),
+      frame_count_(0) {
+    if (frame_size_ == 0) {
+        throw std::runtime_error("Cannot read a capture of empty frames");
+    }
+    frame_count_ = file_.size() / frame_size_;
+}
+
+size_t CaptureReader::getFrameCount() const {
+    return frame_count_;
+}
+
+size_t CaptureReader::getFrameSize() const {
+    return frame_size_;
+}
+
+size_t CaptureReader::getTrailingBytes() const {
+    return file_.size() - frame_count_ * frame_size_;
+}
+
+FrameView CaptureReader::frame(size_t index) const {
+    if (index >= frame_count_) {
+        throw std::runtime_error("Frame index " + std::to_string(index) + " out of range");
+    }
+    return FrameView{file_.data() + index * frame_size_, frame_size_};
+}
+
+void CaptureReader::unpack(size_t index, BinaryMessage& message) const {
+    FrameView view = frame(index);
+    message.unpackFrom(view.data, view.size);
+}
+
+MessageView CaptureReader::view(size_t index) const {
+    return MessageView(config_, frame(index));
+}
+
+CaptureReader::Iterator CaptureReader::begin() const {
+    return Iterator(file_.data(), frame_size_);
+}
+
+CaptureReader::Iterator CaptureReader::end() const {
+    return Iterator(file_.data() + frame_count_ * frame_size_, frame_size_);
+}
+
+const uint8_t* CaptureReader::data() const {
+    return file_.data();
+}
+
+size_t CaptureReader::size() const {
+    return file_.size();
+}
+
+void CaptureReader::advise(AccessPattern pattern) const {
+    file_.advise(pattern);
+}
+
+const MessageConfig& CaptureReader::getConfig() const {
+    return config_;
+}
+
+} // namespace BinaryMessageLibrary
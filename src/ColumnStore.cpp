@@ -0,0 +1,440 @@
+#include "ColumnStore.hpp"
+#include "BitCodec.hpp"
+#include "ByteIO.hpp"
+#include "SchemaEncoding.hpp"
+#include "SchemaRegistry.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace BinaryMessageLibrary {
+
+namespace {
+
+const uint8_t kHeaderMagic[4] = {'B', 'M', 'C', 'S'};
+const uint8_t kTrailerMagic[4] = {'B', 'M', 'C', 'X'};
+constexpr size_t kHeaderSize = 4 + 1;
+constexpr size_t kTrailerSize = 8 + 4;
+
+[[noreturn]] void malformed(const std::string& what) {
+    throw std::runtime_error("Malformed column store: " + what);
+}
+
+unsigned bitsNeeded(uint64_t value) {
+    unsigned bits = 0;
+    while (value != 0) {
+        ++bits;
+        value >>= 1;
+    }
+    return bits;
+}
+
+uint64_t zigzag(uint64_t delta) {
+    return (delta << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+}
+
+uint64_t unzigzag(uint64_t value) {
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+uint64_t chunkBytes(uint64_t rowCount, unsigned width) {
+    return (rowCount * width + 7) / 8;
+}
+
+// Packs valueAt(0) .. valueAt(count - 1) LSB-first at @p width bits each
+template <typename ValueAt>
+void packChunk(size_t count, unsigned width, ValueAt valueAt, std::vector<uint8_t>& out) {
+    out.assign(static_cast<size_t>(chunkBytes(count, width)), 0);
+    if (width != 0) {
+        BitCodec::packRun(count, width, valueAt, out.data());
+    }
+}
+
+// Calls emit(i, value) for each of the @p count values packed at @p width bits
+template <typename Emit>
+void unpackChunk(const uint8_t* data, size_t size, size_t count, unsigned width, Emit emit) {
+    if (width == 0) {
+        for (size_t i = 0; i < count; ++i) {
+            emit(i, 0);
+        }
+        return;
+    }
+    BitCodec::unpackRun(data, size, count, width, emit);
+}
+
+} // namespace
+
+using namespace ByteIO;
+
+ColumnStoreWriter::ColumnStoreWriter(std::ostream& out, const MessageConfig& config,
+                                     size_t blockRows, ColumnEncoding encoding)
+    : out_(out), config_(config), codec_(config), block_rows_(blockRows), encoding_(encoding) {
+    if (block_rows_ == 0) {
+        throw std::runtime_error("A column store block must hold at least one row");
+    }
+    size_t fieldCount = config_.getFields().size();
+    columns_.assign(fieldCount, std::vector<int64_t>(block_rows_));
+    column_pointers_.resize(fieldCount);
+
+    std::vector<uint8_t> header(kHeaderMagic, kHeaderMagic + 4);
+    header.push_back(ColumnStore::kVersion);
+    emit(header.data(), header.size());
+}
+
+ColumnStoreWriter::~ColumnStoreWriter() {
+    if (!finished_) {
+        try {
+            finish();
+        } catch (...) {
+        }
+    }
+}
+
+void ColumnStoreWriter::append(const int64_t* const* columns, size_t count) {
+    checkOpen();
+    const auto& fields = config_.getFields();
+    size_t done = 0;
+    while (done < count) {
+        size_t rows = std::min(count - done, block_rows_ - buffered_);
+        for (size_t f = 0; f < fields.size(); ++f) {
+            unsigned width = fields[f].bit_width();
+            uint64_t mask = BitCodec::lowMask(width);
+            unsigned signShift = fields[f].is_signed() ? 64 - width : 0;
+            const int64_t* in = columns[f] + done;
+            int64_t* column = columns_[f].data() + buffered_;
+            for (size_t i = 0; i < rows; ++i) {
+                uint64_t raw = static_cast<uint64_t>(in[i]) & mask;
+                column[i] = static_cast<int64_t>(raw << signShift) >> signShift;
+            }
+        }
+        buffered_ += rows;
+        done += rows;
+        if (buffered_ == block_rows_) {
+            flush();
+        }
+    }
+}
+
+void ColumnStoreWriter::appendFrames(const uint8_t* frames, size_t count, size_t stride) {
+    checkOpen();
+    size_t done = 0;
+    while (done < count) {
+        size_t rows = std::min(count - done, block_rows_ - buffered_);
+        for (size_t f = 0; f < columns_.size(); ++f) {
+            column_pointers_[f] = columns_[f].data() + buffered_;
+        }
+        codec_.decode(frames + done * stride, rows, stride, column_pointers_.data());
+        buffered_ += rows;
+        done += rows;
+        if (buffered_ == block_rows_) {
+            flush();
+        }
+    }
+}
+
+void ColumnStoreWriter::flush() {
+    if (buffered_ == 0) {
+        return;
+    }
+    const auto& fields = config_.getFields();
+    BlockEntry entry{offset_, buffered_, {}, {}};
+    size_t rows = buffered_;
+
+    for (size_t f = 0; f < fields.size(); ++f) {
+        const int64_t* values = columns_[f].data();
+        unsigned width = fields[f].bit_width();
+        bool isSigned = fields[f].is_signed();
+
+        auto less = [isSigned](int64_t a, int64_t b) {
+            return isSigned ? a < b : static_cast<uint64_t>(a) < static_cast<uint64_t>(b);
+        };
+        int64_t min = values[0];
+        int64_t max = values[0];
+        uint64_t maxDelta = 0;
+        for (size_t i = 1; i < rows; ++i) {
+            if (less(values[i], min)) {
+                min = values[i];
+            }
+            if (less(max, values[i])) {
+                max = values[i];
+            }
+            maxDelta |= zigzag(static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]));
+        }
+
+        // OR-ing the zigzag deltas gives the width of the largest one
+        unsigned referenceWidth = bitsNeeded(static_cast<uint64_t>(max) - static_cast<uint64_t>(min));
+        unsigned deltaWidth = bitsNeeded(maxDelta);
+
+        ColumnEncoding encoding = encoding_;
+        if (encoding == ColumnEncoding::Auto) {
+            encoding = ColumnEncoding::Plain;
+            if (referenceWidth < width) {
+                encoding = ColumnEncoding::FrameOfReference;
+            }
+            if (deltaWidth < std::min(referenceWidth, width)) {
+                encoding = ColumnEncoding::Delta;
+            }
+        }
+
+        unsigned packedWidth = width;
+        uint64_t reference = 0;
+        switch (encoding) {
+        case ColumnEncoding::FrameOfReference:
+            packedWidth = referenceWidth;
+            reference = static_cast<uint64_t>(min);
+            packChunk(rows, packedWidth,
+                      [&](size_t i) { return static_cast<uint64_t>(values[i]) - reference; }, chunk_);
+            break;
+        case ColumnEncoding::Delta:
+            packedWidth = deltaWidth;
+            reference = static_cast<uint64_t>(values[0]);
+            packChunk(rows, packedWidth, [&](size_t i) {
+                return i == 0 ? 0 : zigzag(static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]));
+            }, chunk_);
+            break;
+        default:
+            packChunk(rows, packedWidth, [&](size_t i) { return static_cast<uint64_t>(values[i]); }, chunk_);
+            break;
+        }
+
+        emit(chunk_.data(), chunk_.size());
+        entry.chunks.push_back(ColumnStats{rows, min, max, encoding, packedWidth, chunk_.size()});
+        entry.references.push_back(reference);
+    }
+
+    blocks_.push_back(std::move(entry));
+    row_count_ += rows;
+    buffered_ = 0;
+}
+
+void ColumnStoreWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    flush();
+    finished_ = true;
+
+    std::vector<uint8_t> footer;
+    SchemaEncoding::encode(footer, config_);
+    putVarint(footer, blocks_.size());
+    for (const auto& block : blocks_) {
+        putU64(footer, block.offset);
+        putVarint(footer, block.rowCount);
+        for (size_t c = 0; c < block.chunks.size(); ++c) {
+            const ColumnStats& stats = block.chunks[c];
+            putU8(footer, static_cast<uint8_t>(stats.encoding));
+            putU8(footer, static_cast<uint8_t>(stats.packedWidth));
+            putU64(footer, block.references[c]);
+            putU64(footer, static_cast<uint64_t>(stats.min));
+            putU64(footer, static_cast<uint64_t>(stats.max));
+            putVarint(footer, stats.byteSize);
+        }
+    }
+    putU64(footer, offset_);
+    footer.insert(footer.end(), kTrailerMagic, kTrailerMagic + 4);
+    emit(footer.data(), footer.size());
+    out_.flush();
+}
+
+uint64_t ColumnStoreWriter::getRowCount() const {
+    return row_count_ + buffered_;
+}
+
+void ColumnStoreWriter::emit(const uint8_t* data, size_t size) {
+    out_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!out_) {
+        throw std::runtime_error("Failed to write column store");
+    }
+    offset_ += size;
+}
+
+void ColumnStoreWriter::checkOpen() const {
+    if (finished_) {
+        throw std::runtime_error("Column store has already been finished");
+    }
+}
+
+ColumnStoreReader::ColumnStoreReader(const uint8_t* data, size_t size) : data_(data), size_(size) {
+    open();
+}
+
+ColumnStoreReader::ColumnStoreReader(const std::string& path)
+    : file_(path), data_(file_.data()), size_(file_.size()) {
+    open();
+}
+
+const MessageSchema& ColumnStoreReader::getSchema() const {
+    return schema_;
+}
+
+uint64_t ColumnStoreReader::getRowCount() const {
+    return row_count_;
+}
+
+size_t ColumnStoreReader::getBlockCount() const {
+    return blocks_.size();
+}
+
+uint64_t ColumnStoreReader::getBlockRowCount(size_t block) const {
+    if (block >= blocks_.size()) {
+        throw std::runtime_error("Block " + std::to_string(block) + " out of range");
+    }
+    return blocks_[block].rowCount;
+}
+
+size_t ColumnStoreReader::getColumnCount() const {
+    return schema_->getFields().size();
+}
+
+size_t ColumnStoreReader::getColumnIndex(const std::string& fieldName) const {
+    auto it = column_ids_.find(fieldName);
+    if (it == column_ids_.end()) {
+        throw std::runtime_error("Field '" + fieldName + "' not found in column store");
+    }
+    return it->second;
+}
+
+const ColumnStats& ColumnStoreReader::getStats(size_t block, size_t column) const {
+    checkChunk(block, column);
+    return blocks_[block].chunks[column];
+}
+
+FrameView ColumnStoreReader::getChunk(size_t block, size_t column) const {
+    checkChunk(block, column);
+    const BlockEntry& entry = blocks_[block];
+    return FrameView{data_ + entry.chunkOffsets[column], static_cast<size_t>(entry.chunks[column].byteSize)};
+}
+
+size_t ColumnStoreReader::readColumn(size_t column, size_t block, int64_t* out) const {
+    FrameView chunk = getChunk(block, column);
+    const BlockEntry& entry = blocks_[block];
+    const ColumnStats& stats = entry.chunks[column];
+    uint64_t reference = entry.references[column];
+    auto rows = static_cast<size_t>(entry.rowCount);
+
+    switch (stats.encoding) {
+    case ColumnEncoding::FrameOfReference:
+        unpackChunk(chunk.data, chunk.size, rows, stats.packedWidth, [&](size_t i, uint64_t value) {
+            out[i] = static_cast<int64_t>(reference + value);
+        });
+        break;
+    case ColumnEncoding::Delta: {
+        uint64_t current = reference;
+        unpackChunk(chunk.data, chunk.size, rows, stats.packedWidth, [&](size_t i, uint64_t value) {
+            current += unzigzag(value);
+            out[i] = static_cast<int64_t>(current);
+        });
+        break;
+    }
+    default: {
+        const FieldConfig& field = schema_->getFields()[column];
+        unsigned signShift = field.is_signed() ? 64 - field.bit_width() : 0;
+        unpackChunk(chunk.data, chunk.size, rows, stats.packedWidth, [&](size_t i, uint64_t value) {
+            out[i] = static_cast<int64_t>(value << signShift) >> signShift;
+        });
+        break;
+    }
+    }
+    return rows;
+}
+
+std::vector<int64_t> ColumnStoreReader::readColumn(size_t column) const {
+    if (column >= getColumnCount()) {
+        throw std::runtime_error("Column " + std::to_string(column) + " out of range");
+    }
+    std::vector<int64_t> values(static_cast<size_t>(row_count_));
+    size_t position = 0;
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        position += readColumn(column, b, values.data() + position);
+    }
+    return values;
+}
+
+std::vector<size_t> ColumnStoreReader::findBlocks(size_t column, int64_t lo, int64_t hi) const {
+    if (column >= getColumnCount()) {
+        throw std::runtime_error("Column " + std::to_string(column) + " out of range");
+    }
+    bool isSigned = schema_->getFields()[column].is_signed();
+    std::vector<size_t> matches;
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        const ColumnStats& stats = blocks_[b].chunks[column];
+        bool overlaps = isSigned
+            ? stats.max >= lo && stats.min <= hi
+            : static_cast<uint64_t>(stats.max) >= static_cast<uint64_t>(lo) &&
+              static_cast<uint64_t>(stats.min) <= static_cast<uint64_t>(hi);
+        if (overlaps) {
+            matches.push_back(b);
+        }
+    }
+    return matches;
+}
+
+void ColumnStoreReader::open() {
+    if (size_ < kHeaderSize || std::memcmp(data_, kHeaderMagic, 4) != 0) {
+        malformed("bad magic");
+    }
+    if (data_[4] != ColumnStore::kVersion) {
+        throw std::runtime_error("Unsupported column store version " + std::to_string(data_[4]));
+    }
+    if (size_ - kHeaderSize < kTrailerSize || std::memcmp(data_ + size_ - 4, kTrailerMagic, 4) != 0) {
+        malformed("missing trailer (store not finished?)");
+    }
+    uint64_t footerOffset = getU64(data_ + size_ - kTrailerSize);
+    if (footerOffset < kHeaderSize || footerOffset > size_ - kTrailerSize) {
+        malformed("footer offset out of range");
+    }
+
+    Reader footer(data_, static_cast<size_t>(footerOffset), size_ - kTrailerSize, "column store");
+    schema_ = SchemaRegistry::global().intern(SchemaEncoding::decode(footer));
+    const auto& fields = schema_->getFields();
+    for (size_t f = 0; f < fields.size(); ++f) {
+        column_ids_.emplace(fields[f].name(), f);
+    }
+
+    uint64_t blockCount = footer.varint("block count");
+    uint64_t expectedOffset = kHeaderSize;
+    for (uint64_t b = 0; b < blockCount; ++b) {
+        BlockEntry block;
+        block.offset = footer.u64("block offset");
+        block.rowCount = footer.varint("block row count");
+        if (block.offset != expectedOffset || block.rowCount == 0 ||
+            block.rowCount > (std::numeric_limits<uint64_t>::max() - 7) / 64) {
+            malformed("bad block entry");
+        }
+        uint64_t position = block.offset;
+        for (size_t f = 0; f < fields.size(); ++f) {
+            uint8_t encoding = footer.u8("chunk encoding");
+            unsigned packedWidth = footer.u8("chunk width");
+            uint64_t reference = footer.u64("chunk reference");
+            auto min = static_cast<int64_t>(footer.u64("chunk min"));
+            auto max = static_cast<int64_t>(footer.u64("chunk max"));
+            uint64_t byteSize = footer.varint("chunk size");
+            if (encoding > static_cast<uint8_t>(ColumnEncoding::Delta) || packedWidth > 64 ||
+                (encoding == static_cast<uint8_t>(ColumnEncoding::Plain) && packedWidth != fields[f].bit_width()) ||
+                byteSize != chunkBytes(block.rowCount, packedWidth) || byteSize > footerOffset - position) {
+                malformed("bad chunk entry");
+            }
+            block.chunks.push_back(ColumnStats{block.rowCount, min, max, static_cast<ColumnEncoding>(encoding),
+                                               packedWidth, byteSize});
+            block.references.push_back(reference);
+            block.chunkOffsets.push_back(position);
+            position += byteSize;
+        }
+        expectedOffset = position;
+        row_count_ += block.rowCount;
+        blocks_.push_back(std::move(block));
+    }
+}
+
+void ColumnStoreReader::checkChunk(size_t block, size_t column) const {
+    if (block >= blocks_.size()) {
+        throw std::runtime_error("Block " + std::to_string(block) + " out of range");
+    }
+    if (column >= getColumnCount()) {
+        throw std::runtime_error("Column " + std::to_string(column) + " out of range");
+    }
+}
+
+} // namespace BinaryMessageLibrary
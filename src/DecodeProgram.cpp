@@ -0,0 +1,239 @@
+#include "DecodeProgram.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace BinaryMessageLibrary {
+
+namespace {
+
+const char* const kScalarKeys[] = {"name", "bit_width", "signed", "present_if"};
+const char* const kGroupKeys[] = {"name", "fields", "count_field", "present_if"};
+
+template <size_t N>
+void checkKeys(const nlohmann::json& field, const char* const (&allowed)[N], const std::string& name) {
+    for (const auto& item : field.items()) {
+        if (std::find_if(allowed, allowed + N, [&](const char* key) { return item.key() == key; }) ==
+            allowed + N) {
+            throw std::runtime_error("Field '" + name + "' uses '" + item.key() +
+                                     "', which decode programs do not support");
+        }
+    }
+}
+
+} // namespace
+
+DecodeProgram::DecodeProgram(const nlohmann::json& definition)
+    : bit_order_(BitOrder::LsbFirst), max_depth_(0), open_run_(SIZE_MAX) {
+    const nlohmann::json* fieldList = &definition;
+    if (definition.is_object()) {
+        if (!definition.contains("fields")) {
+            throw std::runtime_error("Configuration object missing required 'fields' array");
+        }
+        for (const auto& item : definition.items()) {
+            if (item.key() != "fields" && item.key() != "bit_order") {
+                throw std::runtime_error("Decode programs do not support '" + item.key() + "'");
+            }
+        }
+        fieldList = &definition["fields"];
+        if (definition.contains("bit_order")) {
+            const auto& order = definition["bit_order"];
+            if (order != "lsb_first" && order != "msb_first") {
+                throw std::runtime_error("Invalid bit_order " + order.dump() +
+                                         ": expected \"lsb_first\" or \"msb_first\"");
+            }
+            bit_order_ = order == "msb_first" ? BitOrder::MsbFirst : BitOrder::LsbFirst;
+        }
+    }
+    if (!fieldList->is_array()) {
+        throw std::runtime_error("Configuration must be an array of fields");
+    }
+
+    try {
+        std::vector<uint32_t> direct;
+        compileList(*fieldList, "", Scope(), 0, false, direct);
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Invalid field configuration: " + std::string(e.what()));
+    }
+    closeRun();
+    emit(Op::End);
+
+    // The fields of a leading run sit at the same offsets in every message
+    nlohmann::json prefixFields = nlohmann::json::array();
+    if (instructions_[0].op == Op::Run) {
+        for (size_t i = 1; instructions_[i].op == Op::Load || instructions_[i].op == Op::LoadMsb; ++i) {
+            const FieldConfig& field = fields_[instructions_[i].slot];
+            prefixFields.push_back({{"name", field.name()}, {"bit_width", field.bit_width()},
+                                    {"signed", field.is_signed()}});
+        }
+    }
+    prefix_ = MessageConfig(bit_order_ == BitOrder::MsbFirst
+                                ? nlohmann::json{{"bit_order", "msb_first"}, {"fields", prefixFields}}
+                                : prefixFields);
+}
+
+FieldHandle DecodeProgram::getFieldHandle(const std::string& name) const {
+    auto it = field_index_.find(name);
+    if (it == field_index_.end()) {
+        throw std::runtime_error("Field not found: " + name);
+    }
+    return FieldHandle(it->second);
+}
+
+bool DecodeProgram::hasGroup(const std::string& name) const {
+    return group_index_.find(name) != group_index_.end();
+}
+
+size_t DecodeProgram::getGroupIndex(const std::string& name) const {
+    auto it = group_index_.find(name);
+    if (it == group_index_.end()) {
+        throw std::runtime_error("Repeated group not found: " + name);
+    }
+    return it->second;
+}
+
+size_t DecodeProgram::compileList(const nlohmann::json& list, const std::string& path, Scope scope,
+                                  size_t depth, bool optional, std::vector<uint32_t>& direct) {
+    if (!list.is_array()) {
+        throw std::runtime_error("Fields of group '" + path + "' must be an array");
+    }
+    // Bits every pass through the list takes, whichever conditions hold
+    size_t minBits = 0;
+    for (const auto& field : list) {
+        if (!field.is_object()) {
+            throw std::runtime_error("Each field must be a JSON object");
+        }
+        if (!field.contains("name")) {
+            throw std::runtime_error("Field configuration missing required 'name' field");
+        }
+        std::string localName = field["name"].get<std::string>();
+        std::string name = path + localName;
+        if (field_index_.count(name) != 0 || group_index_.count(name) != 0) {
+            throw std::runtime_error("Duplicate field name '" + name + "'");
+        }
+
+        // A condition skips everything the field or group emits
+        bool conditional = field.contains("present_if");
+        size_t skip = 0;
+        if (conditional) {
+            uint32_t tested = resolve(scope, field["present_if"], name);
+            closeRun();
+            skip = emit(Op::SkipUnless, tested);
+        }
+        std::vector<uint32_t> skipped;
+        std::vector<uint32_t>& target = conditional ? skipped : direct;
+        bool innerOptional = optional || conditional;
+
+        if (!field.contains("fields")) {
+            checkKeys(field, kScalarKeys, name);
+            uint32_t slot = compileScalar(field, name, innerOptional, target);
+            scope[localName] = slot;
+            if (!conditional) {
+                minBits += fields_[slot].bit_width();
+            }
+        } else if (!field.contains("count_field")) {
+            // A plain group only prefixes the names of its fields
+            checkKeys(field, kGroupKeys, name);
+            size_t bits = compileList(field["fields"], name + ".", scope, depth, innerOptional, target);
+            if (!conditional) {
+                minBits += bits;
+            }
+        } else {
+            checkKeys(field, kGroupKeys, name);
+            uint32_t counted = resolve(scope, field["count_field"], name);
+            if (fields_[counted].is_signed()) {
+                throw std::runtime_error("Count field '" + fields_[counted].name() + "' of group '" + name +
+                                         "' must be unsigned");
+            }
+            uint32_t group = static_cast<uint32_t>(group_names_.size());
+            group_names_.push_back(name);
+            group_index_.emplace(name, group);
+
+            closeRun();
+            size_t repeat = emit(Op::Repeat, counted, 0, group);
+            // Each iteration records every field of the body, so none of them is optional
+            // on account of conditions outside it
+            std::vector<uint32_t> body;
+            size_t bits = compileList(field["fields"], name + ".", scope, depth + 1, false, body);
+            if (bits == 0) {
+                throw std::runtime_error("Repeated group '" + name + "' needs at least one unconditional field");
+            }
+            if (bits > UINT32_MAX) {
+                throw std::runtime_error("Repeated group '" + name + "' too large");
+            }
+            closeRun();
+            emit(Op::Next, 0, static_cast<uint32_t>(repeat + 1));
+            instructions_[repeat].a = static_cast<uint32_t>(instructions_.size());
+            instructions_[repeat].c = static_cast<uint32_t>(bits);
+            max_depth_ = std::max(max_depth_, depth + 1);
+        }
+
+        if (conditional) {
+            closeRun();
+            Instruction& skipInstruction = instructions_[skip];
+            skipInstruction.a = static_cast<uint32_t>(instructions_.size());
+            skipInstruction.b = static_cast<uint32_t>(pad_slots_.size());
+            pad_slots_.insert(pad_slots_.end(), skipped.begin(), skipped.end());
+            skipInstruction.c = static_cast<uint32_t>(pad_slots_.size());
+            direct.insert(direct.end(), skipped.begin(), skipped.end());
+        }
+    }
+    return minBits;
+}
+
+uint32_t DecodeProgram::compileScalar(const nlohmann::json& field, const std::string& name, bool optional,
+                                      std::vector<uint32_t>& direct) {
+    if (!field.contains("bit_width")) {
+        throw std::runtime_error("Field configuration missing required 'bit_width' field");
+    }
+    uint64_t width = field["bit_width"].get<uint64_t>();
+    if (width == 0 || width > 64) {
+        throw std::runtime_error("Invalid bit width for field '" + name + "': " + std::to_string(width));
+    }
+    bool isSigned = field.value("signed", false);
+
+    uint32_t slot = static_cast<uint32_t>(fields_.size());
+    fields_.emplace_back(name, static_cast<uint8_t>(width), isSigned, bit_order_, naturalByteOrder(bit_order_));
+    optional_.push_back(optional ? 1 : 0);
+    field_index_.emplace(name, slot);
+    direct.push_back(slot);
+
+    // Appended to the open run at the next constant offset
+    if (open_run_ == SIZE_MAX) {
+        open_run_ = emit(Op::Run);
+    }
+    uint32_t offset = instructions_[open_run_].a;
+    if (offset > UINT32_MAX - width) {
+        throw std::runtime_error("Message layout too large");
+    }
+    instructions_[open_run_].a = static_cast<uint32_t>(offset + width);
+
+    size_t load = emit(bit_order_ == BitOrder::MsbFirst ? Op::LoadMsb : Op::Load, slot, offset);
+    instructions_[load].width = static_cast<uint8_t>(width);
+    instructions_[load].signShift = static_cast<uint8_t>(isSigned ? 64 - width : 0);
+    instructions_[load].optional = optional ? 1 : 0;
+    return slot;
+}
+
+uint32_t DecodeProgram::resolve(const Scope& scope, const nlohmann::json& reference, const std::string& name) const {
+    if (!reference.is_string()) {
+        throw std::runtime_error("Field '" + name + "' must refer to a field by name");
+    }
+    auto it = scope.find(reference.get<std::string>());
+    if (it == scope.end()) {
+        throw std::runtime_error("Field '" + name + "' refers to '" + reference.get<std::string>() +
+                                 "', which is not a field declared before it");
+    }
+    return it->second;
+}
+
+size_t DecodeProgram::emit(Op op, uint32_t slot, uint32_t a, uint32_t b, uint32_t c) {
+    instructions_.push_back(Instruction{op, 0, 0, 0, slot, a, b, c});
+    return instructions_.size() - 1;
+}
+
+void DecodeProgram::closeRun() {
+    open_run_ = SIZE_MAX;
+}
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,144 @@
+#include "DynamicMessage.hpp"
+#include "BitCodec.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace BinaryMessageLibrary {
+
+DynamicMessage::DynamicMessage(const DecodeProgram& program)
+    : program_(program),
+      columns_(program.getFields().size()),
+      present_(program.getFields().size()),
+      registers_(program.getFields().size(), 0),
+      group_sizes_(program.getGroupCount(), 0) {
+    loops_.reserve(program.getMaxDepth());
+}
+
+size_t DynamicMessage::unpackFrom(const uint8_t* buffer, size_t size) {
+    for (auto& column : columns_) {
+        column.clear();
+    }
+    for (auto& column : present_) {
+        column.clear();
+    }
+    std::fill(registers_.begin(), registers_.end(), 0);
+    std::fill(group_sizes_.begin(), group_sizes_.end(), 0);
+    loops_.clear();
+
+    using Op = DecodeProgram::Op;
+    const DecodeProgram::Instruction* code = program_.getInstructions().data();
+    const uint32_t* pads = program_.padSlots().data();
+    size_t totalBits = size > SIZE_MAX / 8 ? SIZE_MAX : size * 8;
+    size_t position = 0;
+    size_t base = 0;
+    size_t pc = 0;
+
+    for (;;) {
+        const DecodeProgram::Instruction& instruction = code[pc];
+        switch (instruction.op) {
+        case Op::Run:
+            // One bounds check covers every load of the run
+            if (instruction.a > totalBits - position) {
+                throw std::runtime_error("Buffer too small for message");
+            }
+            base = position;
+            position += instruction.a;
+            ++pc;
+            break;
+        case Op::Load:
+        case Op::LoadMsb: {
+            size_t bit = base + instruction.a;
+            unsigned shift = static_cast<unsigned>(bit % 8);
+            unsigned width = instruction.width;
+            uint64_t raw = instruction.op == Op::Load
+                ? BitCodec::extract(buffer, size, bit / 8, shift, BitCodec::lowMask(width), shift + width > 64)
+                : BitCodec::extractMsb(buffer, size, bit / 8, shift, width, shift + width > 64);
+            int64_t value = static_cast<int64_t>(raw << instruction.signShift) >> instruction.signShift;
+            columns_[instruction.slot].push_back(value);
+            registers_[instruction.slot] = value;
+            if (instruction.optional) {
+                present_[instruction.slot].push_back(1);
+            }
+            ++pc;
+            break;
+        }
+        case Op::SkipUnless:
+            if (registers_[instruction.slot] != 0) {
+                ++pc;
+                break;
+            }
+            for (uint32_t i = instruction.b; i < instruction.c; ++i) {
+                uint32_t slot = pads[i];
+                columns_[slot].push_back(0);
+                present_[slot].push_back(0);
+                registers_[slot] = 0;
+            }
+            pc = instruction.a;
+            break;
+        case Op::Repeat: {
+            uint64_t count = static_cast<uint64_t>(registers_[instruction.slot]);
+            if (count == 0) {
+                pc = instruction.a;
+                break;
+            }
+            // Every iteration takes at least c bits, which bounds the count by the buffer
+            if (count > (totalBits - position) / instruction.c) {
+                throw std::runtime_error("Buffer too small for message");
+            }
+            group_sizes_[instruction.b] += static_cast<size_t>(count);
+            loops_.push_back(count);
+            ++pc;
+            break;
+        }
+        case Op::Next:
+            if (--loops_.back() != 0) {
+                pc = instruction.a;
+            } else {
+                loops_.pop_back();
+                ++pc;
+            }
+            break;
+        case Op::End:
+            return (position + 7) / 8;
+        }
+    }
+}
+
+int64_t DynamicMessage::getField(FieldHandle field, size_t index) const {
+    return columns_[checkedField(field, index)][index];
+}
+
+int64_t DynamicMessage::getField(const std::string& name, size_t index) const {
+    return getField(program_.getFieldHandle(name), index);
+}
+
+bool DynamicMessage::isPresent(FieldHandle field, size_t index) const {
+    size_t slot = checkedField(field, index);
+    return !program_.isOptional(slot) || present_[slot][index] != 0;
+}
+
+bool DynamicMessage::isPresent(const std::string& name, size_t index) const {
+    return isPresent(program_.getFieldHandle(name), index);
+}
+
+const std::vector<int64_t>& DynamicMessage::getValues(FieldHandle field) const {
+    if (field.index() >= columns_.size()) {
+        throw std::runtime_error("Invalid field handle");
+    }
+    return columns_[field.index()];
+}
+
+size_t DynamicMessage::getGroupSize(const std::string& group) const {
+    return group_sizes_[program_.getGroupIndex(group)];
+}
+
+size_t DynamicMessage::checkedField(FieldHandle field, size_t index) const {
+    const auto& column = getValues(field);
+    if (index >= column.size()) {
+        throw std::runtime_error("Entry " + std::to_string(index) + " out of range for field " +
+                                 program_.getFields()[field.index()].name());
+    }
+    return field.index();
+}
+
+} // namespace BinaryMessageLibrary
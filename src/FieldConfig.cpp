@@ -1,14 +1,42 @@
 #include "FieldConfig.hpp"
 #include <stdexcept>
-#include <cmath>
+#include <cstdint>
+#include <string>
 
 namespace BinaryMessageLibrary {
 
 FieldConfig::FieldConfig(const std::string& name, uint8_t bitWidth, bool isSigned)
-    : name_(name), bit_width_(bitWidth), is_signed_(isSigned) {
+    : FieldConfig(name, bitWidth, isSigned, BitOrder::LsbFirst, ByteOrder::Little) {}
+
+FieldConfig::FieldConfig(const std::string& name, uint8_t bitWidth, bool isSigned,
+                         BitOrder bitOrder, ByteOrder byteOrder)
+    : FieldConfig(name, FieldKind::Scalar, bitWidth, 1, isSigned, bitOrder, byteOrder) {}
+
+FieldConfig::FieldConfig(const std::string& name, FieldKind kind, uint8_t bitWidth, uint32_t count,
+                         bool isSigned, BitOrder bitOrder, ByteOrder byteOrder)
+    : name_(name), bit_width_(bitWidth), is_signed_(isSigned),
+      bit_order_(bitOrder), byte_order_(byteOrder), kind_(kind), count_(count) {
     if (bitWidth == 0) {
         throw std::runtime_error("Field bit width cannot be 0");
     }
+    if (kind == FieldKind::Scalar ? count != 1 : count == 0) {
+        throw std::runtime_error("Invalid element count for field '" + name + "': " + std::to_string(count));
+    }
+    if (kind == FieldKind::Bytes && (bitWidth != 8 || isSigned || byteOrder != naturalByteOrder(bitOrder))) {
+        throw std::runtime_error("Bytes field '" + name + "' must have unsigned 8-bit elements");
+    }
+    if (byteOrder != naturalByteOrder(bitOrder) && bitWidth % 8 != 0) {
+        throw std::runtime_error("Field '" + name + "' has a byte order other than its bit order's, "
+                                 "which requires a bit width that is a multiple of 8");
+    }
+}
+
+BitOrder FieldConfig::getBitOrder() const {
+    return bit_order_;
+}
+
+ByteOrder FieldConfig::getByteOrder() const {
+    return byte_order_;
 }
 
 bool FieldConfig::isValidValue(int64_t value) const {
@@ -17,14 +45,18 @@ bool FieldConfig::isValidValue(int64_t value) const {
 
 int64_t FieldConfig::getMaxValue() const {
     if (is_signed_) {
-        return (1LL << (bit_width_ - 1)) - 1;
+        return static_cast<int64_t>((1ULL << (bit_width_ - 1)) - 1);
+    }
+    // Values are held in an int64_t, so a 64-bit unsigned field tops out there
+    if (bit_width_ >= 64) {
+        return INT64_MAX;
     }
-    return (1LL << bit_width_) - 1;
+    return static_cast<int64_t>((1ULL << bit_width_) - 1);
 }
 
 int64_t FieldConfig::getMinValue() const {
     if (is_signed_) {
-        return -(1LL << (bit_width_ - 1));
+        return -getMaxValue() - 1;
     }
     return 0;
 }
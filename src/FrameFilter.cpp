@@ -0,0 +1,226 @@
+#include "FrameFilter.hpp"
+#include "BitCodec.hpp"
+#include "SimdKernels.hpp"
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+#include <string>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace BinaryMessageLibrary {
+
+namespace {
+
+constexpr size_t kGroupFrames = 64;
+
+unsigned countTrailingZeros(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    unsigned count = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+size_t popCount(uint64_t word) {
+    return std::bitset<64>(word).count();
+}
+
+} // namespace
+
+FrameFilter::FrameFilter(const MessageConfig& config) : config_(config) {}
+
+FrameFilter& FrameFilter::where(const std::string& fieldName, CompareOp op, int64_t value) {
+    size_t index = config_.getFieldHandle(fieldName).index();
+    const auto& layout = config_.getLayout();
+    const FieldConfig& field = config_.getFields()[index];
+    if (!field.isScalar()) {
+        throw std::runtime_error("Cannot filter on field " + fieldName + ": it is not a scalar");
+    }
+    unsigned width = field.bit_width();
+    uint64_t mask = layout.masks()[index];
+    uint64_t flip = field.is_signed() ? 1ULL << (width - 1) : 0;
+
+    // Where the constant lies relative to the field's range: -1 below, 1 above
+    int position = 0;
+    if (width < 64) {
+        if (field.is_signed()) {
+            int64_t limit = int64_t(1) << (width - 1);
+            position = value < -limit ? -1 : value >= limit ? 1 : 0;
+        } else {
+            position = value < 0 ? -1 : static_cast<uint64_t>(value) > mask ? 1 : 0;
+        }
+    }
+    uint64_t key = (static_cast<uint64_t>(value) & mask) ^ flip;
+
+    // Reduce the comparison to the key range [lo, hi]; an empty range never holds
+    bool none = false;
+    bool negate = false;
+    uint64_t lo = 0;
+    uint64_t hi = mask;
+    switch (op) {
+    case CompareOp::NotEqual:
+        negate = true;
+        [[fallthrough]];
+    case CompareOp::Equal:
+        none = position != 0;
+        lo = hi = key;
+        break;
+    case CompareOp::Less:
+        none = position < 0 || (position == 0 && key == 0);
+        hi = position > 0 ? mask : key - 1;
+        break;
+    case CompareOp::LessEqual:
+        none = position < 0;
+        hi = position > 0 ? mask : key;
+        break;
+    case CompareOp::Greater:
+        none = position > 0 || (position == 0 && key == mask);
+        lo = position < 0 ? 0 : key + 1;
+        break;
+    case CompareOp::GreaterEqual:
+        none = position > 0;
+        lo = position < 0 ? 0 : key;
+        break;
+    }
+
+    bool all = !none && lo == 0 && hi == mask;
+    if (negate ? all : none) {
+        // Never holds
+        empty_ = true;
+        return *this;
+    }
+    if (negate ? none : all) {
+        // Always holds
+        return *this;
+    }
+    size_t orderedField = layout.orderFlags()[index] != 0 ? index : SIZE_MAX;
+    predicates_.push_back(Predicate{layout.byteOffsets()[index], layout.shifts()[index], mask,
+                                    layout.crossesWord()[index] != 0, flip, lo, hi - lo, negate,
+                                    orderedField});
+    return *this;
+}
+
+bool FrameFilter::matches(const uint8_t* frame, size_t size) const {
+    size_t frameSize = config_.getLayout().getTotalBytes();
+    if (size < frameSize) {
+        throw std::runtime_error("Buffer size " + std::to_string(size) +
+                                 " smaller than frame size " + std::to_string(frameSize));
+    }
+    if (empty_) {
+        return false;
+    }
+    for (const Predicate& p : predicates_) {
+        uint64_t raw = extractRaw(p, frame, size);
+        if (((raw ^ p.flip) - p.lo <= p.span) == p.negate) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t FrameFilter::selectBitmap(const uint8_t* frames, size_t count, size_t stride, uint64_t* bitmap) const {
+    validateStride(count, stride);
+    size_t extent = count == 0 ? 0 : (count - 1) * stride + config_.getLayout().getTotalBytes();
+    size_t selected = 0;
+    for (size_t first = 0; first < count; first += kGroupFrames) {
+        size_t n = std::min(kGroupFrames, count - first);
+        uint64_t word = matchGroup(frames, first, n, stride, extent);
+        bitmap[first / kGroupFrames] = word;
+        selected += popCount(word);
+    }
+    return selected;
+}
+
+size_t FrameFilter::selectIndices(const uint8_t* frames, size_t count, size_t stride,
+                                  std::vector<size_t>& indices) const {
+    validateStride(count, stride);
+    indices.clear();
+    size_t extent = count == 0 ? 0 : (count - 1) * stride + config_.getLayout().getTotalBytes();
+    for (size_t first = 0; first < count; first += kGroupFrames) {
+        size_t n = std::min(kGroupFrames, count - first);
+        uint64_t word = matchGroup(frames, first, n, stride, extent);
+        while (word != 0) {
+            indices.push_back(first + countTrailingZeros(word));
+            word &= word - 1;
+        }
+    }
+    return indices.size();
+}
+
+size_t FrameFilter::getPredicateCount() const {
+    return predicates_.size();
+}
+
+bool FrameFilter::isEmpty() const {
+    return empty_;
+}
+
+const MessageConfig& FrameFilter::getConfig() const {
+    return config_;
+}
+
+uint64_t FrameFilter::matchGroup(const uint8_t* frames, size_t first, size_t count, size_t stride,
+                                 size_t extent) const {
+    if (empty_) {
+        return 0;
+    }
+    uint64_t selected = BitCodec::lowMask(static_cast<unsigned>(count));
+    size_t frameSize = config_.getLayout().getTotalBytes();
+    size_t last = first + count - 1;
+
+    for (const Predicate& p : predicates_) {
+        const uint8_t* words = frames + first * stride + p.byteOffset;
+        uint64_t matches = 0;
+
+        // Whole words can be loaded for every frame unless the group reaches the
+        // end of the buffer; word-crossing fields and fields in other wire orders
+        // are not handled by the kernels
+        if (!p.crossesWord && p.orderedField == SIZE_MAX && last * stride + p.byteOffset + 8 <= extent) {
+            matches = SimdKernels::matchRange(words, count, stride, p.shift, p.mask, p.flip, p.lo, p.span);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                uint64_t raw = extractRaw(p, frames + (first + i) * stride, frameSize);
+                matches |= static_cast<uint64_t>((raw ^ p.flip) - p.lo <= p.span) << i;
+            }
+        }
+        if (p.negate) {
+            matches = ~matches;
+        }
+
+        // Later predicates are not evaluated once nothing is left to select
+        selected &= matches;
+        if (selected == 0) {
+            break;
+        }
+    }
+    return selected;
+}
+
+uint64_t FrameFilter::extractRaw(const Predicate& p, const uint8_t* frame, size_t size) const {
+    if (p.orderedField != SIZE_MAX) {
+        return config_.getLayout().extractRaw(p.orderedField, frame, size);
+    }
+    return BitCodec::extract(frame, size, p.byteOffset, p.shift, p.mask, p.crossesWord);
+}
+
+void FrameFilter::validateStride(size_t count, size_t stride) const {
+    size_t frameSize = config_.getLayout().getTotalBytes();
+    if (count > 1 && stride < frameSize) {
+        throw std::runtime_error("Frame stride " + std::to_string(stride) +
+                                 " smaller than frame size " + std::to_string(frameSize));
+    }
+}
+
+} // namespace BinaryMessageLibrary
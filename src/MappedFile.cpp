@@ -0,0 +1,172 @@
+#include "MappedFile.hpp"
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BinaryMessageLibrary {
+
+MappedFile::MappedFile()
+    : data_(nullptr), size_(0)
+#if defined(_WIN32)
+    , file_(nullptr), mapping_(nullptr)
+#endif
+{}
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::string& path, AccessPattern pattern) : MappedFile() {
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (pattern == AccessPattern::Sequential) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (pattern == AccessPattern::Random) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    file_ = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        close();
+        throw std::runtime_error("Cannot get size of " + path);
+    }
+    if (size.QuadPart == 0) {
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        throw std::runtime_error("Cannot map " + path);
+    }
+    mapping_ = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        close();
+        throw std::runtime_error("Cannot map " + path);
+    }
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(size.QuadPart);
+}
+
+void MappedFile::advise(AccessPattern) const {
+    // Windows only takes the hint when the file is opened
+}
+
+void MappedFile::close() {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    if (file_ != nullptr) {
+        CloseHandle(file_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    file_ = nullptr;
+    mapping_ = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path, AccessPattern pattern) : MappedFile() {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Cannot get size of " + path + ": " + std::strerror(error));
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size != 0) {
+        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            int error = errno;
+            ::close(fd);
+            throw std::runtime_error("Cannot map " + path + ": " + std::strerror(error));
+        }
+        data_ = static_cast<const uint8_t*>(mapped);
+        size_ = size;
+    }
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+
+    advise(pattern);
+}
+
+void MappedFile::advise(AccessPattern pattern) const {
+    if (data_ == nullptr) {
+        return;
+    }
+    int advice = MADV_NORMAL;
+    if (pattern == AccessPattern::Sequential) {
+        advice = MADV_SEQUENTIAL;
+    } else if (pattern == AccessPattern::Random) {
+        advice = MADV_RANDOM;
+    }
+    ::madvise(const_cast<uint8_t*>(data_), size_, advice);
+}
+
+void MappedFile::close() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : MappedFile() {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#if defined(_WIN32)
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#endif
+    }
+    return *this;
+}
+
+const uint8_t* MappedFile::data() const {
+    return data_;
+}
+
+size_t MappedFile::size() const {
+    return size_;
+}
+
+} // namespace BinaryMessageLibrary
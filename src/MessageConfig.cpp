@@ -1,24 +1,80 @@
 #include "MessageConfig.hpp"
 #include <stdexcept>
-#include <algorithm>
+#include <utility>
 
 namespace BinaryMessageLibrary {
 
-MessageConfig::MessageConfig() : total_bits_(0) {}
+namespace {
+
+BitOrder parseBitOrder(const nlohmann::json& value) {
+    if (value == "lsb_first") {
+        return BitOrder::LsbFirst;
+    }
+    if (value == "msb_first") {
+        return BitOrder::MsbFirst;
+    }
+    throw std::runtime_error("Invalid bit_order " + value.dump() + ": expected \"lsb_first\" or \"msb_first\"");
+}
+
+ByteOrder parseByteOrder(const nlohmann::json& value) {
+    if (value == "little") {
+        return ByteOrder::Little;
+    }
+    if (value == "big") {
+        return ByteOrder::Big;
+    }
+    throw std::runtime_error("Invalid byte_order " + value.dump() + ": expected \"little\" or \"big\"");
+}
+
+} // namespace
+
+MessageConfig::MessageConfig()
+    : total_bits_(0), bit_order_(BitOrder::LsbFirst), byte_order_(ByteOrder::Little) {}
 
 MessageConfig::MessageConfig(const nlohmann::json& config) {
     setConfig(config);
 }
 
+MessageConfig::MessageConfig(std::vector<FieldConfig> fields, BitOrder bitOrder, ByteOrder byteOrder)
+    : fields_(std::move(fields)), total_bits_(0), bit_order_(bitOrder), byte_order_(byteOrder) {
+    field_index_.reserve(fields_.size());
+    for (size_t i = 0; i < fields_.size(); ++i) {
+        if (!field_index_.emplace(fields_[i].name(), static_cast<uint32_t>(i)).second) {
+            throw std::runtime_error("Duplicate field name '" + fields_[i].name() + "'");
+        }
+        total_bits_ += fields_[i].getTotalBits();
+    }
+    layout_ = MessageLayout(fields_, bit_order_);
+    unpack_program_ = UnpackProgram(layout_);
+}
+
 void MessageConfig::setConfig(const nlohmann::json& config) {
-    if (!config.is_array()) {
+    // Either a bare field array, or an object with message-wide wire order and the fields
+    BitOrder messageBitOrder = BitOrder::LsbFirst;
+    ByteOrder messageByteOrder = ByteOrder::Little;
+    const nlohmann::json* fieldList = &config;
+    if (config.is_object()) {
+        if (!config.contains("fields")) {
+            throw std::runtime_error("Configuration object missing required 'fields' array");
+        }
+        fieldList = &config["fields"];
+        if (config.contains("bit_order")) {
+            messageBitOrder = parseBitOrder(config["bit_order"]);
+        }
+        messageByteOrder = config.contains("byte_order") ? parseByteOrder(config["byte_order"])
+                                                         : naturalByteOrder(messageBitOrder);
+    }
+    if (!fieldList->is_array()) {
         throw std::runtime_error("Configuration must be an array of fields");
     }
 
     fields_.clear();
+    field_index_.clear();
     total_bits_ = 0;
+    bit_order_ = messageBitOrder;
+    byte_order_ = messageByteOrder;
     
-    for (const auto& field : config) {
+    for (const auto& field : *fieldList) {
         if (!field.is_object()) {
             throw std::runtime_error("Each field must be a JSON object");
         }
@@ -27,26 +83,71 @@ void MessageConfig::setConfig(const nlohmann::json& config) {
         if (!field.contains("name")) {
             throw std::runtime_error("Field configuration missing required 'name' field");
         }
-        if (!field.contains("bit_width")) {
+        if (!field.contains("bit_width") && !field.contains("bytes")) {
             throw std::runtime_error("Field configuration missing required 'bit_width' field");
         }
 
         try {
             std::string name = field["name"].get<std::string>();
-            uint8_t bit_width = field["bit_width"].get<uint8_t>();
             bool is_signed = field.value("signed", false);
 
+            // Scalars and arrays give an element width and, for arrays, a count;
+            // byte blobs give a byte count, either directly or as a bit width
+            // past 64 that is a whole number of bytes
+            FieldKind kind = FieldKind::Scalar;
+            uint64_t bit_width = 8;
+            uint64_t count = 1;
+            if (field.contains("bytes")) {
+                if (field.contains("bit_width") || field.contains("count")) {
+                    throw std::runtime_error("Bytes field '" + name + "' cannot also have a bit_width or count");
+                }
+                kind = FieldKind::Bytes;
+                count = field["bytes"].get<uint64_t>();
+            } else {
+                bit_width = field["bit_width"].get<uint64_t>();
+                if (bit_width > 64 && bit_width % 8 == 0 && !field.contains("count")) {
+                    kind = FieldKind::Bytes;
+                    count = bit_width / 8;
+                    bit_width = 8;
+                } else if (field.contains("count")) {
+                    kind = FieldKind::Array;
+                    count = field["count"].get<uint64_t>();
+                }
+            }
+
             if (bit_width == 0 || bit_width > 64) {
                 throw std::runtime_error("Invalid bit width for field '" + name + "': " + 
                                        std::to_string(bit_width));
             }
+            if (kind != FieldKind::Scalar && (count == 0 || count > UINT32_MAX)) {
+                throw std::runtime_error("Invalid element count for field '" + name + "': " +
+                                       std::to_string(count));
+            }
+            if (kind == FieldKind::Bytes && (field.contains("bit_order") || field.contains("byte_order"))) {
+                throw std::runtime_error("Bytes field '" + name + "' cannot have a bit_order or byte_order");
+            }
 
-            fields_.emplace_back(name, bit_width, is_signed);
-            total_bits_ += bit_width;
+            // Fields inherit the message's orders; the byte order only carries
+            // over to widths it can apply to, and never to raw bytes
+            BitOrder bit_order = field.contains("bit_order") ? parseBitOrder(field["bit_order"])
+                                                             : messageBitOrder;
+            ByteOrder byte_order = field.contains("byte_order") ? parseByteOrder(field["byte_order"])
+                                 : kind != FieldKind::Bytes && bit_width % 8 == 0 ? messageByteOrder
+                                                                                  : naturalByteOrder(bit_order);
+
+            if (!field_index_.emplace(name, static_cast<uint32_t>(fields_.size())).second) {
+                throw std::runtime_error("Duplicate field name '" + name + "'");
+            }
+            fields_.emplace_back(name, kind, static_cast<uint8_t>(bit_width), static_cast<uint32_t>(count),
+                                 is_signed, bit_order, byte_order);
+            total_bits_ += fields_.back().getTotalBits();
         } catch (const nlohmann::json::exception& e) {
             throw std::runtime_error("Invalid field configuration: " + std::string(e.what()));
         }
     }
+
+    layout_ = MessageLayout(fields_, bit_order_);
+    unpack_program_ = UnpackProgram(layout_);
 }
 
 const std::vector<FieldConfig>& MessageConfig::getFields() const {
@@ -57,20 +158,43 @@ size_t MessageConfig::getTotalBits() const {
     return total_bits_;
 }
 
+const MessageLayout& MessageConfig::getLayout() const {
+    return layout_;
+}
+
 const FieldConfig& MessageConfig::getFieldConfig(const std::string& name) const {
-    auto it = std::find_if(fields_.begin(), fields_.end(),
-        [&name](const FieldConfig& field) { return field.name() == name; });
-    
-    if (it == fields_.end()) {
+    return fields_[getFieldHandle(name).index()];
+}
+
+bool MessageConfig::hasField(const std::string& name) const {
+    return field_index_.find(name) != field_index_.end();
+}
+
+FieldHandle MessageConfig::getFieldHandle(const std::string& name) const {
+    auto it = field_index_.find(name);
+    if (it == field_index_.end()) {
         throw std::runtime_error("Field not found: " + name);
     }
-    
-    return *it;
+    return FieldHandle(it->second);
 }
 
-bool MessageConfig::hasField(const std::string& name) const {
-    return std::any_of(fields_.begin(), fields_.end(),
-        [&name](const FieldConfig& field) { return field.name() == name; });
+const FieldConfig& MessageConfig::getFieldConfig(FieldHandle handle) const {
+    if (handle.index() >= fields_.size()) {
+        throw std::runtime_error("Invalid field handle");
+    }
+    return fields_[handle.index()];
+}
+
+BitOrder MessageConfig::getBitOrder() const {
+    return bit_order_;
+}
+
+ByteOrder MessageConfig::getByteOrder() const {
+    return byte_order_;
+}
+
+const UnpackProgram& MessageConfig::getUnpackProgram() const {
+    return unpack_program_;
 }
 
 } // namespace BinaryMessageLibrary 
\ No newline at end of file
@@ -0,0 +1,411 @@
+#include "MessageContainer.hpp"
+#include "ByteIO.hpp"
+#include "SchemaEncoding.hpp"
+#include "SchemaRegistry.hpp"
+#include "Varint.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+namespace BinaryMessageLibrary {
+
+namespace {
+
+const uint8_t kHeaderMagic[4] = {'B', 'M', 'S', 'C'};
+const uint8_t kTrailerMagic[4] = {'B', 'M', 'S', 'X'};
+constexpr uint8_t kBlockTag = 0x01;
+constexpr uint8_t kIndexTag = 0x02;
+constexpr size_t kBlockHeaderSize = 1 + 4 + 4;
+constexpr size_t kTrailerSize = 8 + 4;
+// Blocks are flushed early once they grow past this, keeping sizes well inside u32
+constexpr size_t kMaxBlockBytes = 64u << 20;
+
+[[noreturn]] void malformed(const std::string& what) {
+    throw std::runtime_error("Malformed container: " + what);
+}
+
+std::vector<std::pair<std::string, MessageSchema>> factoryTypes(const BinaryMessageFactory& factory) {
+    auto names = factory.getMessageTypes();
+    std::sort(names.begin(), names.end());
+    std::vector<std::pair<std::string, MessageSchema>> types;
+    types.reserve(names.size());
+    for (auto& name : names) {
+        MessageSchema schema = factory.getSchema(name);
+        types.emplace_back(std::move(name), std::move(schema));
+    }
+    return types;
+}
+
+// Canonical schema bytes; two configs with the same key pack identical payloads
+std::string layoutKey(const MessageConfig& config) {
+    std::vector<uint8_t> bytes;
+    SchemaEncoding::encode(bytes, config);
+    return std::string(bytes.begin(), bytes.end());
+}
+
+} // namespace
+
+using namespace ByteIO;
+
+ContainerWriter::ContainerWriter(std::ostream& out, const BinaryMessageFactory& factory, size_t blockFrames)
+    : ContainerWriter(out, factoryTypes(factory), blockFrames) {}
+
+ContainerWriter::ContainerWriter(std::ostream& out,
+                                 const std::vector<std::pair<std::string, MessageSchema>>& types,
+                                 size_t blockFrames)
+    : out_(out), block_frames_(blockFrames), types_(types) {
+    if (block_frames_ == 0) {
+        throw std::runtime_error("A container block must hold at least one frame");
+    }
+    std::unordered_set<std::string> names;
+    for (size_t i = 0; i < types_.size(); ++i) {
+        if (!types_[i].second) {
+            throw std::runtime_error("Schema of message type '" + types_[i].first + "' is null");
+        }
+        if (!names.insert(types_[i].first).second) {
+            throw std::runtime_error("Message type '" + types_[i].first + "' registered twice");
+        }
+        type_ids_.emplace(types_[i].second.get(), static_cast<uint32_t>(i));
+        layout_ids_.emplace(layoutKey(*types_[i].second), static_cast<uint32_t>(i));
+    }
+    writeHeader();
+}
+
+ContainerWriter::~ContainerWriter() {
+    if (!finished_) {
+        try {
+            finish();
+        } catch (...) {
+        }
+    }
+}
+
+uint32_t ContainerWriter::getTypeId(const std::string& messageType) const {
+    for (size_t i = 0; i < types_.size(); ++i) {
+        if (types_[i].first == messageType) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    throw std::runtime_error("Message type '" + messageType + "' not registered with the container");
+}
+
+void ContainerWriter::write(const BinaryMessage& message) {
+    auto it = type_ids_.find(&message.getConfig());
+    if (it != type_ids_.end()) {
+        write(it->second, message);
+        return;
+    }
+    auto layout = layout_ids_.find(layoutKey(message.getConfig()));
+    if (layout == layout_ids_.end()) {
+        throw std::runtime_error("Message type not registered with the container");
+    }
+    write(layout->second, message);
+}
+
+void ContainerWriter::write(uint32_t typeId, const BinaryMessage& message) {
+    size_t size = message.getPackedSize();
+    uint8_t* payload = beginFrame(typeId, size);
+    message.packInto(payload, size);
+    endFrame();
+}
+
+void ContainerWriter::writeFrame(uint32_t typeId, const uint8_t* payload, size_t size) {
+    uint8_t* out = beginFrame(typeId, size);
+    if (size != 0) {
+        std::memcpy(out, payload, size);
+    }
+    endFrame();
+}
+
+void ContainerWriter::flush() {
+    if (block_frame_count_ == 0) {
+        return;
+    }
+    index_.emplace_back(offset_, frame_count_ - block_frame_count_);
+
+    uint8_t header[kBlockHeaderSize];
+    header[0] = kBlockTag;
+    auto bodySize = static_cast<uint32_t>(block_.size());
+    for (int i = 0; i < 4; ++i) {
+        header[1 + i] = static_cast<uint8_t>(bodySize >> (8 * i));
+        header[5 + i] = static_cast<uint8_t>(block_frame_count_ >> (8 * i));
+    }
+    emit(header, sizeof(header));
+    emit(block_.data(), block_.size());
+    block_.clear();
+    block_frame_count_ = 0;
+}
+
+void ContainerWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    flush();
+    finished_ = true;
+
+    std::vector<uint8_t> body;
+    putVarint(body, index_.size());
+    for (const auto& [offset, firstFrame] : index_) {
+        putU64(body, offset);
+        putU64(body, firstFrame);
+    }
+
+    std::vector<uint8_t> tail;
+    uint64_t indexOffset = offset_;
+    tail.push_back(kIndexTag);
+    putU32(tail, static_cast<uint32_t>(body.size()));
+    tail.insert(tail.end(), body.begin(), body.end());
+    putU64(tail, indexOffset);
+    tail.insert(tail.end(), kTrailerMagic, kTrailerMagic + 4);
+    emit(tail.data(), tail.size());
+    out_.flush();
+}
+
+uint64_t ContainerWriter::getFrameCount() const {
+    return frame_count_;
+}
+
+void ContainerWriter::emit(const uint8_t* data, size_t size) {
+    out_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!out_) {
+        throw std::runtime_error("Failed to write container");
+    }
+    offset_ += size;
+}
+
+void ContainerWriter::writeHeader() {
+    std::vector<uint8_t> header(kHeaderMagic, kHeaderMagic + 4);
+    header.push_back(Container::kVersion);
+    putVarint(header, types_.size());
+    for (const auto& [name, schema] : types_) {
+        putString(header, name);
+        SchemaEncoding::encode(header, *schema);
+    }
+    emit(header.data(), header.size());
+}
+
+uint8_t* ContainerWriter::beginFrame(uint32_t typeId, size_t size) {
+    if (finished_) {
+        throw std::runtime_error("Container has already been finished");
+    }
+    if (typeId >= types_.size()) {
+        throw std::runtime_error("Type id " + std::to_string(typeId) + " out of range");
+    }
+    size_t start = block_.size();
+    block_.resize(start + 2 * Varint::kMaxBytes + size);
+    size_t position = start + Varint::encode(typeId, block_.data() + start);
+    position += Varint::encode(size, block_.data() + position);
+    block_.resize(position + size);
+    return block_.data() + position;
+}
+
+void ContainerWriter::endFrame() {
+    ++block_frame_count_;
+    ++frame_count_;
+    if (block_frame_count_ >= block_frames_ || block_.size() >= kMaxBlockBytes) {
+        flush();
+    }
+}
+
+ContainerReader::ContainerReader(const uint8_t* data, size_t size) : data_(data), size_(size) {
+    open();
+}
+
+ContainerReader::ContainerReader(const std::string& path)
+    : file_(path, AccessPattern::Sequential), data_(file_.data()), size_(file_.size()) {
+    open();
+}
+
+size_t ContainerReader::getTypeCount() const {
+    return types_.size();
+}
+
+const std::string& ContainerReader::getTypeName(uint32_t typeId) const {
+    if (typeId >= types_.size()) {
+        throw std::runtime_error("Type id " + std::to_string(typeId) + " out of range");
+    }
+    return types_[typeId].name;
+}
+
+const MessageSchema& ContainerReader::getSchema(uint32_t typeId) const {
+    if (typeId >= types_.size()) {
+        throw std::runtime_error("Type id " + std::to_string(typeId) + " out of range");
+    }
+    return types_[typeId].schema;
+}
+
+uint32_t ContainerReader::getTypeId(const std::string& messageType) const {
+    auto it = type_ids_.find(messageType);
+    if (it == type_ids_.end()) {
+        throw std::runtime_error("Message type '" + messageType + "' not found in container");
+    }
+    return it->second;
+}
+
+bool ContainerReader::next(ContainerFrame& frame) {
+    while (block_remaining_ == 0) {
+        if (position_ >= blocks_end_ || data_[position_] == kIndexTag) {
+            return false;
+        }
+        if (data_[position_] != kBlockTag) {
+            malformed("unknown block tag");
+        }
+        if (!enterBlock(position_)) {
+            // Cut off at the end of an unfinished container
+            return false;
+        }
+    }
+
+    Reader cursor(data_, position_, block_end_, "container");
+    uint64_t typeId = cursor.varint("frame type id");
+    uint64_t size = cursor.varint("frame size");
+    if (typeId >= types_.size()) {
+        malformed("frame type id out of range");
+    }
+    if (size > block_end_ - cursor.position()) {
+        malformed("frame runs past its block");
+    }
+
+    frame.typeId = static_cast<uint32_t>(typeId);
+    frame.index = next_index_++;
+    frame.payload = FrameView{data_ + cursor.position(), static_cast<size_t>(size)};
+    position_ = cursor.position() + static_cast<size_t>(size);
+    if (--block_remaining_ == 0) {
+        position_ = block_end_;
+    }
+    return true;
+}
+
+bool ContainerReader::next(ContainerFrame& frame, BinaryMessage& message) {
+    if (!next(frame)) {
+        return false;
+    }
+    const TypeEntry& type = types_[frame.typeId];
+    if (&message.getConfig() != type.schema.get() && layoutKey(message.getConfig()) != type.layout) {
+        throw std::runtime_error("Message does not use the schema of frame type '" +
+                                 type.name + "'");
+    }
+    message.unpackFrom(frame.payload.data, frame.payload.size);
+    return true;
+}
+
+bool ContainerReader::hasIndex() const {
+    return has_index_;
+}
+
+uint64_t ContainerReader::getFrameCount() const {
+    if (!has_index_) {
+        throw std::runtime_error("Container has no block index");
+    }
+    return total_frames_;
+}
+
+void ContainerReader::seek(uint64_t index) {
+    if (!has_index_) {
+        throw std::runtime_error("Container has no block index");
+    }
+    if (index > total_frames_) {
+        throw std::runtime_error("Frame index " + std::to_string(index) + " out of range");
+    }
+
+    rewind();
+    auto block = std::upper_bound(index_.begin(), index_.end(), index,
+        [](uint64_t value, const std::pair<uint64_t, uint64_t>& entry) { return value < entry.second; });
+    if (block == index_.begin()) {
+        return;
+    }
+    --block;
+    if (!enterBlock(static_cast<size_t>(block->first))) {
+        malformed("indexed block is cut off");
+    }
+    next_index_ = block->second;
+
+    ContainerFrame frame;
+    while (next_index_ < index && next(frame)) {
+    }
+}
+
+void ContainerReader::rewind() {
+    position_ = first_block_;
+    block_end_ = 0;
+    block_remaining_ = 0;
+    next_index_ = 0;
+}
+
+void ContainerReader::open() {
+    if (size_ < 5 || std::memcmp(data_, kHeaderMagic, 4) != 0) {
+        malformed("bad magic");
+    }
+    if (data_[4] != Container::kVersion) {
+        throw std::runtime_error("Unsupported container version " + std::to_string(data_[4]));
+    }
+
+    Reader cursor(data_, 5, size_, "container");
+    uint64_t typeCount = cursor.varint("type count");
+    for (uint64_t t = 0; t < typeCount; ++t) {
+        std::string name = cursor.string("type name");
+        nlohmann::json definition = SchemaEncoding::decode(cursor);
+        if (!type_ids_.emplace(name, static_cast<uint32_t>(types_.size())).second) {
+            malformed("duplicate type '" + name + "'");
+        }
+        MessageSchema schema = SchemaRegistry::global().intern(definition);
+        std::string layout = layoutKey(*schema);
+        types_.push_back(TypeEntry{std::move(name), std::move(schema), std::move(layout)});
+    }
+    first_block_ = cursor.position();
+    blocks_end_ = size_;
+
+    // Finished containers end with the index offset and a magic number
+    if (size_ - first_block_ >= kTrailerSize &&
+        std::memcmp(data_ + size_ - 4, kTrailerMagic, 4) == 0) {
+        uint64_t indexOffset = getU64(data_ + size_ - kTrailerSize);
+        if (indexOffset < first_block_ || indexOffset >= size_ - kTrailerSize) {
+            malformed("index offset out of range");
+        }
+        Reader index(data_, static_cast<size_t>(indexOffset), size_ - kTrailerSize, "container");
+        if (index.u8("index tag") != kIndexTag) {
+            malformed("bad index tag");
+        }
+        index.u32("index size");
+        uint64_t blockCount = index.varint("block count");
+        for (uint64_t b = 0; b < blockCount; ++b) {
+            uint64_t offset = index.u64("block offset");
+            uint64_t firstFrame = index.u64("block first frame");
+            if (offset < first_block_ || offset + kBlockHeaderSize > indexOffset ||
+                (!index_.empty() && firstFrame < index_.back().second)) {
+                malformed("bad block index entry");
+            }
+            index_.emplace_back(offset, firstFrame);
+        }
+        blocks_end_ = static_cast<size_t>(indexOffset);
+        has_index_ = true;
+        if (!index_.empty()) {
+            total_frames_ = index_.back().second + getU32(data_ + index_.back().first + 5);
+        }
+    }
+
+    rewind();
+}
+
+bool ContainerReader::enterBlock(size_t offset) {
+    if (blocks_end_ - offset < kBlockHeaderSize) {
+        return false;
+    }
+    uint32_t bodySize = getU32(data_ + offset + 1);
+    uint32_t frames = getU32(data_ + offset + 5);
+    size_t body = offset + kBlockHeaderSize;
+    if (bodySize > blocks_end_ - body) {
+        return false;
+    }
+    position_ = body;
+    block_end_ = body + bodySize;
+    block_remaining_ = frames;
+    if (frames == 0) {
+        position_ = block_end_;
+    }
+    return true;
+}
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,141 @@
+#include "MessageLayout.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace BinaryMessageLibrary {
+
+MessageLayout::MessageLayout()
+    : total_bits_(0), block_bytes_(0), block_field_count_(0),
+      bit_order_(BitOrder::LsbFirst), default_order_(true) {}
+
+MessageLayout::MessageLayout(const std::vector<FieldConfig>& fields, BitOrder bitOrder)
+    : total_bits_(0), block_bytes_(0), block_field_count_(0),
+      bit_order_(bitOrder), default_order_(true) {
+    byte_offsets_.reserve(fields.size());
+    shifts_.reserve(fields.size());
+    bit_widths_.reserve(fields.size());
+    masks_.reserve(fields.size());
+    sign_shifts_.reserve(fields.size());
+    crosses_word_.reserve(fields.size());
+    order_flags_.reserve(fields.size());
+    element_counts_.reserve(fields.size());
+    block_offsets_.reserve(fields.size());
+
+    for (const auto& field : fields) {
+        unsigned width = field.bit_width();
+        if (width == 0 || width > 64) {
+            throw std::runtime_error("Invalid bit width for field '" + field.name() + "': " +
+                                     std::to_string(width));
+        }
+        if (total_bits_ / 8 > UINT32_MAX || field.getTotalBits() / 8 > UINT32_MAX - total_bits_ / 8) {
+            throw std::runtime_error("Message layout too large");
+        }
+
+        bool scalar = field.isScalar();
+        unsigned shift = static_cast<unsigned>(total_bits_ % 8);
+        byte_offsets_.push_back(static_cast<uint32_t>(total_bits_ / 8));
+        shifts_.push_back(static_cast<uint8_t>(shift));
+        bit_widths_.push_back(static_cast<uint8_t>(width));
+        masks_.push_back(BitCodec::lowMask(width));
+        sign_shifts_.push_back(static_cast<uint8_t>(field.is_signed() ? 64 - width : 0));
+        crosses_word_.push_back(scalar && shift + width > 64 ? 1 : 0);
+        element_counts_.push_back(field.getCount());
+
+        uint8_t flags = 0;
+        if (bitOrder == BitOrder::MsbFirst) {
+            flags |= kMsbFirst;
+        }
+        if (field.getBitOrder() != bitOrder) {
+            flags |= kReverseBits;
+        }
+        if (field.getByteOrder() != naturalByteOrder(field.getBitOrder())) {
+            flags |= kSwapBytes;
+        }
+        default_order_ = default_order_ && flags == 0;
+
+        if (scalar) {
+            block_offsets_.push_back(0);
+        } else {
+            flags |= kBlock;
+            if (block_bytes_ > UINT32_MAX) {
+                throw std::runtime_error("Message layout too large");
+            }
+            block_offsets_.push_back(static_cast<uint32_t>(block_bytes_));
+            block_bytes_ += (field.getTotalBits() + 7) / 8;
+            ++block_field_count_;
+        }
+        order_flags_.push_back(flags);
+
+        total_bits_ += field.getTotalBits();
+    }
+}
+
+void MessageLayout::extractBlock(size_t index, const uint8_t* buffer, size_t size, uint8_t* block) const {
+    size_t bits = static_cast<size_t>(bit_widths_[index]) * element_counts_[index];
+    size_t byteOffset = byte_offsets_[index];
+    unsigned shift = shifts_[index];
+    bool msbFirst = bit_order_ == BitOrder::MsbFirst;
+
+    // Blocks starting on a byte boundary are copied as they are
+    if (shift == 0) {
+        size_t bytes = bits / 8;
+        unsigned tail = static_cast<unsigned>(bits % 8);
+        std::memcpy(block, buffer + byteOffset, bytes);
+        if (tail != 0) {
+            uint8_t keep = static_cast<uint8_t>(msbFirst ? 0xFF00 >> tail : BitCodec::lowMask(tail));
+            block[bytes] = static_cast<uint8_t>(buffer[byteOffset + bytes] & keep);
+        }
+        return;
+    }
+
+    // Otherwise 64 bits at a time, each chunk spilling into the byte after its word
+    size_t words = bits / 64;
+    for (size_t w = 0; w < words; ++w) {
+        size_t chunkOffset = byteOffset + 8 * w;
+        if (msbFirst) {
+            BitCodec::storeBE64(block + 8 * w, BitCodec::extractMsb(buffer, size, chunkOffset, shift, 64, true));
+        } else {
+            BitCodec::storeLE64(block + 8 * w, BitCodec::extract(buffer, size, chunkOffset, shift, ~0ULL, true));
+        }
+    }
+    unsigned rest = static_cast<unsigned>(bits % 64);
+    if (rest != 0) {
+        size_t chunkOffset = byteOffset + 8 * words;
+        size_t bytes = (rest + 7) / 8;
+        if (msbFirst) {
+            uint64_t raw = BitCodec::extractMsb(buffer, size, chunkOffset, shift, rest, shift + rest > 64);
+            BitCodec::storeBEPartial(block + 8 * words, raw << (64 - rest), bytes);
+        } else {
+            uint64_t raw = BitCodec::extract(buffer, size, chunkOffset, shift, BitCodec::lowMask(rest),
+                                             shift + rest > 64);
+            BitCodec::storeLEPartial(block + 8 * words, raw, bytes);
+        }
+    }
+}
+
+void MessageLayout::extractElements(size_t index, const uint8_t* block, int64_t* values) const {
+    size_t count = element_counts_[index];
+    if ((order_flags_[index] & ~kBlock) != 0) {
+        for (size_t e = 0; e < count; ++e) {
+            values[e] = extractElement(index, block, e);
+        }
+        return;
+    }
+    unsigned signShift = sign_shifts_[index];
+    BitCodec::unpackRun(block, getBlockSize(index), count, bit_widths_[index], [&](size_t e, uint64_t raw) {
+        values[e] = static_cast<int64_t>(raw << signShift) >> signShift;
+    });
+}
+
+void MessageLayout::depositElements(size_t index, uint8_t* block, const int64_t* values) const {
+    size_t count = element_counts_[index];
+    if ((order_flags_[index] & ~kBlock) != 0) {
+        for (size_t e = 0; e < count; ++e) {
+            depositElement(index, block, e, values[e]);
+        }
+        return;
+    }
+    BitCodec::packRun(count, bit_widths_[index], [values](size_t e) { return values[e]; }, block);
+}
+
+} // namespace BinaryMessageLibrary
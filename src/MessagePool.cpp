@@ -0,0 +1,119 @@
+#include "MessagePool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace BinaryMessageLibrary {
+
+namespace {
+
+// Threads are numbered round robin the first time they touch any pool, which
+// spreads them evenly over the shards
+size_t threadSlot() {
+    static std::atomic<size_t> next_slot{0};
+    thread_local size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+size_t defaultShardCount(size_t shardCount) {
+    // Querying the CPU count reads from the OS, which would dominate creating
+    // the pools of a factory with many types
+    static const size_t hardwareThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    return shardCount != 0 ? shardCount : hardwareThreads;
+}
+
+} // namespace
+
+void MessageRecycler::operator()(BinaryMessage* message) const {
+    if (pool_ != nullptr && message != nullptr) {
+        pool_->release(message, shard_);
+    }
+}
+
+MessagePool::MessagePool(const MessageConfig& config, size_t shardCount)
+    : config_(&config),
+      shard_count_(defaultShardCount(shardCount)),
+      shards_(new Shard[shard_count_]) {}
+
+MessagePool::MessagePool(MessageSchema schema, size_t shardCount)
+    : schema_(std::move(schema)),
+      config_(schema_.get()),
+      shard_count_(defaultShardCount(shardCount)),
+      shards_(new Shard[shard_count_]) {
+    if (!config_) {
+        throw std::runtime_error("Message schema must not be null");
+    }
+}
+
+PooledMessage MessagePool::acquire() {
+    size_t index = currentShard();
+    Shard& shard = shards_[index];
+    BinaryMessage* message;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.free.empty()) {
+            message = shard.free.back();
+            shard.free.pop_back();
+        } else {
+            message = createMessage(shard);
+            // Make sure releasing it later never has to grow the free list
+            shard.free.reserve(shard.storage.size());
+        }
+    }
+    return PooledMessage(message, MessageRecycler(this, index));
+}
+
+void MessagePool::reserve(size_t count) {
+    Shard& shard = shards_[currentShard()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.free.reserve(shard.storage.size() + count);
+    while (shard.free.size() < count) {
+        shard.free.push_back(createMessage(shard));
+    }
+}
+
+size_t MessagePool::getCapacity() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        total += shards_[i].storage.size();
+    }
+    return total;
+}
+
+size_t MessagePool::getAvailable() const {
+    size_t total = 0;
+    for (size_t i = 0; i < shard_count_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        total += shards_[i].free.size();
+    }
+    return total;
+}
+
+const MessageConfig& MessagePool::getConfig() const {
+    return *config_;
+}
+
+size_t MessagePool::currentShard() const {
+    return threadSlot() % shard_count_;
+}
+
+BinaryMessage* MessagePool::createMessage(Shard& shard) {
+    if (schema_) {
+        shard.storage.emplace_back(schema_);
+    } else {
+        shard.storage.emplace_back(*config_);
+    }
+    return &shard.storage.back();
+}
+
+void MessagePool::release(BinaryMessage* message, size_t shard) {
+    message->reset();
+    Shard& owner = shards_[shard];
+    std::lock_guard<std::mutex> lock(owner.mutex);
+    owner.free.push_back(message);
+}
+
+} // namespace BinaryMessageLibrary
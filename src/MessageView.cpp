@@ -0,0 +1,37 @@
+#include "MessageView.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace BinaryMessageLibrary {
+
+MessageView::MessageView(const MessageConfig& config, const uint8_t* buffer, size_t size)
+    : config_(&config), buffer_(buffer), size_(size) {
+    if (size_ < config_->getLayout().getTotalBytes()) {
+        throw std::runtime_error("Buffer too small for message");
+    }
+}
+
+MessageView::MessageView(const MessageConfig& config, FrameView frame)
+    : MessageView(config, frame.data, frame.size) {}
+
+int64_t MessageView::getField(const std::string& name) const {
+    return getField(config_->getFieldHandle(name));
+}
+
+void MessageView::throwInvalidHandle() {
+    throw std::runtime_error("Invalid field handle, or not a scalar field");
+}
+
+MutableMessageView::MutableMessageView(const MessageConfig& config, uint8_t* buffer, size_t size)
+    : MessageView(config, buffer, size), writable_(buffer) {}
+
+void MutableMessageView::setField(const std::string& name, int64_t value) {
+    setField(config_->getFieldHandle(name), value);
+}
+
+void MutableMessageView::throwOutOfRange(size_t index, int64_t value) const {
+    throw std::runtime_error("Value " + std::to_string(value) +
+                             " out of range for field " + config_->getFields()[index].name());
+}
+
+} // namespace BinaryMessageLibrary
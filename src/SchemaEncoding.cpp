@@ -0,0 +1,177 @@
+#include "SchemaEncoding.hpp"
+#include <string>
+#include <utility>
+
+namespace BinaryMessageLibrary {
+namespace SchemaEncoding {
+
+namespace {
+
+// Message flags
+constexpr uint8_t kMessageMsbFirst = 0x01;
+constexpr uint8_t kMessageBigEndian = 0x02;
+
+// Field flags
+constexpr uint8_t kSignedFlag = 0x01;
+constexpr uint8_t kFieldMsbFirst = 0x02;
+constexpr uint8_t kFieldBigEndian = 0x04;
+constexpr uint8_t kFieldArray = 0x08;
+constexpr uint8_t kFieldBytes = 0x10;
+constexpr uint8_t kKnownFieldFlags = 0x1F;
+
+const char* bitOrderName(BitOrder order) {
+    return order == BitOrder::MsbFirst ? "msb_first" : "lsb_first";
+}
+
+const char* byteOrderName(ByteOrder order) {
+    return order == ByteOrder::Big ? "big" : "little";
+}
+
+BitOrder messageBitOrderOf(uint8_t messageFlags) {
+    return messageFlags & kMessageMsbFirst ? BitOrder::MsbFirst : BitOrder::LsbFirst;
+}
+
+ByteOrder messageByteOrderOf(uint8_t messageFlags) {
+    return messageFlags & kMessageBigEndian ? ByteOrder::Big : ByteOrder::Little;
+}
+
+// One field as written by encode(); count is 1 for scalars
+struct FieldRecord {
+    std::string name;
+    uint64_t width;
+    uint8_t flags;
+    uint64_t count;
+};
+
+FieldRecord readField(ByteIO::Reader& reader) {
+    FieldRecord record;
+    record.name = reader.string("field name");
+    record.width = reader.varint("bit width");
+    record.flags = reader.u8("field flags");
+    if ((record.flags & ~kKnownFieldFlags) != 0 || (record.flags & kFieldArray && record.flags & kFieldBytes)) {
+        reader.fail("unsupported flags for field " + record.name);
+    }
+    if (record.flags & kFieldBytes) {
+        record.count = reader.varint("byte count");
+    } else if (record.flags & kFieldArray) {
+        record.count = reader.varint("element count");
+    } else {
+        record.count = 1;
+    }
+    return record;
+}
+
+} // namespace
+
+void encode(std::vector<uint8_t>& out, const MessageConfig& config) {
+    uint8_t messageFlags = 0;
+    if (config.getBitOrder() == BitOrder::MsbFirst) {
+        messageFlags |= kMessageMsbFirst;
+    }
+    if (config.getByteOrder() == ByteOrder::Big) {
+        messageFlags |= kMessageBigEndian;
+    }
+    ByteIO::putU8(out, messageFlags);
+
+    const auto& fields = config.getFields();
+    ByteIO::putVarint(out, fields.size());
+    for (const auto& field : fields) {
+        uint8_t flags = field.is_signed() ? kSignedFlag : 0;
+        if (field.getBitOrder() == BitOrder::MsbFirst) {
+            flags |= kFieldMsbFirst;
+        }
+        if (field.getByteOrder() == ByteOrder::Big) {
+            flags |= kFieldBigEndian;
+        }
+        if (field.getKind() == FieldKind::Array) {
+            flags |= kFieldArray;
+        } else if (field.getKind() == FieldKind::Bytes) {
+            flags |= kFieldBytes;
+        }
+        ByteIO::putString(out, field.name());
+        ByteIO::putVarint(out, field.bit_width());
+        ByteIO::putU8(out, flags);
+        if (!field.isScalar()) {
+            ByteIO::putVarint(out, field.getCount());
+        }
+    }
+}
+
+nlohmann::json decode(ByteIO::Reader& reader) {
+    uint8_t messageFlags = reader.u8("message flags");
+    BitOrder messageBitOrder = messageBitOrderOf(messageFlags);
+    ByteOrder messageByteOrder = messageByteOrderOf(messageFlags);
+    bool defaultOrder = messageFlags == 0;
+
+    uint64_t fieldCount = reader.varint("field count");
+    nlohmann::json fields = nlohmann::json::array();
+    for (uint64_t f = 0; f < fieldCount; ++f) {
+        FieldRecord record = readField(reader);
+        if (record.flags & kFieldBytes) {
+            // Bytes fields always take the message's bit order
+            fields.push_back({{"name", record.name}, {"bytes", record.count}});
+            continue;
+        }
+        nlohmann::json field = {{"name", record.name}, {"bit_width", record.width},
+                                {"signed", (record.flags & kSignedFlag) != 0}};
+        if (record.flags & kFieldArray) {
+            field["count"] = record.count;
+        }
+
+        // Only orders that differ from what the field would inherit are spelled out
+        BitOrder bitOrder = record.flags & kFieldMsbFirst ? BitOrder::MsbFirst : BitOrder::LsbFirst;
+        ByteOrder byteOrder = record.flags & kFieldBigEndian ? ByteOrder::Big : ByteOrder::Little;
+        ByteOrder inheritedByteOrder = record.width % 8 == 0 ? messageByteOrder : naturalByteOrder(bitOrder);
+        if (bitOrder != messageBitOrder) {
+            field["bit_order"] = bitOrderName(bitOrder);
+            defaultOrder = false;
+        }
+        if (byteOrder != inheritedByteOrder) {
+            field["byte_order"] = byteOrderName(byteOrder);
+            defaultOrder = false;
+        }
+        fields.push_back(std::move(field));
+    }
+
+    // Schemas in the default wire order keep the plain array form
+    if (defaultOrder) {
+        return fields;
+    }
+    nlohmann::json definition = {{"bit_order", bitOrderName(messageBitOrder)}, {"fields", std::move(fields)}};
+    if (messageByteOrder != naturalByteOrder(messageBitOrder)) {
+        definition["byte_order"] = byteOrderName(messageByteOrder);
+    }
+    return definition;
+}
+
+MessageConfig decodeConfig(ByteIO::Reader& reader) {
+    uint8_t messageFlags = reader.u8("message flags");
+    BitOrder messageBitOrder = messageBitOrderOf(messageFlags);
+
+    uint64_t fieldCount = reader.varint("field count");
+    if (fieldCount > reader.remaining()) {
+        reader.fail("field count out of range");
+    }
+    std::vector<FieldConfig> fields;
+    fields.reserve(static_cast<size_t>(fieldCount));
+    for (uint64_t f = 0; f < fieldCount; ++f) {
+        FieldRecord record = readField(reader);
+        if (record.width == 0 || record.width > 64 || record.count == 0 || record.count > UINT32_MAX) {
+            reader.fail("invalid size for field " + record.name);
+        }
+        FieldKind kind = record.flags & kFieldBytes ? FieldKind::Bytes
+                       : record.flags & kFieldArray ? FieldKind::Array
+                                                    : FieldKind::Scalar;
+        BitOrder bitOrder = kind == FieldKind::Bytes ? messageBitOrder
+                          : record.flags & kFieldMsbFirst ? BitOrder::MsbFirst : BitOrder::LsbFirst;
+        ByteOrder byteOrder = kind == FieldKind::Bytes ? naturalByteOrder(bitOrder)
+                            : record.flags & kFieldBigEndian ? ByteOrder::Big : ByteOrder::Little;
+        fields.emplace_back(record.name, kind, static_cast<uint8_t>(record.width),
+                            static_cast<uint32_t>(record.count), (record.flags & kSignedFlag) != 0,
+                            bitOrder, byteOrder);
+    }
+    return MessageConfig(std::move(fields), messageBitOrder, messageByteOrderOf(messageFlags));
+}
+
+} // namespace SchemaEncoding
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,97 @@
+#include "SchemaRegistry.hpp"
+#include "SchemaEncoding.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace BinaryMessageLibrary {
+
+SchemaRegistry& SchemaRegistry::global() {
+    static SchemaRegistry registry;
+    return registry;
+}
+
+MessageSchema SchemaRegistry::intern(const nlohmann::json& definition) {
+    // Object keys are stored sorted, so equal definitions serialize identically
+    std::string text = definition.dump();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto alias = aliases_.find(text);
+    if (alias != aliases_.end()) {
+        if (MessageSchema schema = alias->second.lock()) {
+            return schema;
+        }
+    }
+
+    MessageSchema schema = internBuilt(std::make_shared<const MessageConfig>(definition));
+    insert(aliases_, std::move(text), schema);
+    return schema;
+}
+
+MessageSchema SchemaRegistry::internEncoded(const uint8_t* encoded, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Snapshots hold canonical encodings, so this usually hits without decoding
+    auto it = schemas_.find(std::string(reinterpret_cast<const char*>(encoded), size));
+    if (it != schemas_.end()) {
+        if (MessageSchema schema = it->second.lock()) {
+            return schema;
+        }
+    }
+
+    ByteIO::Reader reader(encoded, 0, size, "schema");
+    auto config = std::make_shared<const MessageConfig>(SchemaEncoding::decodeConfig(reader));
+    if (reader.remaining() != 0) {
+        reader.fail("trailing bytes");
+    }
+    return internBuilt(std::move(config));
+}
+
+MessageSchema SchemaRegistry::internBuilt(MessageSchema schema) {
+    std::vector<uint8_t> encoded;
+    SchemaEncoding::encode(encoded, *schema);
+    std::string key(encoded.begin(), encoded.end());
+
+    auto it = schemas_.find(key);
+    if (it != schemas_.end()) {
+        if (MessageSchema existing = it->second.lock()) {
+            return existing;
+        }
+    }
+    insert(schemas_, std::move(key), schema);
+    return schema;
+}
+
+size_t SchemaRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t live = 0;
+    for (const auto& entry : schemas_) {
+        if (!entry.second.expired()) {
+            ++live;
+        }
+    }
+    return live;
+}
+
+void SchemaRegistry::insert(SchemaTable& table, std::string key, const MessageSchema& schema) {
+    table[std::move(key)] = schema;
+
+    // Sweep dead entries whenever the tables double, keeping insertion amortized O(1)
+    if (schemas_.size() + aliases_.size() >= prune_threshold_) {
+        pruneExpired();
+        prune_threshold_ = std::max<size_t>(16, (schemas_.size() + aliases_.size()) * 2);
+    }
+}
+
+void SchemaRegistry::pruneExpired() {
+    for (auto* table : {&schemas_, &aliases_}) {
+        for (auto it = table->begin(); it != table->end();) {
+            if (it->second.expired()) {
+                it = table->erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+} // namespace BinaryMessageLibrary
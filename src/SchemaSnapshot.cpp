@@ -0,0 +1,86 @@
+#include "SchemaSnapshot.hpp"
+#include "ByteIO.hpp"
+#include "SchemaEncoding.hpp"
+#include "SchemaRegistry.hpp"
+#include <cstring>
+#include <unordered_set>
+
+namespace BinaryMessageLibrary {
+namespace SchemaSnapshot {
+
+namespace {
+
+const uint8_t kMagic[4] = {'B', 'M', 'S', 'S'};
+constexpr size_t kHeaderSize = 4 + 1 + 8 + 8 + 8;
+
+constexpr uint64_t kFnvOffset = 0xCBF29CE484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001B3ULL;
+
+} // namespace
+
+uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = kFnvOffset;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * kFnvPrime;
+    }
+    return hash;
+}
+
+void encode(std::vector<uint8_t>& out, const TypeList& types, uint64_t sourceChecksum) {
+    std::vector<uint8_t> body;
+    ByteIO::putVarint(body, types.size());
+    std::vector<uint8_t> schema;
+    for (const auto& [name, config] : types) {
+        schema.clear();
+        SchemaEncoding::encode(schema, *config);
+        ByteIO::putString(body, name);
+        ByteIO::putVarint(body, schema.size());
+        body.insert(body.end(), schema.begin(), schema.end());
+    }
+
+    out.insert(out.end(), kMagic, kMagic + 4);
+    ByteIO::putU8(out, kVersion);
+    ByteIO::putU64(out, sourceChecksum);
+    ByteIO::putU64(out, body.size());
+    ByteIO::putU64(out, checksum(body.data(), body.size()));
+    out.insert(out.end(), body.begin(), body.end());
+}
+
+bool decode(const uint8_t* data, size_t size, uint64_t sourceChecksum, TypeList& types) {
+    if (size < kHeaderSize || std::memcmp(data, kMagic, 4) != 0 || data[4] != kVersion ||
+        ByteIO::getU64(data + 5) != sourceChecksum) {
+        return false;
+    }
+    uint64_t bodySize = ByteIO::getU64(data + 13);
+    if (bodySize != size - kHeaderSize ||
+        ByteIO::getU64(data + 21) != checksum(data + kHeaderSize, size - kHeaderSize)) {
+        return false;
+    }
+
+    ByteIO::Reader reader(data, kHeaderSize, size, "schema snapshot");
+    uint64_t typeCount = reader.varint("type count");
+    if (typeCount > reader.remaining()) {
+        reader.fail("type count out of range");
+    }
+    TypeList loaded;
+    loaded.reserve(static_cast<size_t>(typeCount));
+    std::unordered_set<std::string> names;
+    for (uint64_t t = 0; t < typeCount; ++t) {
+        std::string name = reader.string("type name");
+        uint64_t schemaSize = reader.varint("schema size");
+        const uint8_t* schema = reader.bytes(schemaSize, "schema");
+        if (!names.insert(name).second) {
+            reader.fail("duplicate type '" + name + "'");
+        }
+        loaded.emplace_back(std::move(name),
+                            SchemaRegistry::global().internEncoded(schema, static_cast<size_t>(schemaSize)));
+    }
+    if (reader.remaining() != 0) {
+        reader.fail("trailing bytes");
+    }
+    types = std::move(loaded);
+    return true;
+}
+
+} // namespace SchemaSnapshot
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,266 @@
+#include "SimdKernels.hpp"
+#include "BitCodec.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BINARY_MESSAGE_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang need the instruction set enabled per function; MSVC accepts the
+// intrinsics anywhere
+#if defined(BINARY_MESSAGE_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#define BINARY_MESSAGE_TARGET_AVX2 __attribute__((target("avx2")))
+#define BINARY_MESSAGE_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define BINARY_MESSAGE_TARGET_AVX2
+#define BINARY_MESSAGE_TARGET_AVX512
+#endif
+
+namespace BinaryMessageLibrary {
+namespace SimdKernels {
+
+namespace {
+
+void extractColumnScalar(const uint8_t* words, size_t count, size_t stride,
+                         unsigned shift, uint64_t mask, unsigned signShift, int64_t* out) {
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t raw = (BitCodec::loadLE64(words + i * stride) >> shift) & mask;
+        out[i] = static_cast<int64_t>(raw << signShift) >> signShift;
+    }
+}
+
+uint64_t matchRangeScalar(const uint8_t* words, size_t count, size_t stride,
+                          unsigned shift, uint64_t mask, uint64_t flip, uint64_t lo, uint64_t span) {
+    uint64_t matches = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = ((BitCodec::loadLE64(words + i * stride) >> shift) & mask) ^ flip;
+        matches |= static_cast<uint64_t>(key - lo <= span) << i;
+    }
+    return matches;
+}
+
+#if defined(BINARY_MESSAGE_X86_64)
+
+BINARY_MESSAGE_TARGET_AVX2
+void extractColumnAVX2(const uint8_t* words, size_t count, size_t stride,
+                       unsigned shift, uint64_t mask, unsigned signShift, int64_t* out) {
+    const long long step = static_cast<long long>(stride);
+    const __m128i shiftBy = _mm_cvtsi32_si128(static_cast<int>(shift));
+    const __m256i maskVec = _mm256_set1_epi64x(static_cast<long long>(mask));
+    // AVX2 has no 64-bit arithmetic right shift, so sign-extend the masked value
+    // with (v ^ sign) - sign; sign is 0 for unsigned fields
+    const uint64_t signBit = signShift == 0 ? 0 : 1ULL << (63 - signShift);
+    const __m256i signVec = _mm256_set1_epi64x(static_cast<long long>(signBit));
+    const __m256i advance = _mm256_set1_epi64x(4 * step);
+    __m256i offsets = _mm256_set_epi64x(3 * step, 2 * step, step, 0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(words), offsets, 1);
+        v = _mm256_and_si256(_mm256_srl_epi64(v, shiftBy), maskVec);
+        v = _mm256_sub_epi64(_mm256_xor_si256(v, signVec), signVec);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), v);
+        offsets = _mm256_add_epi64(offsets, advance);
+    }
+    extractColumnScalar(words + i * stride, count - i, stride, shift, mask, signShift, out + i);
+}
+
+BINARY_MESSAGE_TARGET_AVX512
+void extractColumnAVX512(const uint8_t* words, size_t count, size_t stride,
+                         unsigned shift, uint64_t mask, unsigned signShift, int64_t* out) {
+    const long long step = static_cast<long long>(stride);
+    const __m128i shiftBy = _mm_cvtsi32_si128(static_cast<int>(shift));
+    const __m128i signBy = _mm_cvtsi32_si128(static_cast<int>(signShift));
+    const __m512i maskVec = _mm512_set1_epi64(static_cast<long long>(mask));
+    const __m512i advance = _mm512_set1_epi64(8 * step);
+    __m512i offsets = _mm512_set_epi64(7 * step, 6 * step, 5 * step, 4 * step,
+                                       3 * step, 2 * step, step, 0);
+    // The unmasked gather and shifts merge into an undefined vector in GCC's
+    // headers, which -Wall reports as uninitialized; the masked forms with a
+    // zero source and all lanes enabled compile to the same instructions
+    const __m512i zero = _mm512_setzero_si512();
+    const __mmask8 all = 0xFF;
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i v = _mm512_mask_i64gather_epi64(zero, all, offsets, words, 1);
+        v = _mm512_and_si512(_mm512_maskz_srl_epi64(all, v, shiftBy), maskVec);
+        v = _mm512_maskz_sra_epi64(all, _mm512_maskz_sll_epi64(all, v, signBy), signBy);
+        _mm512_storeu_si512(out + i, v);
+        offsets = _mm512_add_epi64(offsets, advance);
+    }
+    extractColumnScalar(words + i * stride, count - i, stride, shift, mask, signShift, out + i);
+}
+
+BINARY_MESSAGE_TARGET_AVX2
+uint64_t matchRangeAVX2(const uint8_t* words, size_t count, size_t stride,
+                        unsigned shift, uint64_t mask, uint64_t flip, uint64_t lo, uint64_t span) {
+    const long long step = static_cast<long long>(stride);
+    const __m128i shiftBy = _mm_cvtsi32_si128(static_cast<int>(shift));
+    const __m256i maskVec = _mm256_set1_epi64x(static_cast<long long>(mask));
+    const __m256i flipVec = _mm256_set1_epi64x(static_cast<long long>(flip));
+    const __m256i loVec = _mm256_set1_epi64x(static_cast<long long>(lo));
+    // AVX2 only compares signed 64-bit lanes; biasing both sides by 2^63 turns
+    // that into the unsigned comparison
+    const __m256i bias = _mm256_set1_epi64x(static_cast<long long>(1ULL << 63));
+    const __m256i spanVec = _mm256_set1_epi64x(static_cast<long long>(span ^ (1ULL << 63)));
+    const __m256i advance = _mm256_set1_epi64x(4 * step);
+    __m256i offsets = _mm256_set_epi64x(3 * step, 2 * step, step, 0);
+
+    uint64_t matches = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(words), offsets, 1);
+        v = _mm256_and_si256(_mm256_srl_epi64(v, shiftBy), maskVec);
+        v = _mm256_sub_epi64(_mm256_xor_si256(v, flipVec), loVec);
+        __m256i outside = _mm256_cmpgt_epi64(_mm256_xor_si256(v, bias), spanVec);
+        auto bits = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(outside)));
+        matches |= static_cast<uint64_t>(~bits & 0xF) << i;
+        offsets = _mm256_add_epi64(offsets, advance);
+    }
+    if (i < count) {
+        matches |= matchRangeScalar(words + i * stride, count - i, stride, shift, mask, flip, lo, span) << i;
+    }
+    return matches;
+}
+
+BINARY_MESSAGE_TARGET_AVX512
+uint64_t matchRangeAVX512(const uint8_t* words, size_t count, size_t stride,
+                          unsigned shift, uint64_t mask, uint64_t flip, uint64_t lo, uint64_t span) {
+    const long long step = static_cast<long long>(stride);
+    const __m128i shiftBy = _mm_cvtsi32_si128(static_cast<int>(shift));
+    const __m512i maskVec = _mm512_set1_epi64(static_cast<long long>(mask));
+    const __m512i flipVec = _mm512_set1_epi64(static_cast<long long>(flip));
+    const __m512i loVec = _mm512_set1_epi64(static_cast<long long>(lo));
+    const __m512i spanVec = _mm512_set1_epi64(static_cast<long long>(span));
+    const __m512i advance = _mm512_set1_epi64(8 * step);
+    __m512i offsets = _mm512_set_epi64(7 * step, 6 * step, 5 * step, 4 * step,
+                                       3 * step, 2 * step, step, 0);
+    // Masked forms for the same reason as in extractColumnAVX512
+    const __m512i zero = _mm512_setzero_si512();
+    const __mmask8 all = 0xFF;
+
+    uint64_t matches = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i v = _mm512_mask_i64gather_epi64(zero, all, offsets, words, 1);
+        v = _mm512_and_si512(_mm512_maskz_srl_epi64(all, v, shiftBy), maskVec);
+        v = _mm512_sub_epi64(_mm512_xor_si512(v, flipVec), loVec);
+        matches |= static_cast<uint64_t>(_mm512_cmple_epu64_mask(v, spanVec)) << i;
+        offsets = _mm512_add_epi64(offsets, advance);
+    }
+    if (i < count) {
+        matches |= matchRangeScalar(words + i * stride, count - i, stride, shift, mask, flip, lo, span) << i;
+    }
+    return matches;
+}
+
+#endif
+
+SimdLevel detect() {
+#if defined(BINARY_MESSAGE_X86_64) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    return SimdLevel::Scalar;
+#elif defined(BINARY_MESSAGE_X86_64) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return SimdLevel::Scalar;
+    }
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave) {
+        return SimdLevel::Scalar;
+    }
+    // The OS must save the YMM (and for AVX-512 the opmask/ZMM) state
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+    bool avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+    if (avx512) {
+        return SimdLevel::AVX512;
+    }
+    return avx2 ? SimdLevel::AVX2 : SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+} // namespace
+
+SimdLevel detectSimdLevel() {
+    return detect();
+}
+
+SimdLevel activeSimdLevel() {
+    static const SimdLevel level = detect();
+    return level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512:
+            return "avx512";
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::Scalar:
+        default:
+            return "scalar";
+    }
+}
+
+void extractColumn(const uint8_t* words, size_t count, size_t stride,
+                   unsigned shift, uint64_t mask, unsigned signShift, int64_t* out) {
+    extractColumn(activeSimdLevel(), words, count, stride, shift, mask, signShift, out);
+}
+
+void extractColumn(SimdLevel level, const uint8_t* words, size_t count, size_t stride,
+                   unsigned shift, uint64_t mask, unsigned signShift, int64_t* out) {
+    if (level > activeSimdLevel()) {
+        level = activeSimdLevel();
+    }
+#if defined(BINARY_MESSAGE_X86_64)
+    if (level == SimdLevel::AVX512) {
+        extractColumnAVX512(words, count, stride, shift, mask, signShift, out);
+        return;
+    }
+    if (level == SimdLevel::AVX2) {
+        extractColumnAVX2(words, count, stride, shift, mask, signShift, out);
+        return;
+    }
+#endif
+    extractColumnScalar(words, count, stride, shift, mask, signShift, out);
+}
+
+uint64_t matchRange(const uint8_t* words, size_t count, size_t stride,
+                    unsigned shift, uint64_t mask, uint64_t flip, uint64_t lo, uint64_t span) {
+    return matchRange(activeSimdLevel(), words, count, stride, shift, mask, flip, lo, span);
+}
+
+uint64_t matchRange(SimdLevel level, const uint8_t* words, size_t count, size_t stride,
+                    unsigned shift, uint64_t mask, uint64_t flip, uint64_t lo, uint64_t span) {
+    if (level > activeSimdLevel()) {
+        level = activeSimdLevel();
+    }
+#if defined(BINARY_MESSAGE_X86_64)
+    if (level == SimdLevel::AVX512) {
+        return matchRangeAVX512(words, count, stride, shift, mask, flip, lo, span);
+    }
+    if (level == SimdLevel::AVX2) {
+        return matchRangeAVX2(words, count, stride, shift, mask, flip, lo, span);
+    }
+#endif
+    return matchRangeScalar(words, count, stride, shift, mask, flip, lo, span);
+}
+
+} // namespace SimdKernels
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,116 @@
+#include "StreamDecoder.hpp"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace BinaryMessageLibrary {
+
+StreamDecoder::StreamDecoder(const MessageConfig& config, size_t threadCount, size_t chunkFrames)
+    : codec_(config), chunk_frames_(chunkFrames), pool_(threadCount) {
+    if (chunk_frames_ == 0) {
+        throw std::runtime_error("Chunk size must be at least one frame");
+    }
+    if (codec_.getFrameSize() == 0) {
+        throw std::runtime_error("Cannot decode a stream of empty frames");
+    }
+    // Scratch columns are only needed by forEachChunk(), allocate them lazily
+    scratch_.resize(pool_.getThreadCount());
+    for (auto& scratch : scratch_) {
+        scratch.pointers.resize(codec_.getColumnCount());
+        scratch.outputs.resize(codec_.getColumnCount());
+    }
+}
+
+size_t StreamDecoder::getFrameCount(size_t size) const {
+    return size / codec_.getFrameSize();
+}
+
+size_t StreamDecoder::decode(const uint8_t* data, size_t size, int64_t* const* columns) {
+    size_t frames = getFrameCount(size);
+    size_t frameSize = codec_.getFrameSize();
+    size_t chunks = (frames + chunk_frames_ - 1) / chunk_frames_;
+
+    // Columns are indexed by frame, so writing each chunk at its own offset
+    // keeps the output in input order without any coordination
+    pool_.run(chunks, [&](size_t chunk, size_t worker) {
+        size_t first = chunk * chunk_frames_;
+        size_t count = std::min(chunk_frames_, frames - first);
+        auto& outputs = scratch_[worker].outputs;
+        for (size_t f = 0; f < outputs.size(); ++f) {
+            outputs[f] = columns[f] + first;
+        }
+        codec_.decode(data + first * frameSize, count, frameSize, outputs.data());
+    });
+    return frames;
+}
+
+std::vector<std::vector<int64_t>> StreamDecoder::decode(const uint8_t* data, size_t size) {
+    std::vector<std::vector<int64_t>> columns(codec_.getColumnCount(),
+                                              std::vector<int64_t>(getFrameCount(size)));
+    std::vector<int64_t*> pointers;
+    pointers.reserve(columns.size());
+    for (auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+    decode(data, size, pointers.data());
+    return columns;
+}
+
+void StreamDecoder::forEachChunk(const uint8_t* data, size_t size,
+                                 const std::function<void(const DecodedChunk&)>& consumer,
+                                 StreamOrder order) {
+    size_t frames = getFrameCount(size);
+    size_t frameSize = codec_.getFrameSize();
+    size_t chunks = (frames + chunk_frames_ - 1) / chunk_frames_;
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<bool> aborted{false};
+
+    pool_.run(chunks, [&](size_t chunk, size_t worker) {
+        size_t first = chunk * chunk_frames_;
+        size_t count = std::min(chunk_frames_, frames - first);
+        Scratch& scratch = scratch_[worker];
+        if (scratch.columns.empty()) {
+            scratch.columns.assign(codec_.getColumnCount(), std::vector<int64_t>(chunk_frames_));
+            for (size_t f = 0; f < scratch.columns.size(); ++f) {
+                scratch.pointers[f] = scratch.columns[f].data();
+            }
+        }
+
+        try {
+            codec_.decode(data + first * frameSize, count, frameSize, scratch.pointers.data());
+
+            if (order == StreamOrder::InputOrder) {
+                // Workers take chunks in ascending order from their ranges, so the
+                // chunk being waited for is always held by a running worker
+                while (nextChunk.load(std::memory_order_acquire) != chunk) {
+                    if (aborted.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+
+            DecodedChunk decoded{first, count, scratch.pointers.data(), worker};
+            consumer(decoded);
+        } catch (...) {
+            aborted.store(true, std::memory_order_relaxed);
+            throw;
+        }
+        nextChunk.store(chunk + 1, std::memory_order_release);
+    });
+}
+
+size_t StreamDecoder::getThreadCount() const {
+    return pool_.getThreadCount();
+}
+
+size_t StreamDecoder::getChunkFrames() const {
+    return chunk_frames_;
+}
+
+const BatchCodec& StreamDecoder::getCodec() const {
+    return codec_;
+}
+
+} // namespace BinaryMessageLibrary
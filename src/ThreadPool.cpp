@@ -0,0 +1,154 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace BinaryMessageLibrary {
+
+namespace {
+
+uint64_t packRange(uint32_t begin, uint32_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | end;
+}
+
+uint32_t rangeBegin(uint64_t range) {
+    return static_cast<uint32_t>(range >> 32);
+}
+
+uint32_t rangeEnd(uint64_t range) {
+    return static_cast<uint32_t>(range);
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount)
+    : thread_count_(threadCount != 0 ? threadCount : std::max<size_t>(1, std::thread::hardware_concurrency())),
+      ranges_(new WorkRange[thread_count_]) {
+    threads_.reserve(thread_count_ - 1);
+    for (size_t worker = 1; worker < thread_count_; ++worker) {
+        threads_.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return thread_count_;
+}
+
+void ThreadPool::run(size_t taskCount, const Task& task) {
+    if (taskCount > UINT32_MAX) {
+        throw std::runtime_error("Too many tasks for thread pool");
+    }
+    if (taskCount == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> runLock(run_mutex_);
+    uint32_t count = static_cast<uint32_t>(taskCount);
+    for (size_t worker = 0; worker < thread_count_; ++worker) {
+        auto begin = static_cast<uint32_t>(count * worker / thread_count_);
+        auto end = static_cast<uint32_t>(count * (worker + 1) / thread_count_);
+        ranges_[worker].range.store(packRange(begin, end), std::memory_order_relaxed);
+    }
+    task_ = &task;
+    failed_.store(false, std::memory_order_relaxed);
+    error_ = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        busy_workers_ = thread_count_ - 1;
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    done_cv_.wait(lock, [this] { return busy_workers_ == 0; });
+    task_ = nullptr;
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void ThreadPool::workerLoop(size_t worker) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(state_mutex_);
+            start_cv_.wait(lock, [this, seen] { return stopping_ || generation_ != seen; });
+            if (stopping_) {
+                return;
+            }
+            seen = generation_;
+        }
+
+        work(worker);
+
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        if (--busy_workers_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::work(size_t worker) {
+    uint32_t task;
+    while (takeOwn(worker, task) || steal(worker, task)) {
+        if (failed_.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        try {
+            (*task_)(task, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool ThreadPool::takeOwn(size_t worker, uint32_t& task) {
+    auto& slot = ranges_[worker].range;
+    uint64_t range = slot.load(std::memory_order_acquire);
+    while (rangeBegin(range) < rangeEnd(range)) {
+        if (slot.compare_exchange_weak(range, packRange(rangeBegin(range) + 1, rangeEnd(range)),
+                                       std::memory_order_acq_rel)) {
+            task = rangeBegin(range);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::steal(size_t worker, uint32_t& task) {
+    for (size_t offset = 1; offset < thread_count_; ++offset) {
+        auto& victim = ranges_[(worker + offset) % thread_count_].range;
+        uint64_t range = victim.load(std::memory_order_acquire);
+        while (rangeBegin(range) < rangeEnd(range)) {
+            uint32_t begin = rangeBegin(range);
+            uint32_t end = rangeEnd(range);
+            uint32_t mid = begin + (end - begin) / 2;
+            if (victim.compare_exchange_weak(range, packRange(begin, mid), std::memory_order_acq_rel)) {
+                // Our own range is empty, so nobody else can be taking from it
+                ranges_[worker].range.store(packRange(mid + 1, end), std::memory_order_release);
+                task = mid;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace BinaryMessageLibrary
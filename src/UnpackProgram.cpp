@@ -0,0 +1,114 @@
+#include "UnpackProgram.hpp"
+#include "BitCodec.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BINARY_MESSAGE_THREADED_DISPATCH 1
+#endif
+
+namespace BinaryMessageLibrary {
+
+UnpackProgram::UnpackProgram() {
+    instructions_.push_back(Instruction{Op::End, 0, 0, 0, 0, 0});
+}
+
+UnpackProgram::UnpackProgram(const MessageLayout& layout) {
+    bool msbFirst = layout.getBitOrder() == BitOrder::MsbFirst;
+    size_t totalBytes = layout.getTotalBytes();
+    // Byte the register was loaded from; none yet
+    size_t window = SIZE_MAX;
+
+    for (size_t i = 0; i < layout.size(); ++i) {
+        uint32_t slot = static_cast<uint32_t>(i);
+        uint8_t flags = layout.orderFlags()[i];
+        if (flags & MessageLayout::kBlock) {
+            instructions_.push_back(Instruction{Op::Block, 0, 0, 0, slot, 0});
+            continue;
+        }
+        if ((flags & ~MessageLayout::kMsbFirst) != 0 || layout.crossesWord()[i] != 0) {
+            instructions_.push_back(Instruction{Op::Extract, 0, 0, 0, slot, 0});
+            continue;
+        }
+
+        size_t byteOffset = layout.byteOffsets()[i];
+        unsigned width = layout.bitWidths()[i];
+        size_t startBit = byteOffset * 8 + layout.shifts()[i];
+        if (window == SIZE_MAX || startBit + width > window * 8 + 64) {
+            window = byteOffset;
+            size_t available = totalBytes - window;
+            if (available >= 8) {
+                instructions_.push_back(Instruction{msbFirst ? Op::WordMsb : Op::Word, 0, 0, 0, 0,
+                                                    static_cast<uint32_t>(window)});
+            } else {
+                instructions_.push_back(Instruction{msbFirst ? Op::WordMsbTail : Op::WordTail, 0, 0,
+                                                    static_cast<uint8_t>(available), 0,
+                                                    static_cast<uint32_t>(window)});
+            }
+        }
+
+        // Shift the field to the top of the register, then down to bit 0
+        unsigned position = static_cast<unsigned>(startBit - window * 8);
+        unsigned left = msbFirst ? position : 64 - position - width;
+        Op op = layout.signShifts()[i] != 0 ? Op::Signed : Op::Unsigned;
+        instructions_.push_back(Instruction{op, static_cast<uint8_t>(left), static_cast<uint8_t>(64 - width),
+                                            0, slot, 0});
+    }
+    instructions_.push_back(Instruction{Op::End, 0, 0, 0, 0, 0});
+}
+
+void UnpackProgram::run(const MessageLayout& layout, const uint8_t* buffer, size_t size,
+                        int64_t* values, uint8_t* blocks) const {
+    const Instruction* ip = instructions_.data();
+    uint64_t word = 0;
+
+#if defined(BINARY_MESSAGE_THREADED_DISPATCH)
+    // Indexed by Op
+    static const void* const kDispatch[] = {&&word_le, &&word_le_tail, &&word_be, &&word_be_tail,
+                                            &&store_unsigned, &&store_signed, &&extract, &&block, &&end};
+#define BINARY_MESSAGE_DISPATCH() goto *kDispatch[static_cast<size_t>(ip->op)]
+#define BINARY_MESSAGE_CASE(label, opcode) label:
+#define BINARY_MESSAGE_NEXT() ++ip; BINARY_MESSAGE_DISPATCH()
+    BINARY_MESSAGE_DISPATCH();
+#else
+#define BINARY_MESSAGE_CASE(label, opcode) case Op::opcode:
+#define BINARY_MESSAGE_NEXT() ++ip; continue
+    for (;;) {
+        switch (ip->op) {
+#endif
+
+    BINARY_MESSAGE_CASE(word_le, Word)
+        word = BitCodec::loadLE64(buffer + ip->offset);
+        BINARY_MESSAGE_NEXT();
+    BINARY_MESSAGE_CASE(word_le_tail, WordTail)
+        word = BitCodec::loadLEPartial(buffer + ip->offset, ip->count);
+        BINARY_MESSAGE_NEXT();
+    BINARY_MESSAGE_CASE(word_be, WordMsb)
+        word = BitCodec::loadBE64(buffer + ip->offset);
+        BINARY_MESSAGE_NEXT();
+    BINARY_MESSAGE_CASE(word_be_tail, WordMsbTail)
+        word = BitCodec::loadBEPartial(buffer + ip->offset, ip->count);
+        BINARY_MESSAGE_NEXT();
+    BINARY_MESSAGE_CASE(store_unsigned, Unsigned)
+        values[ip->slot] = static_cast<int64_t>((word << ip->left) >> ip->right);
+        BINARY_MESSAGE_NEXT();
+    BINARY_MESSAGE_CASE(store_signed, Signed)
+        values[ip->slot] = static_cast<int64_t>(word << ip->left) >> ip->right;
+        BINARY_MESSAGE_NEXT();
+    BINARY_MESSAGE_CASE(extract, Extract)
+        values[ip->slot] = layout.extract(ip->slot, buffer, size);
+        BINARY_MESSAGE_NEXT();
+    BINARY_MESSAGE_CASE(block, Block)
+        layout.extractBlock(ip->slot, buffer, size, blocks + layout.blockOffsets()[ip->slot]);
+        BINARY_MESSAGE_NEXT();
+    BINARY_MESSAGE_CASE(end, End)
+        return;
+
+#if !defined(BINARY_MESSAGE_THREADED_DISPATCH)
+        }
+    }
+#endif
+#undef BINARY_MESSAGE_DISPATCH
+#undef BINARY_MESSAGE_CASE
+#undef BINARY_MESSAGE_NEXT
+}
+
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,36 @@
+#include "AllocationCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+// Kept in its own translation unit, so the compiler never inlines these
+// replacements into code whose allocations it can see
+
+namespace {
+thread_local size_t allocations = 0;
+}
+
+void* operator new(size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace BinaryMessageLibrary {
+namespace Testing {
+
+size_t allocationCount() {
+    return allocations;
+}
+
+} // namespace Testing
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+namespace BinaryMessageLibrary {
+namespace Testing {
+
+/**
+ * @brief Gets the number of heap allocations the calling thread has made.
+ *
+ * Counted by the global operator new replaced in AllocationCounter.cpp, which
+ * is linked only into the allocation test executable.
+ *
+ * @return size_t Allocations made through operator new so far.
+ */
+size_t allocationCount();
+
+} // namespace Testing
+} // namespace BinaryMessageLibrary
@@ -0,0 +1,151 @@
+#include "BatchCodec.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+using namespace BinaryMessageLibrary;
+
+class BatchCodecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Mix of widths, signedness and a field that crosses a word boundary
+        nlohmann::json config = R"([
+            {"name": "sensor_id", "bit_width": 6, "signed": false},
+            {"name": "temperature", "bit_width": 10, "signed": true},
+            {"name": "pad", "bit_width": 3, "signed": false},
+            {"name": "wide", "bit_width": 62, "signed": true},
+            {"name": "flags", "bit_width": 8, "signed": false}
+        ])"_json;
+
+        messageConfig = std::make_unique<MessageConfig>(config);
+    }
+
+    // Random frames packed one at a time through BinaryMessage
+    std::vector<uint8_t> makeFrames(size_t count, size_t stride, std::vector<std::vector<int64_t>>& expected) {
+        std::mt19937_64 rng(7);
+        std::vector<uint8_t> frames(count * stride, 0xCC);
+        expected.assign(messageConfig->getFields().size(), std::vector<int64_t>(count));
+
+        BinaryMessage message(*messageConfig);
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t f = 0; f < messageConfig->getFields().size(); ++f) {
+                const auto& field = messageConfig->getFields()[f];
+                uint64_t range = static_cast<uint64_t>(field.getMaxValue() - field.getMinValue()) + 1;
+                int64_t value = field.getMinValue() + static_cast<int64_t>(rng() % range);
+                message.setField(field.name(), value);
+                expected[f][i] = value;
+            }
+            message.packInto(frames.data() + i * stride, stride);
+        }
+        return frames;
+    }
+
+    std::unique_ptr<MessageConfig> messageConfig;
+};
+
+TEST_F(BatchCodecTest, DecodeMatchesBinaryMessage) {
+    BatchCodec codec(*messageConfig);
+    ASSERT_EQ(codec.getFrameSize(), 12u);
+    ASSERT_EQ(codec.getColumnCount(), 5u);
+
+    std::vector<std::vector<int64_t>> expected;
+    auto frames = makeFrames(100, codec.getFrameSize(), expected);
+
+    auto columns = codec.decode(frames.data(), 100, codec.getFrameSize());
+    EXPECT_EQ(columns, expected);
+}
+
+TEST_F(BatchCodecTest, DecodeWithPaddedStride) {
+    BatchCodec codec(*messageConfig);
+
+    std::vector<std::vector<int64_t>> expected;
+    auto frames = makeFrames(33, 16, expected);
+
+    // Only the last frame's packed bytes are required to be present
+    frames.resize(32 * 16 + codec.getFrameSize());
+    auto columns = codec.decode(frames.data(), 33, 16);
+    EXPECT_EQ(columns, expected);
+}
+
+TEST_F(BatchCodecTest, EncodeMatchesBinaryMessage) {
+    BatchCodec codec(*messageConfig);
+    const size_t stride = 14;
+
+    std::vector<std::vector<int64_t>> columns;
+    auto expected = makeFrames(50, stride, columns);
+
+    std::vector<const int64_t*> pointers;
+    for (const auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+    std::vector<uint8_t> frames(50 * stride, 0xCC);
+    codec.encode(pointers.data(), 50, frames.data(), stride);
+
+    // The padding between frames is left as the caller had it
+    EXPECT_EQ(frames, expected);
+}
+
+TEST_F(BatchCodecTest, StrideSmallerThanFrameThrows) {
+    BatchCodec codec(*messageConfig);
+    std::vector<uint8_t> frames(64);
+    std::vector<std::vector<int64_t>> columns(codec.getColumnCount(), std::vector<int64_t>(4));
+    std::vector<int64_t*> pointers;
+    for (auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+
+    EXPECT_THROW(codec.decode(frames.data(), 4, 8, pointers.data()), std::runtime_error);
+    EXPECT_NO_THROW(codec.decode(frames.data(), 0, 8, pointers.data()));
+}
+
+TEST(BatchCodecBlockTest, RejectsArrayAndBytesFields) {
+    // One int64_t column per field cannot hold an array or a blob
+    MessageConfig arrays(R"([{"name": "samples", "bit_width": 12, "signed": true, "count": 4}])"_json);
+    MessageConfig blobs(R"([{"name": "id", "bit_width": 128, "signed": false}])"_json);
+    EXPECT_THROW(BatchCodec codec(arrays), std::runtime_error);
+    EXPECT_THROW(BatchCodec codec(blobs), std::runtime_error);
+}
+
+TEST(BatchCodecWireOrderTest, DecodeMatchesBinaryMessage) {
+    // MSB-first message with fields in every order, including a word-crossing one
+    MessageConfig config(R"({"bit_order": "msb_first", "fields": [
+        {"name": "flags", "bit_width": 5, "signed": false},
+        {"name": "wide", "bit_width": 62, "signed": true},
+        {"name": "length", "bit_width": 16, "signed": false},
+        {"name": "crc", "bit_width": 16, "signed": false, "byte_order": "little"},
+        {"name": "mask", "bit_width": 11, "signed": true, "bit_order": "lsb_first"}
+    ]})"_json);
+    BatchCodec codec(config);
+    size_t count = 100;
+    size_t frameSize = codec.getFrameSize();
+
+    std::mt19937_64 rng(11);
+    std::vector<std::vector<int64_t>> columns(config.getFields().size(), std::vector<int64_t>(count));
+    for (size_t f = 0; f < columns.size(); ++f) {
+        const auto& field = config.getFields()[f];
+        uint64_t range = static_cast<uint64_t>(field.getMaxValue() - field.getMinValue()) + 1;
+        for (auto& value : columns[f]) {
+            value = field.getMinValue() + static_cast<int64_t>(rng() % range);
+        }
+    }
+
+    std::vector<const int64_t*> pointers;
+    for (const auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+    std::vector<uint8_t> frames(count * frameSize);
+    codec.encode(pointers.data(), count, frames.data(), frameSize);
+
+    BinaryMessage message(config);
+    for (size_t i = 0; i < count; ++i) {
+        message.unpackFrom(frames.data() + i * frameSize, frameSize);
+        for (size_t f = 0; f < columns.size(); ++f) {
+            ASSERT_EQ(message.getField(config.getFields()[f].name()), columns[f][i]);
+        }
+    }
+    EXPECT_EQ(codec.decode(frames.data(), count, frameSize), columns);
+}
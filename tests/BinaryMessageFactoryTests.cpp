@@ -1,8 +1,12 @@
 #include "BinaryMessageFactory.hpp"
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
+#include <atomic>
 #include <fstream>
+#include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace BinaryMessageLibrary;
 
@@ -195,4 +199,88 @@ TEST_F(BinaryMessageFactoryTest, InvalidFieldDefinition) {
     EXPECT_THROW({
         BinaryMessageFactory factory(config);
     }, std::runtime_error);
-} 
\ No newline at end of file
+}
+
+TEST_F(BinaryMessageFactoryTest, ReloadReplacesTypeTable) {
+    BinaryMessageFactory factory(validConfig);
+    auto oldMessage = factory.createMessage("sensor_data");
+    auto pooled = factory.acquire("sensor_data");
+    MessageSchema statusSchema = factory.getSchema("status_message");
+
+    nlohmann::json updated = validConfig;
+    updated.erase("status_message");
+    updated["sensor_data"].push_back({{"name", "humidity"}, {"bit_width", 7u}, {"signed", false}});
+    updated["heartbeat"] = R"([{"name": "seq", "bit_width": 16, "signed": false}])"_json;
+    factory.loadConfigurations(updated);
+
+    EXPECT_FALSE(factory.hasMessageType("status_message"));
+    EXPECT_TRUE(factory.hasMessageType("heartbeat"));
+    EXPECT_EQ(factory.getMessageConfig("sensor_data").getFields().size(), 3u);
+
+    // Messages created before the reload keep their schema
+    EXPECT_EQ(oldMessage->getConfig().getFields().size(), 2u);
+    EXPECT_EQ(pooled->getConfig().getFields().size(), 2u);
+    EXPECT_EQ(statusSchema->getFields().size(), 2u);
+    pooled.reset();
+
+    EXPECT_EQ(factory.acquire("sensor_data")->getConfig().getFields().size(), 3u);
+
+    // A failed reload leaves the factory untouched
+    EXPECT_THROW(factory.loadConfigurations(invalidConfig), std::runtime_error);
+    EXPECT_TRUE(factory.hasMessageType("heartbeat"));
+    EXPECT_EQ(factory.getMessageTypes().size(), 2u);
+}
+
+TEST_F(BinaryMessageFactoryTest, ReloadReleasesIdleRetiredPools) {
+    BinaryMessageFactory factory(validConfig);
+    std::weak_ptr<const MessageConfig> original = factory.getSchema("sensor_data");
+    auto pooled = factory.acquire("sensor_data");
+
+    nlohmann::json wider = validConfig;
+    wider["sensor_data"].push_back({{"name", "humidity"}, {"bit_width", 7u}, {"signed", false}});
+    nlohmann::json widest = wider;
+    widest["sensor_data"].push_back({{"name", "pressure"}, {"bit_width", 9u}, {"signed", false}});
+
+    // A retired pool with a message handed out is kept across reloads
+    factory.loadConfigurations(wider);
+    factory.loadConfigurations(widest);
+    EXPECT_FALSE(original.expired());
+
+    // Once the message is back, the next reload releases the pool and its schema
+    pooled.reset();
+    factory.loadConfigurations(wider);
+    EXPECT_TRUE(original.expired());
+    EXPECT_EQ(factory.acquire("sensor_data")->getConfig().getFields().size(), 3u);
+}
+
+TEST_F(BinaryMessageFactoryTest, ReloadWhileReading) {
+    BinaryMessageFactory factory(validConfig);
+    nlohmann::json wider = validConfig;
+    wider["sensor_data"].push_back({{"name", "humidity"}, {"bit_width", 7u}, {"signed", false}});
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&factory, &done]() {
+            while (!done.load()) {
+                auto message = factory.createMessage("sensor_data");
+                size_t fields = message->getConfig().getFields().size();
+                EXPECT_TRUE(fields == 2 || fields == 3);
+                message->setField("temperature", -5);
+                EXPECT_EQ(message->pack().size(), fields == 2 ? 2u : 3u);
+
+                auto pooled = factory.acquire("status_message");
+                pooled->setField("status_code", 9);
+            }
+        });
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        factory.loadConfigurations(i % 2 == 0 ? wider : validConfig);
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(factory.getMessageConfig("sensor_data").getFields().size(), 2u);
+}
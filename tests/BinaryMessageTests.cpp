@@ -1,14 +1,52 @@
 #include "BinaryMessage.hpp"
+#include "BitCodec.hpp"
 #include "MessageConfig.hpp"
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <fstream>
+#include <random>
 #include <sstream>
 #include <vector>
 #include <cstdint>
 
 using namespace BinaryMessageLibrary;
 
+namespace {
+
+// Reference model of the wire orders, one bit at a time. A field's bits are
+// emitted as its bytes in byte order, each byte's bits in bit order (widths
+// that are not a multiple of 8 form a single run in bit order), and land on
+// consecutive message bits numbered in the message's bit order. Array and
+// Bytes fields are their elements one after the other; @p values holds every
+// element of every field in order.
+std::vector<uint8_t> referencePack(const MessageConfig& config, const std::vector<int64_t>& values) {
+    std::vector<uint8_t> buffer((config.getTotalBits() + 7) / 8);
+    size_t position = 0;
+    size_t next = 0;
+    for (const FieldConfig& field : config.getFields()) {
+        unsigned width = field.bit_width();
+        unsigned chunk = width % 8 == 0 ? 8 : width;
+        for (uint32_t element = 0; element < field.getCount(); ++element) {
+            uint64_t value = static_cast<uint64_t>(values[next++]);
+            for (unsigned c = 0; c < width / chunk; ++c) {
+                unsigned chunkIndex = field.getByteOrder() == ByteOrder::Big ? width / chunk - 1 - c : c;
+                for (unsigned b = 0; b < chunk; ++b) {
+                    unsigned bitInChunk = field.getBitOrder() == BitOrder::MsbFirst ? chunk - 1 - b : b;
+                    bool bit = (value >> (chunkIndex * chunk + bitInChunk)) & 1;
+                    size_t byte = position / 8;
+                    unsigned shift = config.getBitOrder() == BitOrder::MsbFirst ? 7 - position % 8 : position % 8;
+                    buffer[byte] |= static_cast<uint8_t>(bit << shift);
+                    ++position;
+                }
+            }
+        }
+    }
+    return buffer;
+}
+
+} // namespace
+
 class BinaryMessageTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -136,4 +174,341 @@ TEST_F(BinaryMessageTest, PackUnpackMultipleMessages) {
     EXPECT_EQ(unpacked1->getField("field2"), -3);
     EXPECT_EQ(unpacked2->getField("field1"), 100);
     EXPECT_EQ(unpacked2->getField("field2"), 5);
-} 
\ No newline at end of file
+}
+
+TEST_F(BinaryMessageTest, PackedLayoutIsLsbFirst) {
+    auto message = std::make_unique<BinaryMessage>(*messageConfig);
+
+    message->setField("field1", 0xA5);
+    message->setField("field2", -3);  // 0b1101 in 4 bits
+
+    auto buffer = message->pack();
+
+    ASSERT_EQ(buffer.size(), 2u);
+    EXPECT_EQ(buffer[0], 0xA5);
+    EXPECT_EQ(buffer[1], 0x0D);
+}
+
+TEST(BinaryMessageLayoutTest, FieldsStraddlingWordBoundaries) {
+    // 3 + 64 + 61 + 7 bits: the 64-bit fields start mid-byte and spill
+    // past the 8-byte word loaded at their first byte
+    nlohmann::json config = R"([
+        {"name": "head", "bit_width": 3, "signed": false},
+        {"name": "wide", "bit_width": 64, "signed": true},
+        {"name": "odd", "bit_width": 61, "signed": false},
+        {"name": "tail", "bit_width": 7, "signed": true}
+    ])"_json;
+    MessageConfig messageConfig(config);
+
+    BinaryMessage message(messageConfig);
+    message.setField("head", 5);
+    message.setField("wide", INT64_MIN + 12345);
+    message.setField("odd", (1LL << 61) - 2);
+    message.setField("tail", -64);
+
+    auto buffer = message.pack();
+    ASSERT_EQ(buffer.size(), 17u);
+
+    // Reassemble every field bit by bit to check the word codec against
+    // the reference LSB-first layout
+    auto readBits = [&buffer](size_t offset, size_t width) {
+        uint64_t value = 0;
+        for (size_t bit = 0; bit < width; ++bit) {
+            size_t pos = offset + bit;
+            if (buffer[pos / 8] & (1 << (pos % 8))) {
+                value |= 1ULL << bit;
+            }
+        }
+        return value;
+    };
+    EXPECT_EQ(readBits(0, 3), 5u);
+    EXPECT_EQ(readBits(3, 64), static_cast<uint64_t>(INT64_MIN + 12345));
+    EXPECT_EQ(readBits(67, 61), static_cast<uint64_t>((1LL << 61) - 2));
+    EXPECT_EQ(readBits(128, 7), 0x40u);
+
+    BinaryMessage unpacked(messageConfig);
+    unpacked.unpack(buffer);
+    EXPECT_EQ(unpacked.getField("head"), 5);
+    EXPECT_EQ(unpacked.getField("wide"), INT64_MIN + 12345);
+    EXPECT_EQ(unpacked.getField("odd"), (1LL << 61) - 2);
+    EXPECT_EQ(unpacked.getField("tail"), -64);
+}
+
+TEST_F(BinaryMessageTest, FieldHandleOperations) {
+    BinaryMessage message(*messageConfig);
+    FieldHandle field1 = messageConfig->getFieldHandle("field1");
+    FieldHandle field2 = messageConfig->getFieldHandle("field2");
+
+    message.setField(field1, 200);
+    message.setField(field2, -8);
+    EXPECT_EQ(message.getField(field1), 200);
+    EXPECT_EQ(message.getField(field2), -8);
+    EXPECT_EQ(message.getField("field1"), 200);
+
+    // Range validation still applies
+    EXPECT_THROW(message.setField(field1, 256), std::runtime_error);
+    EXPECT_THROW(message.setField(field2, 8), std::runtime_error);
+
+    // Unresolved and foreign handles are rejected
+    EXPECT_THROW(message.setField(FieldHandle(), 0), std::runtime_error);
+    EXPECT_THROW(message.getField(FieldHandle(7)), std::runtime_error);
+}
+
+TEST_F(BinaryMessageTest, PackIntoCallerBuffer) {
+    BinaryMessage message(*messageConfig);
+    message.setField("field1", 42);
+    message.setField("field2", -3);
+
+    // Pack into the middle of a dirty buffer; surrounding bytes must survive
+    std::vector<uint8_t> buffer(6, 0xFF);
+    EXPECT_EQ(message.getPackedSize(), 2u);
+    EXPECT_EQ(message.packInto(buffer.data() + 2, buffer.size() - 2), 2u);
+
+    auto packed = message.pack();
+    EXPECT_EQ(std::vector<uint8_t>(buffer.begin() + 2, buffer.begin() + 4), packed);
+    EXPECT_EQ(buffer[1], 0xFF);
+    EXPECT_EQ(buffer[4], 0xFF);
+
+    uint8_t small[1];
+    EXPECT_THROW(message.packInto(small, sizeof(small)), std::runtime_error);
+}
+
+TEST_F(BinaryMessageTest, UnpackFromCallerBuffer) {
+    BinaryMessage message(*messageConfig);
+    message.setField("field1", 255);
+    message.setField("field2", 7);
+
+    // Two frames back to back, as in a receive buffer
+    std::vector<uint8_t> stream(2 * message.getPackedSize());
+    size_t offset = message.packInto(stream.data(), stream.size());
+    message.setField("field1", 1);
+    message.setField("field2", -8);
+    offset += message.packInto(stream.data() + offset, stream.size() - offset);
+    EXPECT_EQ(offset, stream.size());
+
+    BinaryMessage unpacked(*messageConfig);
+    size_t consumed = unpacked.unpackFrom(stream.data(), stream.size());
+    EXPECT_EQ(consumed, 2u);
+    EXPECT_EQ(unpacked.getField("field1"), 255);
+    EXPECT_EQ(unpacked.getField("field2"), 7);
+
+    consumed += unpacked.unpackFrom(stream.data() + consumed, stream.size() - consumed);
+    EXPECT_EQ(consumed, stream.size());
+    EXPECT_EQ(unpacked.getField("field1"), 1);
+    EXPECT_EQ(unpacked.getField("field2"), -8);
+
+    EXPECT_THROW(unpacked.unpackFrom(stream.data(), 1), std::runtime_error);
+}
+
+TEST(BinaryMessageWireOrderTest, NetworkOrderBytes) {
+    MessageConfig config(R"({"bit_order": "msb_first", "fields": [
+        {"name": "version", "bit_width": 4, "signed": false},
+        {"name": "length", "bit_width": 12, "signed": false},
+        {"name": "port", "bit_width": 16, "signed": false},
+        {"name": "checksum", "bit_width": 16, "signed": false, "byte_order": "little"}
+    ]})"_json);
+    EXPECT_EQ(config.getBitOrder(), BitOrder::MsbFirst);
+    EXPECT_EQ(config.getByteOrder(), ByteOrder::Big);
+
+    BinaryMessage message(config);
+    message.setField("version", 0x4);
+    message.setField("length", 0x5DC);
+    message.setField("port", 0x1F90);
+    message.setField("checksum", 0xBEEF);
+    EXPECT_EQ(message.pack(), (std::vector<uint8_t>{0x45, 0xDC, 0x1F, 0x90, 0xEF, 0xBE}));
+
+    // A big-endian field in an otherwise little-endian message
+    MessageConfig mixed(R"([
+        {"name": "tag", "bit_width": 8, "signed": false},
+        {"name": "length", "bit_width": 16, "signed": false, "byte_order": "big"}
+    ])"_json);
+    BinaryMessage header(mixed);
+    header.setField("tag", 0x7E);
+    header.setField("length", 0x0102);
+    EXPECT_EQ(header.pack(), (std::vector<uint8_t>{0x7E, 0x01, 0x02}));
+}
+
+TEST(BinaryMessageWireOrderTest, EveryOrderCombinationMatchesReference) {
+    const char* bitOrders[] = {"lsb_first", "msb_first"};
+    const char* byteOrders[] = {"little", "big"};
+    // Odd widths and offsets so fields straddle bytes and 64-bit words
+    const unsigned widths[] = {3, 16, 13, 64, 24, 7, 40, 1, 56, 8, 32};
+    std::mt19937_64 rng(7);
+
+    for (const char* messageBitOrder : bitOrders) {
+        nlohmann::json fields = nlohmann::json::array();
+        size_t n = 0;
+        for (unsigned width : widths) {
+            for (const char* bitOrder : bitOrders) {
+                for (const char* byteOrder : byteOrders) {
+                    nlohmann::json field = {{"name", "f" + std::to_string(n++)}, {"bit_width", width},
+                                            {"signed", n % 3 == 0}, {"bit_order", bitOrder}};
+                    if (width % 8 == 0) {
+                        field["byte_order"] = byteOrder;
+                    }
+                    fields.push_back(field);
+                }
+            }
+        }
+        MessageConfig config({{"bit_order", messageBitOrder}, {"fields", fields}});
+
+        for (int round = 0; round < 20; ++round) {
+            std::vector<int64_t> values;
+            BinaryMessage message(config);
+            for (size_t f = 0; f < config.getFields().size(); ++f) {
+                const FieldConfig& field = config.getFields()[f];
+                uint64_t raw = rng() & BitCodec::lowMask(field.bit_width());
+                int64_t value = field.is_signed() ? BitCodec::signExtend(raw, field.bit_width())
+                                                  : static_cast<int64_t>(raw);
+                if (!field.isValidValue(value)) {
+                    value = field.getMaxValue();
+                }
+                values.push_back(value);
+                message.setField(field.name(), value);
+            }
+
+            auto packed = message.pack();
+            ASSERT_EQ(packed, referencePack(config, values)) << "message " << messageBitOrder;
+
+            BinaryMessage unpacked(config);
+            unpacked.unpack(packed);
+            for (size_t f = 0; f < values.size(); ++f) {
+                ASSERT_EQ(unpacked.getField(config.getFields()[f].name()), values[f])
+                    << "message " << messageBitOrder << " field " << f;
+            }
+
+            // Depositing one field into a buffer holding the others gives the same bytes
+            std::vector<uint8_t> patched = packed;
+            size_t f = static_cast<size_t>(rng() % values.size());
+            config.getLayout().deposit(f, patched.data(), patched.size(), 0);
+            config.getLayout().deposit(f, patched.data(), patched.size(), values[f]);
+            ASSERT_EQ(patched, packed) << "message " << messageBitOrder << " field " << f;
+        }
+    }
+}
+
+TEST(BinaryMessageBlockTest, ArraysAndBytesMatchReference) {
+    const char* bitOrders[] = {"lsb_first", "msb_first"};
+    std::mt19937_64 rng(22);
+
+    for (const char* messageBitOrder : bitOrders) {
+        // Blocks at odd bit offsets and on byte boundaries, with elements that
+        // straddle bytes and words, in the message's order and in others
+        MessageConfig config({{"bit_order", messageBitOrder}, {"fields", R"([
+            {"name": "kind", "bit_width": 3, "signed": false},
+            {"name": "deltas", "bit_width": 13, "signed": true, "count": 7},
+            {"name": "id", "bit_width": 128, "signed": false},
+            {"name": "flags", "bit_width": 1, "signed": false, "count": 11},
+            {"name": "tail", "bytes": 3},
+            {"name": "words", "bit_width": 64, "signed": false, "count": 3},
+            {"name": "ports", "bit_width": 16, "signed": false, "count": 4, "byte_order": "big"},
+            {"name": "nibbles", "bit_width": 4, "signed": true, "count": 5, "bit_order": "msb_first"},
+            {"name": "pad", "bit_width": 5, "signed": false},
+            {"name": "digest", "bytes": 20}
+        ])"_json}});
+        EXPECT_EQ(config.getFieldConfig("id").getKind(), FieldKind::Bytes);
+        EXPECT_EQ(config.getFieldConfig("id").getCount(), 16u);
+
+        for (int round = 0; round < 20; ++round) {
+            BinaryMessage message(config);
+            std::vector<int64_t> values;
+            for (const FieldConfig& field : config.getFields()) {
+                std::vector<int64_t> elements;
+                for (uint32_t e = 0; e < field.getCount(); ++e) {
+                    uint64_t raw = rng() & BitCodec::lowMask(field.bit_width());
+                    int64_t value = field.is_signed() ? BitCodec::signExtend(raw, field.bit_width())
+                                                      : static_cast<int64_t>(raw);
+                    elements.push_back(field.isValidValue(value) ? value : field.getMaxValue());
+                }
+                if (field.isScalar()) {
+                    message.setField(field.name(), elements[0]);
+                } else if (field.getKind() == FieldKind::Bytes) {
+                    std::vector<uint8_t> bytes(elements.begin(), elements.end());
+                    message.setBytes(field.name(), bytes.data(), bytes.size());
+                } else {
+                    message.setArray(field.name(), elements.data(), elements.size());
+                }
+                values.insert(values.end(), elements.begin(), elements.end());
+            }
+
+            auto packed = message.pack();
+            ASSERT_EQ(packed, referencePack(config, values)) << "message " << messageBitOrder;
+
+            BinaryMessage unpacked(config);
+            unpacked.unpack(packed);
+            EXPECT_EQ(unpacked.pack(), packed);
+            size_t next = 0;
+            for (size_t f = 0; f < config.getFields().size(); ++f) {
+                const FieldConfig& field = config.getFields()[f];
+                FieldHandle handle(static_cast<uint32_t>(f));
+                if (field.isScalar()) {
+                    ASSERT_EQ(unpacked.getField(handle), values[next++]);
+                    continue;
+                }
+                std::vector<int64_t> elements(field.getCount());
+                unpacked.getArray(handle, elements.data(), elements.size());
+                for (uint32_t e = 0; e < field.getCount(); ++e) {
+                    ASSERT_EQ(elements[e], values[next + e]) << "field " << field.name() << " element " << e;
+                    ASSERT_EQ(unpacked.getElement(handle, e), values[next + e]);
+                }
+                if (field.getKind() == FieldKind::Bytes) {
+                    std::vector<uint8_t> bytes(field.getCount());
+                    unpacked.getBytes(handle, bytes.data(), bytes.size());
+                    EXPECT_TRUE(std::equal(bytes.begin(), bytes.end(), values.begin() + next));
+                }
+                next += field.getCount();
+            }
+        }
+    }
+}
+
+TEST(BinaryMessageBlockTest, ElementAccessAndValidation) {
+    MessageConfig config(R"([
+        {"name": "seq", "bit_width": 6, "signed": false},
+        {"name": "samples", "bit_width": 12, "signed": true, "count": 4},
+        {"name": "mac", "bytes": 6}
+    ])"_json);
+    EXPECT_EQ(config.getTotalBits(), 6u + 48u + 48u);
+
+    BinaryMessage message(config);
+    message.setElement(config.getFieldHandle("samples"), 2, -2048);
+    message.setElement(config.getFieldHandle("samples"), 3, 2047);
+    int64_t samples[4];
+    message.getArray("samples", samples, 4);
+    EXPECT_EQ(samples[0], 0);
+    EXPECT_EQ(samples[2], -2048);
+    EXPECT_EQ(samples[3], 2047);
+
+    const uint8_t mac[6] = {0x00, 0x1B, 0x44, 0x11, 0x3A, 0xB7};
+    message.setBytes("mac", mac, sizeof(mac));
+    auto packed = message.pack();
+    // mac starts at bit 54, after seq and samples
+    BinaryMessage unpacked(config);
+    unpacked.unpack(packed);
+    uint8_t macOut[6];
+    unpacked.getBytes("mac", macOut, sizeof(macOut));
+    EXPECT_TRUE(std::equal(mac, mac + 6, macOut));
+    EXPECT_EQ(unpacked.getElement(config.getFieldHandle("mac"), 5), 0xB7);
+
+    // Out-of-range values leave the array unchanged
+    const int64_t bad[4] = {1, 2, 2048, 3};
+    EXPECT_THROW(message.setArray("samples", bad, 4), std::runtime_error);
+    message.getArray("samples", samples, 4);
+    EXPECT_EQ(samples[0], 0);
+    EXPECT_THROW(message.setElement(config.getFieldHandle("samples"), 0, -2049), std::runtime_error);
+
+    // Wrong counts, sizes, indices and kinds
+    EXPECT_THROW(message.setArray("samples", samples, 3), std::runtime_error);
+    EXPECT_THROW(message.getArray("samples", samples, 5), std::runtime_error);
+    EXPECT_THROW(message.getElement(config.getFieldHandle("samples"), 4), std::runtime_error);
+    EXPECT_THROW(message.setBytes("mac", mac, 5), std::runtime_error);
+    EXPECT_THROW(message.setBytes("samples", mac, 6), std::runtime_error);
+    EXPECT_THROW(message.getField("samples"), std::runtime_error);
+    EXPECT_THROW(message.setField("mac", 1), std::runtime_error);
+    EXPECT_THROW(message.getArray("seq", samples, 1), std::runtime_error);
+
+    message.reset();
+    message.getArray("samples", samples, 4);
+    EXPECT_EQ(samples[2], 0);
+    EXPECT_EQ(message.pack(), std::vector<uint8_t>(packed.size(), 0));
+}
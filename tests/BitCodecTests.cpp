@@ -0,0 +1,178 @@
+#include "BitCodec.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+// Reference implementation of the LSB-first layout, one bit at a time
+uint64_t referenceExtract(const std::vector<uint8_t>& buffer, size_t offset, unsigned width) {
+    uint64_t value = 0;
+    for (unsigned bit = 0; bit < width; ++bit) {
+        size_t pos = offset + bit;
+        if (buffer[pos / 8] & (1 << (pos % 8))) {
+            value |= 1ULL << bit;
+        }
+    }
+    return value;
+}
+
+void referenceDeposit(std::vector<uint8_t>& buffer, size_t offset, unsigned width, uint64_t value) {
+    for (unsigned bit = 0; bit < width; ++bit) {
+        size_t pos = offset + bit;
+        uint8_t mask = static_cast<uint8_t>(1 << (pos % 8));
+        if (value & (1ULL << bit)) {
+            buffer[pos / 8] |= mask;
+        } else {
+            buffer[pos / 8] &= static_cast<uint8_t>(~mask);
+        }
+    }
+}
+
+// Reference implementation of the MSB-first layout: the field's first bit is
+// its most significant one, and bit N of the buffer is bit 7 - N % 8 of byte N / 8
+uint64_t referenceExtractMsb(const std::vector<uint8_t>& buffer, size_t offset, unsigned width) {
+    uint64_t value = 0;
+    for (unsigned bit = 0; bit < width; ++bit) {
+        size_t pos = offset + bit;
+        value = (value << 1) | ((buffer[pos / 8] >> (7 - pos % 8)) & 1);
+    }
+    return value;
+}
+
+void referenceDepositMsb(std::vector<uint8_t>& buffer, size_t offset, unsigned width, uint64_t value) {
+    for (unsigned bit = 0; bit < width; ++bit) {
+        size_t pos = offset + bit;
+        uint8_t mask = static_cast<uint8_t>(0x80 >> (pos % 8));
+        if ((value >> (width - 1 - bit)) & 1) {
+            buffer[pos / 8] |= mask;
+        } else {
+            buffer[pos / 8] &= static_cast<uint8_t>(~mask);
+        }
+    }
+}
+
+} // namespace
+
+TEST(BitCodecTest, LowMask) {
+    EXPECT_EQ(BitCodec::lowMask(1), 0x1u);
+    EXPECT_EQ(BitCodec::lowMask(12), 0xFFFu);
+    EXPECT_EQ(BitCodec::lowMask(63), 0x7FFFFFFFFFFFFFFFu);
+    EXPECT_EQ(BitCodec::lowMask(64), ~0ULL);
+}
+
+TEST(BitCodecTest, SignExtend) {
+    EXPECT_EQ(BitCodec::signExtend(0xD, 4), -3);
+    EXPECT_EQ(BitCodec::signExtend(0x7, 4), 7);
+    EXPECT_EQ(BitCodec::signExtend(0x200, 10), -512);
+    EXPECT_EQ(BitCodec::signExtend(0x8000000000000000ULL, 64), INT64_MIN);
+}
+
+TEST(BitCodecTest, LittleEndianWords) {
+    uint8_t bytes[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    EXPECT_EQ(BitCodec::loadLE64(bytes), 0x0807060504030201ULL);
+    EXPECT_EQ(BitCodec::loadLEPartial(bytes, 3), 0x030201ULL);
+
+    uint8_t out[8] = {};
+    BitCodec::storeLE64(out, 0x0807060504030201ULL);
+    EXPECT_EQ(std::vector<uint8_t>(out, out + 8), std::vector<uint8_t>(bytes, bytes + 8));
+}
+
+TEST(BitCodecTest, MatchesBitwiseReferenceForEveryWidthAndOffset) {
+    std::mt19937_64 rng(42);
+
+    for (unsigned width = 1; width <= 64; ++width) {
+        for (size_t offset = 0; offset < 24; ++offset) {
+            // Size the buffer tightly so the tail paths are exercised too
+            size_t size = (offset + width + 7) / 8;
+            std::vector<uint8_t> expected(size);
+            for (auto& byte : expected) {
+                byte = static_cast<uint8_t>(rng());
+            }
+            std::vector<uint8_t> actual = expected;
+
+            uint64_t value = rng();
+            referenceDeposit(expected, offset, width, value);
+            BitCodec::depositBits(actual.data(), actual.size(), offset, width, value);
+            ASSERT_EQ(actual, expected) << "width " << width << " offset " << offset;
+
+            ASSERT_EQ(BitCodec::extractBits(actual.data(), actual.size(), offset, width),
+                      referenceExtract(expected, offset, width))
+                << "width " << width << " offset " << offset;
+        }
+    }
+}
+
+TEST(BitCodecTest, BigEndianWordsAndReversal) {
+    uint8_t bytes[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    EXPECT_EQ(BitCodec::loadBE64(bytes), 0x0102030405060708ULL);
+    EXPECT_EQ(BitCodec::loadBEPartial(bytes, 3), 0x0102030000000000ULL);
+
+    uint8_t out[8] = {};
+    BitCodec::storeBE64(out, 0x0102030405060708ULL);
+    EXPECT_EQ(std::vector<uint8_t>(out, out + 8), std::vector<uint8_t>(bytes, bytes + 8));
+    BitCodec::storeBEPartial(out, 0xAABB000000000000ULL, 2);
+    EXPECT_EQ(out[0], 0xAA);
+    EXPECT_EQ(out[1], 0xBB);
+    EXPECT_EQ(out[2], 0x03);
+
+    EXPECT_EQ(BitCodec::byteSwap64(0x0102030405060708ULL), 0x0807060504030201ULL);
+    EXPECT_EQ(BitCodec::bitReverse64(1), 0x8000000000000000ULL);
+    EXPECT_EQ(BitCodec::bitReverse64(0x00000000000000F1ULL), 0x8F00000000000000ULL);
+}
+
+TEST(BitCodecTest, MsbFirstMatchesBitwiseReferenceForEveryWidthAndOffset) {
+    std::mt19937_64 rng(43);
+
+    for (unsigned width = 1; width <= 64; ++width) {
+        for (size_t offset = 0; offset < 24; ++offset) {
+            size_t size = (offset + width + 7) / 8;
+            std::vector<uint8_t> expected(size);
+            for (auto& byte : expected) {
+                byte = static_cast<uint8_t>(rng());
+            }
+            std::vector<uint8_t> actual = expected;
+
+            unsigned shift = static_cast<unsigned>(offset % 8);
+            bool crossesWord = shift + width > 64;
+            uint64_t value = rng();
+            referenceDepositMsb(expected, offset, width, value);
+            BitCodec::depositMsb(actual.data(), actual.size(), offset / 8, shift, width, crossesWord, value);
+            ASSERT_EQ(actual, expected) << "width " << width << " offset " << offset;
+
+            ASSERT_EQ(BitCodec::extractMsb(actual.data(), actual.size(), offset / 8, shift, width, crossesWord),
+                      referenceExtractMsb(expected, offset, width))
+                << "width " << width << " offset " << offset;
+        }
+    }
+}
+
+TEST(BitCodecTest, PackedRunsMatchBitwiseReference) {
+    std::mt19937_64 rng(12);
+    for (unsigned width = 1; width <= 64; ++width) {
+        for (size_t count : {size_t(1), size_t(7), size_t(8), size_t(9), size_t(33)}) {
+            std::vector<uint64_t> values(count);
+            for (auto& value : values) {
+                value = rng();
+            }
+            size_t bytes = (count * width + 7) / 8;
+            // One spare byte to check that nothing is written past the run
+            std::vector<uint8_t> run(bytes + 1, 0xA5);
+            BitCodec::packRun(count, width, [&](size_t i) { return static_cast<int64_t>(values[i]); }, run.data());
+            ASSERT_EQ(run[bytes], 0xA5) << "width " << width << " count " << count;
+
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(referenceExtract(run, i * width, width), values[i] & BitCodec::lowMask(width))
+                    << "width " << width << " count " << count << " value " << i;
+            }
+            std::vector<uint64_t> unpacked(count);
+            BitCodec::unpackRun(run.data(), bytes, count, width, [&](size_t i, uint64_t raw) { unpacked[i] = raw; });
+            for (size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(unpacked[i], values[i] & BitCodec::lowMask(width));
+            }
+        }
+    }
+}
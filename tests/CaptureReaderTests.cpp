@@ -0,0 +1,117 @@
+#include "CaptureReader.hpp"
+#include "BatchCodec.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+class CaptureReaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        nlohmann::json config = R"([
+            {"name": "sensor_id", "bit_width": 6, "signed": false},
+            {"name": "temperature", "bit_width": 10, "signed": true},
+            {"name": "humidity", "bit_width": 7, "signed": false}
+        ])"_json;
+        messageConfig = std::make_unique<MessageConfig>(config);
+        // One file per test: ctest runs each test as its own process, in parallel
+        path = ::testing::TempDir() + "capture_reader_" +
+               ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bin";
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    // Writes frames 0..count-1 with recognizable values, plus trailing bytes
+    void writeCapture(size_t count, size_t trailing = 0) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        BinaryMessage message(*messageConfig);
+        for (size_t i = 0; i < count; ++i) {
+            message.setField("sensor_id", static_cast<int64_t>(i % 64));
+            message.setField("temperature", static_cast<int64_t>(i % 1000) - 500);
+            message.setField("humidity", static_cast<int64_t>(i % 101));
+            auto packed = message.pack();
+            file.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+        }
+        for (size_t i = 0; i < trailing; ++i) {
+            file.put('\x7f');
+        }
+    }
+
+    std::unique_ptr<MessageConfig> messageConfig;
+    std::string path;
+};
+
+TEST_F(CaptureReaderTest, RandomAccessByFrameIndex) {
+    writeCapture(1000, 2);
+    CaptureReader reader(path, *messageConfig, AccessPattern::Random);
+
+    EXPECT_EQ(reader.getFrameSize(), 3u);
+    EXPECT_EQ(reader.getFrameCount(), 1000u);
+    EXPECT_EQ(reader.getTrailingBytes(), 2u);
+    EXPECT_EQ(reader.size(), 3002u);
+
+    BinaryMessage message(*messageConfig);
+    for (size_t i : {0u, 1u, 517u, 999u}) {
+        FrameView view = reader.frame(i);
+        EXPECT_EQ(view.data, reader.data() + i * 3);
+        EXPECT_EQ(view.size, 3u);
+        reader.unpack(i, message);
+        EXPECT_EQ(message.getField("sensor_id"), static_cast<int64_t>(i % 64));
+        EXPECT_EQ(message.getField("temperature"), static_cast<int64_t>(i % 1000) - 500);
+        EXPECT_EQ(message.getField("humidity"), static_cast<int64_t>(i % 101));
+
+        MessageView fields = reader.view(i);
+        EXPECT_EQ(fields.data(), view.data);
+        EXPECT_EQ(fields.getField("temperature"), static_cast<int64_t>(i % 1000) - 500);
+    }
+    EXPECT_THROW(reader.frame(1000), std::runtime_error);
+    EXPECT_THROW(reader.view(1000), std::runtime_error);
+}
+
+TEST_F(CaptureReaderTest, IteratesFramesInPlace) {
+    writeCapture(257);
+    CaptureReader reader(path, *messageConfig);
+
+    BinaryMessage message(*messageConfig);
+    size_t index = 0;
+    for (FrameView view : reader) {
+        message.unpackFrom(view.data, view.size);
+        EXPECT_EQ(message.getField("humidity"), static_cast<int64_t>(index % 101));
+        ++index;
+    }
+    EXPECT_EQ(index, 257u);
+
+    // The whole mapping feeds the batch codec directly
+    BatchCodec codec(*messageConfig);
+    auto columns = codec.decode(reader.data(), reader.getFrameCount(), reader.getFrameSize());
+    EXPECT_EQ(columns[1][256], 256 - 500);
+}
+
+TEST_F(CaptureReaderTest, EmptyAndMissingFiles) {
+    writeCapture(0);
+    CaptureReader reader(path, *messageConfig);
+    EXPECT_EQ(reader.getFrameCount(), 0u);
+    EXPECT_TRUE(reader.begin() == reader.end());
+
+    EXPECT_THROW(CaptureReader(path + ".missing", *messageConfig), std::runtime_error);
+}
+
+TEST_F(CaptureReaderTest, MappedFileMoves) {
+    writeCapture(10);
+    MappedFile first(path);
+    const uint8_t* data = first.data();
+
+    MappedFile second(std::move(first));
+    EXPECT_EQ(first.data(), nullptr);
+    EXPECT_EQ(second.data(), data);
+    EXPECT_EQ(second.size(), 30u);
+    second.advise(AccessPattern::Sequential);
+}
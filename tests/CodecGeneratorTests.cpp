@@ -0,0 +1,93 @@
+#include "codegen_definitions_codecs.hpp"
+#include "BinaryMessageFactory.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+using namespace BinaryMessageLibrary;
+
+class CodecGeneratorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::ifstream file(BINARY_MESSAGE_CODEGEN_DEFINITIONS);
+        ASSERT_TRUE(file.good());
+        nlohmann::json definitions;
+        file >> definitions;
+        factory = std::make_unique<BinaryMessageFactory>(definitions);
+    }
+
+    std::unique_ptr<BinaryMessageFactory> factory;
+};
+
+TEST_F(CodecGeneratorTest, ConstexprLayout) {
+    static_assert(generated::SensorData::kPackedSize == 4, "packed size");
+    static_assert(generated::SensorData::Layout::temperature_bit_offset == 6, "temperature offset");
+    static_assert(generated::SensorData::Layout::temperature_bit_width == 10, "temperature width");
+    static_assert(generated::WideRecord::kTotalBits == 147, "total bits");
+
+    EXPECT_EQ(generated::WideRecord::kPackedSize,
+              factory->createMessage("wide_record")->getPackedSize());
+}
+
+TEST_F(CodecGeneratorTest, SensorDataWireCompatible) {
+    std::mt19937 rng(11);
+    for (int i = 0; i < 100; ++i) {
+        generated::SensorData generatedMessage;
+        generatedMessage.sensor_id = static_cast<uint8_t>(rng() % 64);
+        generatedMessage.temperature = static_cast<int16_t>(static_cast<int>(rng() % 1024) - 512);
+        generatedMessage.humidity = static_cast<uint8_t>(rng() % 256);
+        generatedMessage.battery_level = static_cast<uint8_t>(rng() % 16);
+
+        auto message = factory->createMessage("sensor_data");
+        message->setField("sensor_id", generatedMessage.sensor_id);
+        message->setField("temperature", generatedMessage.temperature);
+        message->setField("humidity", generatedMessage.humidity);
+        message->setField("battery_level", generatedMessage.battery_level);
+
+        std::vector<uint8_t> packed(generated::SensorData::kPackedSize);
+        generated::pack(generatedMessage, packed.data());
+        ASSERT_EQ(packed, message->pack());
+
+        generated::SensorData unpacked;
+        generated::unpack(packed.data(), unpacked);
+        EXPECT_EQ(unpacked.sensor_id, generatedMessage.sensor_id);
+        EXPECT_EQ(unpacked.temperature, generatedMessage.temperature);
+        EXPECT_EQ(unpacked.humidity, generatedMessage.humidity);
+        EXPECT_EQ(unpacked.battery_level, generatedMessage.battery_level);
+    }
+}
+
+TEST_F(CodecGeneratorTest, WordSpanningFieldsWireCompatible) {
+    std::mt19937_64 rng(12);
+    for (int i = 0; i < 100; ++i) {
+        generated::WideRecord generatedMessage;
+        generatedMessage.flags = static_cast<uint8_t>(rng() % 8);
+        generatedMessage.timestamp = rng() >> 1;  // BinaryMessage holds values as int64_t
+        generatedMessage.offset = static_cast<int64_t>(rng() % (1ULL << 33)) - (1LL << 32);
+        generatedMessage.counter = rng() % (1ULL << 40);
+        generatedMessage.delta = static_cast<int8_t>(static_cast<int>(rng() % 128) - 64);
+
+        auto message = factory->createMessage("wide_record");
+        message->setField("flags", generatedMessage.flags);
+        message->setField("timestamp", static_cast<int64_t>(generatedMessage.timestamp));
+        message->setField("offset", generatedMessage.offset);
+        message->setField("counter", static_cast<int64_t>(generatedMessage.counter));
+        message->setField("delta", generatedMessage.delta);
+
+        std::vector<uint8_t> packed(generated::WideRecord::kPackedSize);
+        generated::pack(generatedMessage, packed.data());
+        ASSERT_EQ(packed, message->pack());
+
+        auto unpackedMessage = factory->createMessage("wide_record");
+        unpackedMessage->unpack(packed);
+        generated::WideRecord unpacked;
+        generated::unpack(packed.data(), unpacked);
+        EXPECT_EQ(unpacked.timestamp, generatedMessage.timestamp);
+        EXPECT_EQ(unpacked.offset, unpackedMessage->getField("offset"));
+        EXPECT_EQ(unpacked.counter, generatedMessage.counter);
+        EXPECT_EQ(unpacked.delta, generatedMessage.delta);
+    }
+}
@@ -0,0 +1,262 @@
+#include "ColumnStore.hpp"
+#include "BatchCodec.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+class ColumnStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config = std::make_unique<MessageConfig>(R"([
+            {"name": "sensor_id", "bit_width": 6, "signed": false},
+            {"name": "temperature", "bit_width": 10, "signed": true},
+            {"name": "humidity", "bit_width": 8, "signed": false},
+            {"name": "battery_level", "bit_width": 4, "signed": false}
+        ])"_json);
+
+        std::mt19937 rng(3);
+        columns.assign(4, std::vector<int64_t>(kRows));
+        for (size_t i = 0; i < kRows; ++i) {
+            columns[0][i] = static_cast<int64_t>(rng() % 64);
+            columns[1][i] = static_cast<int64_t>(rng() % 1024) - 512;
+            columns[2][i] = 40 + static_cast<int64_t>(rng() % 8);
+            columns[3][i] = 9;
+        }
+    }
+
+    std::string write(size_t blockRows, ColumnEncoding encoding) {
+        std::ostringstream out;
+        ColumnStoreWriter writer(out, *config, blockRows, encoding);
+        std::vector<const int64_t*> pointers;
+        for (const auto& column : columns) {
+            pointers.push_back(column.data());
+        }
+        writer.append(pointers.data(), kRows);
+        writer.finish();
+        EXPECT_EQ(writer.getRowCount(), kRows);
+        return out.str();
+    }
+
+    static const uint8_t* bytesOf(const std::string& bytes) {
+        return reinterpret_cast<const uint8_t*>(bytes.data());
+    }
+
+    static constexpr size_t kRows = 1000;
+    std::unique_ptr<MessageConfig> config;
+    std::vector<std::vector<int64_t>> columns;
+};
+
+TEST_F(ColumnStoreTest, RoundTripEveryEncoding) {
+    for (auto encoding : {ColumnEncoding::Plain, ColumnEncoding::FrameOfReference,
+                          ColumnEncoding::Delta, ColumnEncoding::Auto}) {
+        std::string bytes = write(256, encoding);
+        ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+
+        ASSERT_EQ(reader.getRowCount(), kRows);
+        ASSERT_EQ(reader.getBlockCount(), 4u);
+        EXPECT_EQ(reader.getBlockRowCount(3), kRows - 3 * 256);
+        ASSERT_EQ(reader.getColumnCount(), 4u);
+        for (size_t c = 0; c < 4; ++c) {
+            EXPECT_EQ(reader.readColumn(c), columns[c]) << "column " << c;
+        }
+    }
+}
+
+TEST_F(ColumnStoreTest, PlainChunkUsesExactlyBitWidth) {
+    columns[1][0] = -1;
+    columns[1][1] = 5;
+    columns[1][2] = -512;
+    std::string bytes = write(kRows, ColumnEncoding::Plain);
+    ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+
+    size_t temperature = reader.getColumnIndex("temperature");
+    const ColumnStats& stats = reader.getStats(0, temperature);
+    EXPECT_EQ(stats.encoding, ColumnEncoding::Plain);
+    EXPECT_EQ(stats.packedWidth, 10u);
+    EXPECT_EQ(stats.byteSize, (kRows * 10 + 7) / 8);
+
+    // 0x3FF, 0x005, 0x200 packed LSB-first at 10 bits each; the fourth value starts at bit 30
+    FrameView chunk = reader.getChunk(0, temperature);
+    ASSERT_EQ(chunk.size, stats.byteSize);
+    EXPECT_EQ(chunk.data[0], 0xFF);
+    EXPECT_EQ(chunk.data[1], 0x17);
+    EXPECT_EQ(chunk.data[2], 0x00);
+    EXPECT_EQ(chunk.data[3] & 0x3F, 0x20);
+
+    // A scan over this column reads 10 of every 28 bits of row data
+    uint64_t totalChunkBytes = 0;
+    for (size_t c = 0; c < reader.getColumnCount(); ++c) {
+        totalChunkBytes += reader.getStats(0, c).byteSize;
+    }
+    EXPECT_EQ(totalChunkBytes, (kRows * 28 + 7) / 8);
+}
+
+TEST_F(ColumnStoreTest, AutoPicksNarrowestEncoding) {
+    for (size_t i = 0; i < kRows; ++i) {
+        columns[0][i] = static_cast<int64_t>(i % 64);
+    }
+    std::string bytes = write(kRows, ColumnEncoding::Auto);
+    ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+
+    // Random 10-bit values do not compress
+    EXPECT_EQ(reader.getStats(0, 1).encoding, ColumnEncoding::Plain);
+    EXPECT_EQ(reader.getStats(0, 1).packedWidth, 10u);
+
+    // humidity spans 40..47, 3 bits from its minimum
+    const ColumnStats& humidity = reader.getStats(0, 2);
+    EXPECT_EQ(humidity.encoding, ColumnEncoding::FrameOfReference);
+    EXPECT_EQ(humidity.packedWidth, 3u);
+    EXPECT_EQ(humidity.min, 40);
+    EXPECT_EQ(humidity.max, 47);
+
+    // A constant column takes no bits at all
+    EXPECT_EQ(reader.getStats(0, 3).packedWidth, 0u);
+    EXPECT_EQ(reader.getStats(0, 3).byteSize, 0u);
+
+    // sensor_id counts up and wraps; its deltas (+1, -63) need more bits than plain
+    EXPECT_EQ(reader.getStats(0, 0).encoding, ColumnEncoding::Plain);
+    for (size_t c = 0; c < 4; ++c) {
+        EXPECT_EQ(reader.readColumn(c), columns[c]);
+    }
+}
+
+TEST_F(ColumnStoreTest, DeltaEncodesCounters) {
+    MessageConfig counterConfig(R"([
+        {"name": "sequence", "bit_width": 32, "signed": false},
+        {"name": "offset", "bit_width": 16, "signed": true}
+    ])"_json);
+    std::vector<int64_t> sequence(500);
+    std::vector<int64_t> offset(500);
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        sequence[i] = 4000000000LL + static_cast<int64_t>(i) * 3;
+        offset[i] = 1000 - static_cast<int64_t>(i) * 5;
+    }
+    const int64_t* pointers[] = {sequence.data(), offset.data()};
+
+    std::ostringstream out;
+    ColumnStoreWriter writer(out, counterConfig);
+    writer.append(pointers, sequence.size());
+    writer.finish();
+    std::string bytes = out.str();
+    ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+
+    EXPECT_EQ(reader.getStats(0, 0).encoding, ColumnEncoding::Delta);
+    EXPECT_EQ(reader.getStats(0, 0).packedWidth, 3u);
+    EXPECT_EQ(reader.getStats(0, 1).encoding, ColumnEncoding::Delta);
+    EXPECT_EQ(reader.getStats(0, 1).min, 1000 - 499 * 5);
+    EXPECT_EQ(reader.readColumn(0), sequence);
+    EXPECT_EQ(reader.readColumn(1), offset);
+}
+
+TEST_F(ColumnStoreTest, AppendFramesMatchesBatchDecode) {
+    BatchCodec codec(*config);
+    size_t frameSize = codec.getFrameSize();
+    std::vector<uint8_t> frames(kRows * frameSize);
+    std::vector<const int64_t*> pointers;
+    for (const auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+    codec.encode(pointers.data(), kRows, frames.data(), frameSize);
+
+    std::ostringstream out;
+    ColumnStoreWriter writer(out, *config, 300);
+    writer.appendFrames(frames.data(), 700, frameSize);
+    writer.appendFrames(frames.data() + 700 * frameSize, kRows - 700, frameSize);
+    writer.finish();
+    std::string bytes = out.str();
+    ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+
+    EXPECT_EQ(reader.getBlockCount(), 4u);
+    for (size_t c = 0; c < 4; ++c) {
+        EXPECT_EQ(reader.readColumn(c), columns[c]);
+    }
+}
+
+TEST_F(ColumnStoreTest, ValuesAreTruncatedToFieldWidth) {
+    columns[0][0] = 64 + 5;
+    columns[1][0] = 1023;
+    std::string bytes = write(kRows, ColumnEncoding::Auto);
+    ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+
+    EXPECT_EQ(reader.readColumn(0)[0], 5);
+    EXPECT_EQ(reader.readColumn(1)[0], -1);
+}
+
+TEST_F(ColumnStoreTest, FindBlocksUsesStatistics) {
+    for (size_t i = 0; i < kRows; ++i) {
+        columns[1][i] = static_cast<int64_t>(i) - 500;
+    }
+    std::string bytes = write(250, ColumnEncoding::Auto);
+    ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+    size_t temperature = reader.getColumnIndex("temperature");
+
+    EXPECT_EQ(reader.getStats(1, temperature).min, -250);
+    EXPECT_EQ(reader.getStats(1, temperature).max, -1);
+    EXPECT_EQ(reader.findBlocks(temperature, -10, 10), (std::vector<size_t>{1, 2}));
+    EXPECT_EQ(reader.findBlocks(temperature, 400, 1000), (std::vector<size_t>{3}));
+    EXPECT_TRUE(reader.findBlocks(temperature, 500, 1000).empty());
+    EXPECT_EQ(reader.findBlocks(reader.getColumnIndex("battery_level"), 9, 9).size(), 4u);
+}
+
+TEST_F(ColumnStoreTest, ReadsFromFile) {
+    std::string bytes = write(128, ColumnEncoding::Auto);
+    std::string path = ::testing::TempDir() + "column_store_" +
+                       ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".bmcs";
+    std::ofstream(path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    {
+        ColumnStoreReader reader(path);
+        EXPECT_EQ(reader.getSchema()->getTotalBits(), 28u);
+        EXPECT_EQ(reader.readColumn(reader.getColumnIndex("humidity")), columns[2]);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(ColumnStoreTest, RejectsMalformedStores) {
+    std::string bytes = write(256, ColumnEncoding::Auto);
+    std::string unfinished = bytes.substr(0, bytes.size() - 1);
+    EXPECT_THROW(ColumnStoreReader(bytesOf(unfinished), unfinished.size()), std::runtime_error);
+
+    std::string badMagic = bytes;
+    badMagic[0] = 'X';
+    EXPECT_THROW(ColumnStoreReader(bytesOf(badMagic), badMagic.size()), std::runtime_error);
+
+    // Pointing the footer at block data yields a garbage footer
+    std::string badFooter = bytes;
+    badFooter[bytes.size() - 12] = 5;
+    for (size_t i = 1; i < 8; ++i) {
+        badFooter[bytes.size() - 12 + i] = 0;
+    }
+    EXPECT_THROW(ColumnStoreReader(bytesOf(badFooter), badFooter.size()), std::runtime_error);
+
+    ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+    EXPECT_THROW(reader.getStats(4, 0), std::runtime_error);
+    EXPECT_THROW(reader.readColumn(4), std::runtime_error);
+    EXPECT_THROW(reader.getColumnIndex("missing"), std::runtime_error);
+}
+
+TEST_F(ColumnStoreTest, WriterRejectsUseAfterFinish) {
+    std::ostringstream out;
+    EXPECT_THROW(ColumnStoreWriter(out, *config, 0), std::runtime_error);
+
+    ColumnStoreWriter writer(out, *config);
+    writer.finish();
+    std::vector<const int64_t*> pointers;
+    for (const auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+    EXPECT_THROW(writer.append(pointers.data(), 1), std::runtime_error);
+
+    std::string bytes = out.str();
+    ColumnStoreReader reader(bytesOf(bytes), bytes.size());
+    EXPECT_EQ(reader.getRowCount(), 0u);
+    EXPECT_EQ(reader.getBlockCount(), 0u);
+}
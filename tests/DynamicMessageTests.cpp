@@ -0,0 +1,273 @@
+#include "DynamicMessage.hpp"
+#include "DecodeProgram.hpp"
+#include "BitCodec.hpp"
+#include "MessageView.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+// Writes fields one bit at a time in either bit order
+struct BitWriter {
+    explicit BitWriter(bool msbFirst) : msbFirst(msbFirst) {}
+
+    void put(uint64_t value, unsigned width) {
+        for (unsigned b = 0; b < width; ++b) {
+            bool bit = (value >> (msbFirst ? width - 1 - b : b)) & 1;
+            if (position / 8 >= bytes.size()) {
+                bytes.push_back(0);
+            }
+            unsigned shift = msbFirst ? 7 - position % 8 : position % 8;
+            bytes[position / 8] |= static_cast<uint8_t>(bit << shift);
+            ++position;
+        }
+    }
+
+    bool msbFirst;
+    std::vector<uint8_t> bytes;
+    size_t position = 0;
+};
+
+// Expected entries per field; absent entries are recorded as nullopt-like -1 presence
+struct Expected {
+    std::map<std::string, std::vector<int64_t>> values;
+    std::map<std::string, std::vector<bool>> present;
+
+    void add(const std::string& name, int64_t value, bool isPresent = true) {
+        values[name].push_back(isPresent ? value : 0);
+        present[name].push_back(isPresent);
+    }
+};
+
+const char* kHeaderSchema = R"([
+    {"name": "version", "bit_width": 4, "signed": false},
+    {"name": "has_ext", "bit_width": 1, "signed": false},
+    {"name": "count", "bit_width": 3, "signed": false},
+    {"name": "ext", "bit_width": 16, "signed": true, "present_if": "has_ext"},
+    {"name": "entries", "count_field": "count", "fields": [
+        {"name": "key", "bit_width": 8, "signed": false},
+        {"name": "value", "bit_width": 12, "signed": true}
+    ]},
+    {"name": "crc", "bit_width": 8, "signed": false}
+])";
+
+} // namespace
+
+TEST(DynamicMessageTest, DecodesConditionalFieldsAndRepeatedGroups) {
+    DecodeProgram program(nlohmann::json::parse(kHeaderSchema));
+    DynamicMessage message(program);
+
+    BitWriter with(false);
+    with.put(2, 4);
+    with.put(1, 1);
+    with.put(3, 3);
+    with.put(static_cast<uint64_t>(-300), 16);
+    for (int i = 0; i < 3; ++i) {
+        with.put(10 + i, 8);
+        with.put(static_cast<uint64_t>(-100 * i), 12);
+    }
+    with.put(0xA5, 8);
+
+    EXPECT_EQ(message.unpackFrom(with.bytes.data(), with.bytes.size()), with.bytes.size());
+    EXPECT_EQ(message.getField("version"), 2);
+    EXPECT_TRUE(message.isPresent("ext"));
+    EXPECT_EQ(message.getField("ext"), -300);
+    EXPECT_EQ(message.getGroupSize("entries"), 3u);
+    EXPECT_EQ(message.getValues(program.getFieldHandle("entries.key")), (std::vector<int64_t>{10, 11, 12}));
+    EXPECT_EQ(message.getField("entries.value", 2), -200);
+    EXPECT_EQ(message.getField("crc"), 0xA5);
+
+    // Without the extension and with no entries, the trailer follows the header directly
+    BitWriter without(false);
+    without.put(2, 4);
+    without.put(0, 1);
+    without.put(0, 3);
+    without.put(0x5A, 8);
+    EXPECT_EQ(message.unpackFrom(without.bytes.data(), without.bytes.size()), 2u);
+    EXPECT_FALSE(message.isPresent("ext"));
+    EXPECT_EQ(message.getField("ext"), 0);
+    EXPECT_EQ(message.getGroupSize("entries"), 0u);
+    EXPECT_TRUE(message.getValues(program.getFieldHandle("entries.key")).empty());
+    EXPECT_THROW(message.getField("entries.key", 0), std::runtime_error);
+    EXPECT_EQ(message.getField("crc"), 0x5A);
+}
+
+TEST(DynamicMessageTest, CompilesRunsWithConstantOffsets) {
+    DecodeProgram program(nlohmann::json::parse(kHeaderSchema));
+    using Op = DecodeProgram::Op;
+    const auto& code = program.getInstructions();
+    std::vector<Op> ops;
+    for (const auto& instruction : code) {
+        ops.push_back(instruction.op);
+    }
+    EXPECT_EQ(ops, (std::vector<Op>{Op::Run, Op::Load, Op::Load, Op::Load,
+                                    Op::SkipUnless, Op::Run, Op::Load,
+                                    Op::Repeat, Op::Run, Op::Load, Op::Load, Op::Next,
+                                    Op::Run, Op::Load, Op::End}));
+    // The header is one bounds-checked run with fixed offsets
+    EXPECT_EQ(code[0].a, 8u);
+    EXPECT_EQ(code[1].a, 0u);
+    EXPECT_EQ(code[2].a, 4u);
+    EXPECT_EQ(code[3].a, 5u);
+    // Jumps land past the skipped field and the repeated body
+    EXPECT_EQ(code[4].a, 7u);
+    EXPECT_EQ(code[7].a, 12u);
+    EXPECT_EQ(code[7].c, 20u);
+    EXPECT_EQ(code[11].a, 8u);
+    EXPECT_TRUE(program.isOptional(program.getFieldHandle("ext").index()));
+    EXPECT_FALSE(program.isOptional(program.getFieldHandle("crc").index()));
+
+    // The header is also a fixed prefix readable at O(1) offsets
+    const MessageConfig& prefix = program.getPrefix();
+    EXPECT_EQ(prefix.getFields().size(), 3u);
+    EXPECT_EQ(prefix.getTotalBits(), 8u);
+    const uint8_t frame[] = {0x3D, 0xFF};
+    MessageView view(prefix, frame, sizeof(frame));
+    EXPECT_EQ(view.getField("version"), 0xD);
+    EXPECT_EQ(view.getField("has_ext"), 1);
+    EXPECT_EQ(view.getField("count"), 1);
+}
+
+TEST(DynamicMessageTest, NestedGroupsMatchReference) {
+    for (bool msbFirst : {false, true}) {
+        nlohmann::json schema = {{"bit_order", msbFirst ? "msb_first" : "lsb_first"}, {"fields", R"([
+            {"name": "version", "bit_width": 3, "signed": false},
+            {"name": "flags", "bit_width": 2, "signed": false},
+            {"name": "n", "bit_width": 3, "signed": false},
+            {"name": "ext", "bit_width": 20, "signed": true, "present_if": "flags"},
+            {"name": "items", "count_field": "n", "fields": [
+                {"name": "id", "bit_width": 7, "signed": false},
+                {"name": "has_data", "bit_width": 1, "signed": false},
+                {"name": "data", "present_if": "has_data", "fields": [
+                    {"name": "value", "bit_width": 33, "signed": true},
+                    {"name": "mode", "bit_width": 2, "signed": false}
+                ]},
+                {"name": "tag", "bit_width": 5, "signed": false, "present_if": "version"},
+                {"name": "k", "bit_width": 2, "signed": false},
+                {"name": "points", "count_field": "k", "fields": [
+                    {"name": "x", "bit_width": 64, "signed": true},
+                    {"name": "y", "bit_width": 9, "signed": false}
+                ]}
+            ]},
+            {"name": "crc", "bit_width": 16, "signed": false}
+        ])"_json}};
+        DecodeProgram program(schema);
+        DynamicMessage message(program);
+        std::mt19937_64 rng(msbFirst ? 2 : 1);
+
+        for (int round = 0; round < 200; ++round) {
+            BitWriter writer(msbFirst);
+            Expected expected;
+            size_t points = 0;
+
+            uint64_t version = rng() % 8;
+            uint64_t flags = rng() % 4;
+            uint64_t n = rng() % 8;
+            writer.put(version, 3);
+            writer.put(flags, 2);
+            writer.put(n, 3);
+            expected.add("version", static_cast<int64_t>(version));
+            expected.add("flags", static_cast<int64_t>(flags));
+            expected.add("n", static_cast<int64_t>(n));
+            int64_t ext = BitCodec::signExtend(rng(), 20);
+            if (flags != 0) {
+                writer.put(static_cast<uint64_t>(ext), 20);
+            }
+            expected.add("ext", ext, flags != 0);
+
+            for (uint64_t i = 0; i < n; ++i) {
+                uint64_t id = rng() % 128;
+                uint64_t hasData = rng() % 2;
+                writer.put(id, 7);
+                writer.put(hasData, 1);
+                expected.add("items.id", static_cast<int64_t>(id));
+                expected.add("items.has_data", static_cast<int64_t>(hasData));
+                int64_t value = BitCodec::signExtend(rng(), 33);
+                uint64_t mode = rng() % 4;
+                if (hasData) {
+                    writer.put(static_cast<uint64_t>(value), 33);
+                    writer.put(mode, 2);
+                }
+                expected.add("items.data.value", value, hasData != 0);
+                expected.add("items.data.mode", static_cast<int64_t>(mode), hasData != 0);
+                uint64_t tag = rng() % 32;
+                if (version != 0) {
+                    writer.put(tag, 5);
+                }
+                expected.add("items.tag", static_cast<int64_t>(tag), version != 0);
+                uint64_t k = rng() % 4;
+                writer.put(k, 2);
+                expected.add("items.k", static_cast<int64_t>(k));
+                for (uint64_t p = 0; p < k; ++p) {
+                    int64_t x = static_cast<int64_t>(rng());
+                    uint64_t y = rng() % 512;
+                    writer.put(static_cast<uint64_t>(x), 64);
+                    writer.put(y, 9);
+                    expected.add("items.points.x", x);
+                    expected.add("items.points.y", static_cast<int64_t>(y));
+                    ++points;
+                }
+            }
+            uint64_t crc = rng() % 65536;
+            writer.put(crc, 16);
+            expected.add("crc", static_cast<int64_t>(crc));
+
+            ASSERT_EQ(message.unpackFrom(writer.bytes.data(), writer.bytes.size()), writer.bytes.size());
+            EXPECT_EQ(message.getGroupSize("items"), n);
+            EXPECT_EQ(message.getGroupSize("items.points"), points);
+            for (const FieldConfig& field : program.getFields()) {
+                FieldHandle handle = program.getFieldHandle(field.name());
+                const auto& values = expected.values[field.name()];
+                ASSERT_EQ(message.getValues(handle), values) << field.name() << " round " << round;
+                for (size_t i = 0; i < values.size(); ++i) {
+                    ASSERT_EQ(message.isPresent(handle, i), expected.present[field.name()][i]) << field.name();
+                }
+            }
+        }
+    }
+}
+
+TEST(DynamicMessageTest, TruncatedBuffersThrow) {
+    DecodeProgram program(nlohmann::json::parse(kHeaderSchema));
+    DynamicMessage message(program);
+
+    BitWriter writer(false);
+    writer.put(1, 4);
+    writer.put(0, 1);
+    writer.put(7, 3);
+    writer.put(0, 8);
+    // Seven entries announced, too few bytes to hold them
+    EXPECT_THROW(message.unpackFrom(writer.bytes.data(), writer.bytes.size()), std::runtime_error);
+    EXPECT_THROW(message.unpackFrom(writer.bytes.data(), 0), std::runtime_error);
+}
+
+TEST(DynamicMessageTest, RejectsInvalidSchemas) {
+    auto compile = [](const char* text) { DecodeProgram program(nlohmann::json::parse(text)); };
+    // References must name an earlier scalar
+    EXPECT_THROW(compile(R"([{"name": "a", "bit_width": 4, "present_if": "b"},
+                            {"name": "b", "bit_width": 1}])"), std::runtime_error);
+    EXPECT_THROW(compile(R"([{"name": "g", "count_field": "missing", "fields": [{"name": "a", "bit_width": 1}]}])"),
+                 std::runtime_error);
+    // Counts must be unsigned, and every iteration must take some bits
+    EXPECT_THROW(compile(R"([{"name": "n", "bit_width": 4, "signed": true},
+                            {"name": "g", "count_field": "n", "fields": [{"name": "a", "bit_width": 1}]}])"),
+                 std::runtime_error);
+    EXPECT_THROW(compile(R"([{"name": "n", "bit_width": 4}, {"name": "f", "bit_width": 1},
+                            {"name": "g", "count_field": "n", "fields": [
+                                {"name": "a", "bit_width": 8, "present_if": "f"}]}])"),
+                 std::runtime_error);
+    // Duplicate names, bad widths and keys meant for fixed messages
+    EXPECT_THROW(compile(R"([{"name": "a", "bit_width": 4}, {"name": "a", "bit_width": 4}])"), std::runtime_error);
+    EXPECT_THROW(compile(R"([{"name": "a", "bit_width": 65}])"), std::runtime_error);
+    EXPECT_THROW(compile(R"([{"name": "a", "bit_width": 8, "count": 4}])"), std::runtime_error);
+    EXPECT_THROW(compile(R"({"byte_order": "big", "fields": []})"), std::runtime_error);
+    EXPECT_THROW(compile(R"({"bit_order": "msb", "fields": []})"), std::runtime_error);
+    EXPECT_NO_THROW(compile(R"([])"));
+}
@@ -0,0 +1,195 @@
+#include "FrameFilter.hpp"
+#include "BatchCodec.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+class FrameFilterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // big starts at bit 68, so it spills past the word loaded at its first byte
+        config = std::make_unique<MessageConfig>(R"([
+            {"name": "error_code", "bit_width": 4, "signed": false},
+            {"name": "temperature", "bit_width": 10, "signed": true},
+            {"name": "counter", "bit_width": 46, "signed": false},
+            {"name": "status", "bit_width": 8, "signed": true},
+            {"name": "big", "bit_width": 64, "signed": true}
+        ])"_json);
+        frameSize = BatchCodec(*config).getFrameSize();
+
+        std::mt19937_64 rng(21);
+        frames.resize(kFrames * frameSize);
+        for (auto& byte : frames) {
+            byte = static_cast<uint8_t>(rng());
+        }
+    }
+
+    // Reference result: unpack every frame and compare field values
+    std::vector<size_t> expected(const std::string& field, CompareOp op, int64_t value) {
+        BinaryMessage message(*config);
+        std::vector<size_t> result;
+        for (size_t i = 0; i < kFrames; ++i) {
+            message.unpackFrom(frames.data() + i * frameSize, frameSize);
+            int64_t actual = message.getField(field);
+            bool holds = false;
+            switch (op) {
+            case CompareOp::Equal: holds = actual == value; break;
+            case CompareOp::NotEqual: holds = actual != value; break;
+            case CompareOp::Less: holds = actual < value; break;
+            case CompareOp::LessEqual: holds = actual <= value; break;
+            case CompareOp::Greater: holds = actual > value; break;
+            case CompareOp::GreaterEqual: holds = actual >= value; break;
+            }
+            if (holds) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    }
+
+    static constexpr size_t kFrames = 1000;
+    std::unique_ptr<MessageConfig> config;
+    size_t frameSize = 0;
+    std::vector<uint8_t> frames;
+};
+
+TEST_F(FrameFilterTest, MatchesUnpackedComparison) {
+    const CompareOp ops[] = {CompareOp::Equal, CompareOp::NotEqual, CompareOp::Less,
+                             CompareOp::LessEqual, CompareOp::Greater, CompareOp::GreaterEqual};
+    const std::pair<const char*, std::vector<int64_t>> cases[] = {
+        {"error_code", {-1, 0, 3, 15, 16}},
+        {"temperature", {-600, -512, -100, 0, 511, 512}},
+        {"status", {-129, -128, -1, 0, 5, 127, 128}},
+        {"big", {INT64_MIN, -1, 0, INT64_MAX}},
+    };
+
+    for (const auto& [field, values] : cases) {
+        for (int64_t value : values) {
+            for (CompareOp op : ops) {
+                FrameFilter filter(*config);
+                filter.where(field, op, value);
+                std::vector<size_t> indices;
+                filter.selectIndices(frames.data(), kFrames, frameSize, indices);
+                ASSERT_EQ(indices, expected(field, op, value))
+                    << field << " op " << static_cast<int>(op) << " value " << value;
+            }
+        }
+    }
+}
+
+TEST_F(FrameFilterTest, ConjunctionAndBitmap) {
+    FrameFilter filter(*config);
+    filter.where("error_code", CompareOp::NotEqual, 0).where("temperature", CompareOp::Less, -100);
+    EXPECT_EQ(filter.getPredicateCount(), 2u);
+
+    auto first = expected("error_code", CompareOp::NotEqual, 0);
+    auto second = expected("temperature", CompareOp::Less, -100);
+    std::vector<size_t> both;
+    std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(both));
+
+    std::vector<uint64_t> bitmap((kFrames + 63) / 64, ~0ULL);
+    size_t selected = filter.selectBitmap(frames.data(), kFrames, frameSize, bitmap.data());
+    EXPECT_EQ(selected, both.size());
+
+    std::vector<size_t> fromBitmap;
+    for (size_t i = 0; i < kFrames; ++i) {
+        if ((bitmap[i / 64] >> (i % 64)) & 1) {
+            fromBitmap.push_back(i);
+        }
+    }
+    EXPECT_EQ(fromBitmap, both);
+    // Bits past the last frame are cleared
+    EXPECT_EQ(bitmap.back() >> (kFrames % 64), 0u);
+
+    for (size_t i = 0; i < 100; ++i) {
+        bool selectedFrame = std::binary_search(both.begin(), both.end(), i);
+        EXPECT_EQ(filter.matches(frames.data() + i * frameSize, frameSize), selectedFrame);
+    }
+}
+
+TEST_F(FrameFilterTest, FoldsConstantPredicates) {
+    FrameFilter always(*config);
+    always.where("error_code", CompareOp::GreaterEqual, 0)
+          .where("temperature", CompareOp::Less, 1000)
+          .where("status", CompareOp::NotEqual, 200);
+    EXPECT_EQ(always.getPredicateCount(), 0u);
+    EXPECT_FALSE(always.isEmpty());
+    std::vector<size_t> indices;
+    EXPECT_EQ(always.selectIndices(frames.data(), kFrames, frameSize, indices), kFrames);
+
+    FrameFilter never(*config);
+    never.where("error_code", CompareOp::Equal, 16);
+    EXPECT_TRUE(never.isEmpty());
+    EXPECT_EQ(never.selectIndices(frames.data(), kFrames, frameSize, indices), 0u);
+    EXPECT_TRUE(indices.empty());
+}
+
+TEST_F(FrameFilterTest, PaddedStrideAndBufferEnd) {
+    // Frames padded to a wider stride; the last frames sit at the very end of
+    // the buffer so whole-word loads there would run past it
+    size_t stride = frameSize + 3;
+    std::vector<uint8_t> padded((kFrames - 1) * stride + frameSize);
+    for (size_t i = 0; i < kFrames; ++i) {
+        std::copy_n(frames.data() + i * frameSize, frameSize, padded.data() + i * stride);
+    }
+
+    FrameFilter filter(*config);
+    filter.where("big", CompareOp::Less, 0).where("status", CompareOp::Greater, -50);
+    std::vector<size_t> indices;
+    filter.selectIndices(padded.data(), kFrames, stride, indices);
+
+    auto first = expected("big", CompareOp::Less, 0);
+    auto second = expected("status", CompareOp::Greater, -50);
+    std::vector<size_t> both;
+    std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(both));
+    EXPECT_EQ(indices, both);
+}
+
+TEST_F(FrameFilterTest, RejectsBadInput) {
+    FrameFilter filter(*config);
+    EXPECT_THROW(filter.where("missing", CompareOp::Equal, 0), std::runtime_error);
+    std::vector<size_t> indices;
+    EXPECT_THROW(filter.selectIndices(frames.data(), 2, frameSize - 1, indices), std::runtime_error);
+    EXPECT_THROW(filter.matches(frames.data(), frameSize - 1), std::runtime_error);
+    EXPECT_EQ(filter.selectIndices(frames.data(), 0, frameSize, indices), 0u);
+}
+
+TEST(FrameFilterWireOrderTest, MatchesUnpackedComparison) {
+    MessageConfig config(R"({"bit_order": "msb_first", "fields": [
+        {"name": "version", "bit_width": 4, "signed": false},
+        {"name": "delta", "bit_width": 13, "signed": true},
+        {"name": "crc", "bit_width": 16, "signed": false, "byte_order": "little"}
+    ]})"_json);
+    size_t frameSize = config.getLayout().getTotalBytes();
+    size_t count = 300;
+
+    std::mt19937_64 rng(5);
+    std::vector<uint8_t> frames(count * frameSize);
+    for (auto& byte : frames) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    FrameFilter filter(config);
+    filter.where("delta", CompareOp::Less, -1000).where("crc", CompareOp::GreaterEqual, 0x4000);
+    std::vector<size_t> indices;
+    filter.selectIndices(frames.data(), count, frameSize, indices);
+
+    std::vector<size_t> expected;
+    BinaryMessage message(config);
+    for (size_t i = 0; i < count; ++i) {
+        message.unpackFrom(frames.data() + i * frameSize, frameSize);
+        if (message.getField("delta") < -1000 && message.getField("crc") >= 0x4000) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(indices, expected);
+}
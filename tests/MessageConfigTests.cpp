@@ -79,4 +79,157 @@ TEST_F(MessageConfigTest, InvalidConfigThrows) {
         }
     ])"_json;
     EXPECT_THROW(config.setConfig(invalid_bit_width_type), std::runtime_error);
-} 
\ No newline at end of file
+}
+
+TEST_F(MessageConfigTest, LayoutPlan) {
+    const auto& layout = message_config->getLayout();
+
+    ASSERT_EQ(layout.size(), 3u);
+    EXPECT_EQ(layout.getTotalBits(), 14u);
+    EXPECT_EQ(layout.getTotalBytes(), 2u);
+
+    // status: bits 0-1, value: bits 2-9, flags: bits 10-13
+    EXPECT_EQ(layout.byteOffsets(), (std::vector<uint32_t>{0, 0, 1}));
+    EXPECT_EQ(layout.shifts(), (std::vector<uint8_t>{0, 2, 2}));
+    EXPECT_EQ(layout.masks(), (std::vector<uint64_t>{0x3, 0xFF, 0xF}));
+    EXPECT_EQ(layout.signShifts(), (std::vector<uint8_t>{0, 56, 0}));
+    EXPECT_EQ(layout.crossesWord(), (std::vector<uint8_t>{0, 0, 0}));
+}
+
+TEST_F(MessageConfigTest, LayoutPlanWordCrossing) {
+    nlohmann::json config = R"([
+        {"name": "pad", "bit_width": 5},
+        {"name": "wide", "bit_width": 60, "signed": true}
+    ])"_json;
+    MessageConfig crossing(config);
+
+    const auto& layout = crossing.getLayout();
+    EXPECT_EQ(layout.byteOffsets()[1], 0u);
+    EXPECT_EQ(layout.shifts()[1], 5u);
+    EXPECT_EQ(layout.signShifts()[1], 4u);
+    EXPECT_EQ(layout.crossesWord()[1], 1u);
+    EXPECT_EQ(layout.getTotalBytes(), 9u);
+}
+
+TEST_F(MessageConfigTest, LayoutRebuiltBySetConfig) {
+    message_config->setConfig(R"([{"name": "only", "bit_width": 12}])"_json);
+
+    EXPECT_EQ(message_config->getLayout().size(), 1u);
+    EXPECT_EQ(message_config->getLayout().getTotalBits(), 12u);
+}
+
+TEST_F(MessageConfigTest, FieldHandles) {
+    FieldHandle value = message_config->getFieldHandle("value");
+
+    EXPECT_TRUE(value.isValid());
+    EXPECT_EQ(value.index(), 1u);
+    EXPECT_EQ(message_config->getFieldConfig(value).name(), "value");
+    EXPECT_EQ(&message_config->getFieldConfig("flags"), &message_config->getFields()[2]);
+
+    EXPECT_FALSE(FieldHandle().isValid());
+    EXPECT_THROW(message_config->getFieldHandle("missing"), std::runtime_error);
+    EXPECT_THROW(message_config->getFieldConfig(FieldHandle()), std::runtime_error);
+}
+
+TEST_F(MessageConfigTest, DuplicateFieldNamesThrow) {
+    nlohmann::json duplicate = R"([
+        {"name": "a", "bit_width": 4},
+        {"name": "a", "bit_width": 8}
+    ])"_json;
+
+    MessageConfig config;
+    EXPECT_THROW(config.setConfig(duplicate), std::runtime_error);
+}
+
+TEST_F(MessageConfigTest, WireOrders) {
+    // Array form: LSB-first, little-endian throughout
+    EXPECT_EQ(message_config->getBitOrder(), BitOrder::LsbFirst);
+    EXPECT_TRUE(message_config->getLayout().hasDefaultOrder());
+
+    MessageConfig config(R"({"bit_order": "msb_first", "fields": [
+        {"name": "flags", "bit_width": 4},
+        {"name": "length", "bit_width": 16},
+        {"name": "crc", "bit_width": 16, "byte_order": "little"},
+        {"name": "mask", "bit_width": 12, "bit_order": "lsb_first"},
+        {"name": "raw", "bit_width": 8, "bit_order": "lsb_first"}
+    ]})"_json);
+    const auto& fields = config.getFields();
+    EXPECT_EQ(config.getByteOrder(), ByteOrder::Big);
+    EXPECT_EQ(fields[0].getBitOrder(), BitOrder::MsbFirst);
+    EXPECT_EQ(fields[1].getByteOrder(), ByteOrder::Big);
+    EXPECT_EQ(fields[2].getByteOrder(), ByteOrder::Little);
+    // Widths that are not a multiple of 8 take the byte order of their bit order
+    EXPECT_EQ(fields[3].getByteOrder(), ByteOrder::Little);
+    EXPECT_EQ(fields[4].getByteOrder(), ByteOrder::Big);
+
+    const auto& layout = config.getLayout();
+    EXPECT_FALSE(layout.hasDefaultOrder());
+    using L = MessageLayout;
+    EXPECT_EQ(layout.orderFlags(), (std::vector<uint8_t>{
+        L::kMsbFirst, L::kMsbFirst, L::kMsbFirst | L::kSwapBytes,
+        L::kMsbFirst | L::kReverseBits, L::kMsbFirst | L::kReverseBits | L::kSwapBytes}));
+}
+
+TEST_F(MessageConfigTest, InvalidWireOrdersThrow) {
+    MessageConfig config;
+    EXPECT_THROW(config.setConfig(R"({"bit_order": "msb", "fields": []})"_json), std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"({"byte_order": "middle", "fields": []})"_json), std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"({"bit_order": "msb_first", "fields": {}})"_json), std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bit_width": 8, "bit_order": 1}])"_json),
+                 std::runtime_error);
+    // A 12-bit field has no bytes to swap
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bit_width": 12, "byte_order": "big"}])"_json),
+                 std::runtime_error);
+    EXPECT_THROW(FieldConfig("a", 12, false, BitOrder::MsbFirst, ByteOrder::Little), std::runtime_error);
+    EXPECT_NO_THROW(FieldConfig("a", 24, false, BitOrder::MsbFirst, ByteOrder::Little));
+}
+
+TEST_F(MessageConfigTest, ArrayAndBytesFields) {
+    MessageConfig config(R"([
+        {"name": "kind", "bit_width": 3, "signed": false},
+        {"name": "samples", "bit_width": 12, "signed": true, "count": 10},
+        {"name": "uuid", "bit_width": 128, "signed": false},
+        {"name": "payload", "bytes": 32}
+    ])"_json);
+    const auto& fields = config.getFields();
+    EXPECT_EQ(fields[0].getKind(), FieldKind::Scalar);
+    EXPECT_EQ(fields[1].getKind(), FieldKind::Array);
+    EXPECT_EQ(fields[1].getCount(), 10u);
+    EXPECT_EQ(fields[1].getTotalBits(), 120u);
+    EXPECT_EQ(fields[2].getKind(), FieldKind::Bytes);
+    EXPECT_EQ(fields[2].bit_width(), 8);
+    EXPECT_EQ(fields[2].getCount(), 16u);
+    EXPECT_EQ(fields[3].getCount(), 32u);
+    EXPECT_EQ(config.getTotalBits(), 3u + 120u + 128u + 256u);
+
+    const auto& layout = config.getLayout();
+    EXPECT_TRUE(layout.hasBlocks());
+    EXPECT_TRUE(layout.hasDefaultOrder());
+    EXPECT_TRUE(layout.isScalar(0));
+    EXPECT_FALSE(layout.isScalar(1));
+    EXPECT_EQ(layout.byteOffsets(), (std::vector<uint32_t>{0, 0, 15, 31}));
+    EXPECT_EQ(layout.shifts(), (std::vector<uint8_t>{0, 3, 3, 3}));
+    EXPECT_EQ(layout.elementCounts(), (std::vector<uint32_t>{1, 10, 16, 32}));
+    EXPECT_EQ(layout.blockOffsets(), (std::vector<uint32_t>{0, 0, 15, 31}));
+    EXPECT_EQ(layout.getBlockBytes(), 15u + 16u + 32u);
+    EXPECT_FALSE(message_config->getLayout().hasBlocks());
+}
+
+TEST_F(MessageConfigTest, InvalidArrayAndBytesFieldsThrow) {
+    MessageConfig config;
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bit_width": 8, "count": 0}])"_json), std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bit_width": 65, "count": 2}])"_json), std::runtime_error);
+    // Wide fields must be whole unsigned bytes
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bit_width": 100}])"_json), std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bit_width": 128, "signed": true}])"_json),
+                 std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bytes": 0}])"_json), std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bytes": 4, "bit_width": 8}])"_json), std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bytes": 4, "byte_order": "big"}])"_json),
+                 std::runtime_error);
+    EXPECT_THROW(config.setConfig(R"([{"name": "a", "bytes": -1}])"_json), std::runtime_error);
+    EXPECT_THROW(FieldConfig("a", FieldKind::Scalar, 8, 2, false, BitOrder::LsbFirst, ByteOrder::Little),
+                 std::runtime_error);
+    EXPECT_THROW(FieldConfig("a", FieldKind::Bytes, 16, 2, false, BitOrder::LsbFirst, ByteOrder::Little),
+                 std::runtime_error);
+}
@@ -0,0 +1,269 @@
+#include "MessageContainer.hpp"
+#include "BinaryMessageFactory.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+class MessageContainerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        nlohmann::json config = R"({
+            "sensor_data": [
+                {"name": "sensor_id", "bit_width": 6, "signed": false},
+                {"name": "temperature", "bit_width": 10, "signed": true}
+            ],
+            "status": [
+                {"name": "code", "bit_width": 8, "signed": false},
+                {"name": "uptime", "bit_width": 40, "signed": false}
+            ]
+        })"_json;
+        factory = std::make_unique<BinaryMessageFactory>(config);
+    }
+
+    // Alternates sensor_data and status frames with values derived from the index
+    std::string writeStream(size_t count, size_t blockFrames, bool finish = true) {
+        std::ostringstream out;
+        {
+            ContainerWriter writer(out, *factory, blockFrames);
+            auto sensor = factory->createMessage("sensor_data");
+            auto status = factory->createMessage("status");
+            for (size_t i = 0; i < count; ++i) {
+                if (i % 3 == 2) {
+                    status->setField("code", static_cast<int64_t>(i % 256));
+                    status->setField("uptime", static_cast<int64_t>(i) * 1000);
+                    writer.write(*status);
+                } else {
+                    sensor->setField("sensor_id", static_cast<int64_t>(i % 64));
+                    sensor->setField("temperature", static_cast<int64_t>(i % 1000) - 500);
+                    writer.write(*sensor);
+                }
+            }
+            if (finish) {
+                writer.finish();
+            } else {
+                writer.flush();
+                return out.str();
+            }
+            EXPECT_EQ(writer.getFrameCount(), count);
+        }
+        return out.str();
+    }
+
+    void expectFrame(ContainerReader& reader, const ContainerFrame& frame) {
+        BinaryMessage message(reader.getSchema(frame.typeId));
+        message.unpackFrom(frame.payload.data, frame.payload.size);
+        uint64_t i = frame.index;
+        if (i % 3 == 2) {
+            ASSERT_EQ(reader.getTypeName(frame.typeId), "status");
+            EXPECT_EQ(message.getField("code"), static_cast<int64_t>(i % 256));
+            EXPECT_EQ(message.getField("uptime"), static_cast<int64_t>(i) * 1000);
+        } else {
+            ASSERT_EQ(reader.getTypeName(frame.typeId), "sensor_data");
+            EXPECT_EQ(message.getField("sensor_id"), static_cast<int64_t>(i % 64));
+            EXPECT_EQ(message.getField("temperature"), static_cast<int64_t>(i % 1000) - 500);
+        }
+    }
+
+    std::unique_ptr<BinaryMessageFactory> factory;
+};
+
+TEST_F(MessageContainerTest, RoundTripMixedTypes) {
+    std::string bytes = writeStream(1000, 64);
+    ContainerReader reader(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+
+    ASSERT_EQ(reader.getTypeCount(), 2u);
+    EXPECT_EQ(reader.getTypeId("sensor_data"), 0u);
+    EXPECT_EQ(reader.getTypeId("status"), 1u);
+    // Schemas are interned, so they are the factory's own
+    EXPECT_EQ(reader.getSchema(0), factory->getSchema("sensor_data"));
+    EXPECT_TRUE(reader.hasIndex());
+    EXPECT_EQ(reader.getFrameCount(), 1000u);
+
+    ContainerFrame frame;
+    size_t count = 0;
+    while (reader.next(frame)) {
+        EXPECT_EQ(frame.index, count);
+        expectFrame(reader, frame);
+        ++count;
+    }
+    EXPECT_EQ(count, 1000u);
+
+    // Frames carry 1-byte type id and size varints on top of the payload
+    EXPECT_LT(bytes.size(), 1000u * (2 + 6) + 512);
+}
+
+TEST_F(MessageContainerTest, SeekThroughBlockIndex) {
+    std::string bytes = writeStream(1000, 64);
+    ContainerReader reader(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+
+    ContainerFrame frame;
+    for (uint64_t index : {0u, 63u, 64u, 65u, 500u, 999u}) {
+        reader.seek(index);
+        ASSERT_TRUE(reader.next(frame));
+        EXPECT_EQ(frame.index, index);
+        expectFrame(reader, frame);
+    }
+
+    reader.seek(1000);
+    EXPECT_FALSE(reader.next(frame));
+    EXPECT_THROW(reader.seek(1001), std::runtime_error);
+
+    reader.rewind();
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_EQ(frame.index, 0u);
+}
+
+TEST_F(MessageContainerTest, UnfinishedStreamReadsSequentially) {
+    std::string bytes = writeStream(300, 100, false);
+    // Drop part of a block, as if the writer were still running
+    bytes.resize(bytes.size() - 10);
+    ContainerReader reader(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+
+    EXPECT_FALSE(reader.hasIndex());
+    EXPECT_THROW(reader.seek(0), std::runtime_error);
+
+    ContainerFrame frame;
+    size_t count = 0;
+    while (reader.next(frame)) {
+        expectFrame(reader, frame);
+        ++count;
+    }
+    EXPECT_EQ(count, 200u);
+}
+
+TEST_F(MessageContainerTest, UnpackIntoMessage) {
+    std::string bytes = writeStream(2, 16);
+    ContainerReader reader(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+
+    BinaryMessage sensor(reader.getSchema(0));
+    BinaryMessage status(reader.getSchema(1));
+    ContainerFrame frame;
+    ASSERT_TRUE(reader.next(frame, sensor));
+    EXPECT_EQ(sensor.getField("temperature"), -500);
+    EXPECT_THROW(reader.next(frame, status), std::runtime_error);
+}
+
+TEST_F(MessageContainerTest, MatchesPlainConfigsByLayout) {
+    // Same layout as the factory's sensor_data, spelled with explicit default orders
+    MessageConfig sensorConfig(R"({"bit_order": "lsb_first", "byte_order": "little", "fields": [
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true}
+    ]})"_json);
+    MessageConfig widerConfig(R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 12, "signed": true}
+    ])"_json);
+
+    std::ostringstream out;
+    {
+        ContainerWriter writer(out, *factory);
+        BinaryMessage sensor(sensorConfig);
+        sensor.setField("sensor_id", 9);
+        sensor.setField("temperature", -42);
+        writer.write(sensor);
+        EXPECT_THROW(writer.write(BinaryMessage(widerConfig)), std::runtime_error);
+        writer.finish();
+    }
+
+    std::string bytes = out.str();
+    ContainerReader reader(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    ContainerFrame frame;
+    BinaryMessage sensor(sensorConfig);
+    ASSERT_TRUE(reader.next(frame, sensor));
+    EXPECT_EQ(reader.getTypeName(frame.typeId), "sensor_data");
+    EXPECT_EQ(sensor.getField("sensor_id"), 9);
+    EXPECT_EQ(sensor.getField("temperature"), -42);
+
+    reader.rewind();
+    BinaryMessage wider(widerConfig);
+    EXPECT_THROW(reader.next(frame, wider), std::runtime_error);
+}
+
+TEST_F(MessageContainerTest, RejectsMalformedInput) {
+    std::string bytes = writeStream(10, 4);
+
+    std::string badMagic = bytes;
+    badMagic[0] = 'X';
+    EXPECT_THROW(ContainerReader(reinterpret_cast<const uint8_t*>(badMagic.data()), badMagic.size()),
+                 std::runtime_error);
+
+    std::string truncatedHeader = bytes.substr(0, 12);
+    EXPECT_THROW(ContainerReader(reinterpret_cast<const uint8_t*>(truncatedHeader.data()), truncatedHeader.size()),
+                 std::runtime_error);
+
+    std::ostringstream out;
+    ContainerWriter writer(out, *factory);
+    EXPECT_THROW(writer.writeFrame(7, nullptr, 0), std::runtime_error);
+    MessageConfig unregistered(R"([{"name": "x", "bit_width": 3, "signed": false}])"_json);
+    EXPECT_THROW(writer.write(BinaryMessage(unregistered)), std::runtime_error);
+}
+
+TEST_F(MessageContainerTest, PreservesWireOrders) {
+    nlohmann::json config = R"({
+        "header": {"bit_order": "msb_first", "fields": [
+            {"name": "version", "bit_width": 4, "signed": false},
+            {"name": "length", "bit_width": 12, "signed": false},
+            {"name": "crc", "bit_width": 16, "signed": false, "byte_order": "little"}
+        ]}
+    })"_json;
+    BinaryMessageFactory headers(config);
+
+    std::ostringstream out;
+    ContainerWriter writer(out, headers);
+    auto message = headers.createMessage("header");
+    message->setField("version", 4);
+    message->setField("length", 1500);
+    message->setField("crc", 0xBEEF);
+    writer.write(*message);
+    writer.finish();
+
+    std::string bytes = out.str();
+    ContainerReader reader(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    // The decoded definition interns to the factory's own schema
+    EXPECT_EQ(reader.getSchema(0), headers.getSchema("header"));
+
+    ContainerFrame frame;
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_EQ(std::vector<uint8_t>(frame.payload.data, frame.payload.data + frame.payload.size),
+              (std::vector<uint8_t>{0x45, 0xDC, 0xEF, 0xBE}));
+}
+
+TEST_F(MessageContainerTest, PreservesArrayAndBytesFields) {
+    nlohmann::json config = R"({
+        "trace": [
+            {"name": "id", "bytes": 16},
+            {"name": "levels", "bit_width": 10, "signed": true, "count": 6},
+            {"name": "tag", "bytes": 3}
+        ]
+    })"_json;
+    BinaryMessageFactory traces(config);
+
+    std::ostringstream out;
+    ContainerWriter writer(out, traces);
+    auto message = traces.createMessage("trace");
+    const int64_t levels[6] = {-512, -1, 0, 1, 300, 511};
+    const uint8_t tag[3] = {'a', 'b', 'c'};
+    message->setArray("levels", levels, 6);
+    message->setBytes("tag", tag, 3);
+    message->setElement(traces.getMessageConfig("trace").getFieldHandle("id"), 15, 0x80);
+    writer.write(*message);
+    writer.finish();
+
+    std::string bytes = out.str();
+    ContainerReader reader(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    EXPECT_EQ(reader.getSchema(0), traces.getSchema("trace"));
+
+    ContainerFrame frame;
+    ASSERT_TRUE(reader.next(frame));
+    BinaryMessage decoded(*reader.getSchema(0));
+    decoded.unpackFrom(frame.payload.data, frame.payload.size);
+    EXPECT_EQ(decoded.pack(), message->pack());
+    int64_t levelsOut[6];
+    decoded.getArray("levels", levelsOut, 6);
+    EXPECT_TRUE(std::equal(levels, levels + 6, levelsOut));
+}
@@ -0,0 +1,37 @@
+#include "AllocationCounter.hpp"
+#include "BinaryMessageFactory.hpp"
+#include "MessagePool.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+using namespace BinaryMessageLibrary;
+using Testing::allocationCount;
+
+TEST(MessagePoolAllocationTest, WarmPoolDoesNotAllocate) {
+    BinaryMessageFactory factory(R"({
+        "sensor_data": [
+            {"name": "sensor_id", "bit_width": 6, "signed": false},
+            {"name": "temperature", "bit_width": 10, "signed": true}
+        ]
+    })"_json);
+    auto& pool = factory.getMessagePool("sensor_data");
+    pool.reserve(4);
+    auto handle = pool.getConfig().getFieldHandle("temperature");
+
+    size_t before = allocationCount();
+    for (int i = 0; i < 1000; ++i) {
+        auto a = factory.acquire("sensor_data");
+        auto b = factory.acquire("sensor_data");
+        a->setField(handle, i % 500);
+        b->setField(handle, -(i % 500));
+        uint8_t buffer[8];
+        a->packInto(buffer, sizeof(buffer));
+        b->unpackFrom(buffer, sizeof(buffer));
+    }
+    EXPECT_EQ(allocationCount() - before, 0u);
+
+    // createMessage pays two allocations per message: object and values
+    before = allocationCount();
+    auto message = factory.createMessage("sensor_data");
+    EXPECT_EQ(allocationCount() - before, 2u);
+}
@@ -0,0 +1,86 @@
+#include "MessagePool.hpp"
+#include "BinaryMessageFactory.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+class MessagePoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        nlohmann::json config = R"({
+            "sensor_data": [
+                {"name": "sensor_id", "bit_width": 6, "signed": false},
+                {"name": "temperature", "bit_width": 10, "signed": true}
+            ],
+            "status": [
+                {"name": "code", "bit_width": 8, "signed": false}
+            ]
+        })"_json;
+
+        factory = std::make_unique<BinaryMessageFactory>(config);
+    }
+
+    std::unique_ptr<BinaryMessageFactory> factory;
+};
+
+TEST_F(MessagePoolTest, AcquireReturnsZeroedMessage) {
+    auto message = factory->acquire("sensor_data");
+    ASSERT_NE(message, nullptr);
+    EXPECT_EQ(&message->getConfig(), &factory->getMessageConfig("sensor_data"));
+    EXPECT_EQ(message->getField("sensor_id"), 0);
+    EXPECT_EQ(message->getField("temperature"), 0);
+
+    EXPECT_THROW(factory->acquire("unknown"), std::runtime_error);
+}
+
+TEST_F(MessagePoolTest, ReleasedMessagesAreReusedAndReset) {
+    BinaryMessage* first;
+    {
+        auto message = factory->acquire("sensor_data");
+        message->setField("sensor_id", 42);
+        message->setField("temperature", -100);
+        first = message.get();
+    }
+
+    auto& pool = factory->getMessagePool("sensor_data");
+    EXPECT_EQ(pool.getCapacity(), 1u);
+    EXPECT_EQ(pool.getAvailable(), 1u);
+
+    auto again = factory->acquire("sensor_data");
+    EXPECT_EQ(again.get(), first);
+    EXPECT_EQ(again->getField("sensor_id"), 0);
+    EXPECT_EQ(again->getField("temperature"), 0);
+    EXPECT_EQ(pool.getAvailable(), 0u);
+
+    // A second live message needs a new object
+    auto other = factory->acquire("sensor_data");
+    EXPECT_NE(other.get(), first);
+    EXPECT_EQ(pool.getCapacity(), 2u);
+}
+
+TEST_F(MessagePoolTest, ConcurrentAcquireRelease) {
+    MessagePool pool(factory->getMessageConfig("status"), 4);
+    const int threadCount = 8;
+    const int iterations = 2000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&pool, t]() {
+            for (int i = 0; i < iterations; ++i) {
+                auto message = pool.acquire();
+                EXPECT_EQ(message->getField("code"), 0);
+                message->setField("code", (t * 31 + i) % 256);
+                EXPECT_EQ(message->getField("code"), (t * 31 + i) % 256);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool.getAvailable(), pool.getCapacity());
+    EXPECT_LE(pool.getCapacity(), static_cast<size_t>(threadCount));
+}
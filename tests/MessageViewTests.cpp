@@ -0,0 +1,158 @@
+#include "MessageView.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+class MessageViewTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        nlohmann::json definition = nlohmann::json::array();
+        std::mt19937 rng(8);
+        for (size_t i = 0; i < 40; ++i) {
+            unsigned width = 1 + rng() % 64;
+            definition.push_back({{"name", "field_" + std::to_string(i)},
+                                  {"bit_width", width},
+                                  {"signed", width > 1 && rng() % 2 == 0}});
+        }
+        config = std::make_unique<MessageConfig>(definition);
+    }
+
+    std::unique_ptr<MessageConfig> config;
+};
+
+TEST_F(MessageViewTest, FieldsMatchUnpackedMessage) {
+    std::mt19937_64 rng(4);
+    std::vector<uint8_t> buffer(config->getLayout().getTotalBytes());
+    BinaryMessage message(*config);
+
+    for (int round = 0; round < 20; ++round) {
+        for (auto& byte : buffer) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        message.unpack(buffer);
+        MessageView view(*config, buffer.data(), buffer.size());
+
+        for (size_t i = 0; i < config->getFields().size(); ++i) {
+            FieldHandle handle(static_cast<uint32_t>(i));
+            ASSERT_EQ(view.getField(handle), message.getField(handle)) << "field " << i;
+        }
+        EXPECT_EQ(view.getField("field_7"), message.getField("field_7"));
+    }
+}
+
+TEST_F(MessageViewTest, ReadsFieldsOfPackedMessage) {
+    MessageConfig sensor(R"([
+        {"name": "device_id", "bit_width": 12, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true}
+    ])"_json);
+    BinaryMessage message(sensor);
+    message.setField("device_id", 4000);
+    message.setField("temperature", -300);
+    auto packed = message.pack();
+
+    MessageView view(sensor, FrameView{packed.data(), packed.size()});
+    EXPECT_EQ(view.getField("device_id"), 4000);
+    EXPECT_EQ(view.getField("temperature"), -300);
+    EXPECT_EQ(view.getPackedSize(), 3u);
+    EXPECT_EQ(view.data(), packed.data());
+    EXPECT_EQ(&view.getConfig(), &sensor);
+}
+
+TEST_F(MessageViewTest, RejectsBadInput) {
+    std::vector<uint8_t> buffer(config->getLayout().getTotalBytes());
+    EXPECT_THROW(MessageView(*config, buffer.data(), buffer.size() - 1), std::runtime_error);
+
+    MessageView view(*config, buffer.data(), buffer.size());
+    EXPECT_THROW(view.getField("missing"), std::runtime_error);
+    EXPECT_THROW(view.getField(FieldHandle()), std::runtime_error);
+    EXPECT_THROW(view.getField(FieldHandle(40)), std::runtime_error);
+}
+
+TEST_F(MessageViewTest, PatchesOnlyTheTargetField) {
+    std::mt19937_64 rng(12);
+    std::vector<uint8_t> buffer(config->getLayout().getTotalBytes());
+    BinaryMessage expected(*config);
+
+    for (int round = 0; round < 20; ++round) {
+        for (auto& byte : buffer) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        // Clear the padding bits so the buffer is exactly what pack() produces
+        expected.unpack(buffer);
+        buffer = expected.pack();
+
+        MutableMessageView view(*config, buffer.data(), buffer.size());
+        for (size_t i = 0; i < config->getFields().size(); i += 3) {
+            const FieldConfig& field = config->getFields()[i];
+            uint64_t span = static_cast<uint64_t>(field.getMaxValue()) - static_cast<uint64_t>(field.getMinValue());
+            int64_t value = static_cast<int64_t>(static_cast<uint64_t>(field.getMinValue()) +
+                                                 (span == UINT64_MAX ? rng() : rng() % (span + 1)));
+            FieldHandle handle(static_cast<uint32_t>(i));
+            view.setField(handle, value);
+            expected.setField(handle, value);
+            ASSERT_EQ(view.getField(handle), value) << "field " << i;
+        }
+        ASSERT_EQ(buffer, expected.pack());
+    }
+}
+
+TEST_F(MessageViewTest, ForwardingRewritesHeaderInPlace) {
+    MessageConfig header(R"([
+        {"name": "version", "bit_width": 3, "signed": false},
+        {"name": "hop_count", "bit_width": 5, "signed": false},
+        {"name": "flags", "bit_width": 4, "signed": false},
+        {"name": "payload_length", "bit_width": 12, "signed": false}
+    ])"_json);
+    BinaryMessage message(header);
+    message.setField("version", 2);
+    message.setField("hop_count", 7);
+    message.setField("flags", 0b1010);
+    message.setField("payload_length", 1500);
+    auto frame = message.pack();
+
+    MutableMessageView view(header, frame.data(), frame.size());
+    FieldHandle hops = header.getFieldHandle("hop_count");
+    view.setField(hops, view.getField(hops) + 1);
+    view.setField("flags", view.getField("flags") | 0b0001);
+
+    message.unpack(frame);
+    EXPECT_EQ(message.getField("version"), 2);
+    EXPECT_EQ(message.getField("hop_count"), 8);
+    EXPECT_EQ(message.getField("flags"), 0b1011);
+    EXPECT_EQ(message.getField("payload_length"), 1500);
+
+    // Only a non-const view hands out a writable pointer
+    const MutableMessageView& readOnly = view;
+    static_assert(std::is_same_v<decltype(readOnly.data()), const uint8_t*>, "const view is read-only");
+    EXPECT_EQ(view.data(), frame.data());
+}
+
+TEST_F(MessageViewTest, MutationValidatesValues) {
+    MessageConfig header(R"([
+        {"name": "hop_count", "bit_width": 5, "signed": false},
+        {"name": "offset", "bit_width": 6, "signed": true}
+    ])"_json);
+    std::vector<uint8_t> frame = {0x5A, 0x03};
+    MutableMessageView view(header, frame.data(), frame.size());
+
+    EXPECT_THROW(view.setField("hop_count", 32), std::runtime_error);
+    EXPECT_THROW(view.setField("hop_count", -1), std::runtime_error);
+    EXPECT_THROW(view.setField("offset", 32), std::runtime_error);
+    EXPECT_THROW(view.setField("offset", -33), std::runtime_error);
+    EXPECT_THROW(view.setField("missing", 0), std::runtime_error);
+    EXPECT_THROW(view.setField(FieldHandle(), 0), std::runtime_error);
+    EXPECT_EQ(frame, (std::vector<uint8_t>{0x5A, 0x03}));
+
+    view.setField("offset", -32);
+    EXPECT_EQ(view.getField("offset"), -32);
+    EXPECT_EQ(view.getField("hop_count"), 0x1A);
+    EXPECT_THROW(MutableMessageView(header, frame.data(), 1), std::runtime_error);
+}
@@ -0,0 +1,117 @@
+#include "SchemaRegistry.hpp"
+#include "BinaryMessage.hpp"
+#include "BinaryMessageFactory.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+class SchemaRegistryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        sensorDefinition = R"([
+            {"name": "sensor_id", "bit_width": 6, "signed": false},
+            {"name": "temperature", "bit_width": 10, "signed": true}
+        ])"_json;
+    }
+
+    nlohmann::json sensorDefinition;
+};
+
+TEST_F(SchemaRegistryTest, EqualDefinitionsShareOneSchema) {
+    SchemaRegistry registry;
+    MessageSchema first = registry.intern(sensorDefinition);
+
+    // Key order inside a field object does not matter
+    MessageSchema second = registry.intern(R"([
+        {"signed": false, "bit_width": 6, "name": "sensor_id"},
+        {"bit_width": 10, "name": "temperature", "signed": true}
+    ])"_json);
+    EXPECT_EQ(first, second);
+
+    MessageSchema other = registry.intern(R"([
+        {"name": "sensor_id", "bit_width": 7, "signed": false}
+    ])"_json);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(registry.size(), 2u);
+
+    EXPECT_THROW(registry.intern(R"([{"name": "x", "bit_width": 0, "signed": false}])"_json),
+                 std::runtime_error);
+
+    // Spelling out the default wire order describes the same schema
+    MessageSchema explicitOrder = registry.intern(nlohmann::json{
+        {"bit_order", "lsb_first"}, {"byte_order", "little"}, {"fields", sensorDefinition}});
+    EXPECT_EQ(explicitOrder, first);
+    EXPECT_EQ(registry.size(), 2u);
+}
+
+TEST_F(SchemaRegistryTest, UnusedSchemasExpire) {
+    SchemaRegistry registry;
+    std::weak_ptr<const MessageConfig> weak;
+    {
+        MessageSchema schema = registry.intern(sensorDefinition);
+        weak = schema;
+        EXPECT_EQ(registry.size(), 1u);
+    }
+    EXPECT_TRUE(weak.expired());
+    EXPECT_EQ(registry.size(), 0u);
+
+    MessageSchema fresh = registry.intern(sensorDefinition);
+    EXPECT_EQ(fresh->getFields().size(), 2u);
+}
+
+TEST_F(SchemaRegistryTest, FactoriesShareInternedSchemas) {
+    nlohmann::json config = {{"sensor_data", sensorDefinition}};
+    BinaryMessageFactory first(config);
+    BinaryMessageFactory second(config);
+
+    EXPECT_EQ(first.getSchema("sensor_data"), second.getSchema("sensor_data"));
+    EXPECT_EQ(&first.getMessageConfig("sensor_data"), &second.getMessageConfig("sensor_data"));
+}
+
+TEST_F(SchemaRegistryTest, MessageOutlivesFactory) {
+    std::unique_ptr<BinaryMessage> message;
+    {
+        BinaryMessageFactory factory(nlohmann::json{{"sensor_data", sensorDefinition}});
+        message = factory.createMessage("sensor_data");
+    }
+
+    message->setField("temperature", -12);
+    auto packed = message->pack();
+    EXPECT_EQ(packed.size(), 2u);
+    EXPECT_EQ(message->getSchema()->getFields().size(), 2u);
+}
+
+TEST_F(SchemaRegistryTest, MessagesCopyMoveAndCrossThreads) {
+    MessageSchema schema = SchemaRegistry::global().intern(sensorDefinition);
+    BinaryMessage message(schema);
+    message.setField("sensor_id", 33);
+
+    BinaryMessage copy = message;
+    copy.setField("sensor_id", 34);
+    EXPECT_EQ(message.getField("sensor_id"), 33);
+    EXPECT_EQ(copy.getSchema(), schema);
+
+    BinaryMessage moved = std::move(copy);
+    EXPECT_EQ(moved.getField("sensor_id"), 34);
+    EXPECT_EQ(&moved.getConfig(), schema.get());
+
+    std::vector<BinaryMessage> results(4, message);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&results, t]() {
+            results[t].setField("temperature", static_cast<int64_t>(t) * 100 - 200);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < results.size(); ++t) {
+        EXPECT_EQ(results[t].getField("temperature"), static_cast<int64_t>(t) * 100 - 200);
+        EXPECT_EQ(results[t].getSchema(), schema);
+    }
+
+    EXPECT_THROW(BinaryMessage{MessageSchema{}}, std::runtime_error);
+}
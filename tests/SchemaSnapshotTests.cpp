@@ -0,0 +1,215 @@
+#include "SchemaSnapshot.hpp"
+#include "BinaryMessageFactory.hpp"
+#include "ByteIO.hpp"
+#include "SchemaEncoding.hpp"
+#include "SchemaRegistry.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+const char* kConfigText = R"({
+    "sensor": [
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "samples", "bit_width": 12, "signed": true, "count": 4},
+        {"name": "trace_id", "bytes": 16}
+    ],
+    "wire": {"bit_order": "msb_first", "byte_order": "little", "fields": [
+        {"name": "version", "bit_width": 4, "signed": false},
+        {"name": "crc", "bit_width": 16, "signed": false, "byte_order": "big"},
+        {"name": "flags", "bit_width": 5, "signed": false, "bit_order": "lsb_first"}
+    ]}
+})";
+
+void expectSameLayout(const MessageConfig& actual, const MessageConfig& expected) {
+    ASSERT_EQ(actual.getFields().size(), expected.getFields().size());
+    EXPECT_EQ(actual.getBitOrder(), expected.getBitOrder());
+    EXPECT_EQ(actual.getByteOrder(), expected.getByteOrder());
+    EXPECT_EQ(actual.getTotalBits(), expected.getTotalBits());
+    for (size_t i = 0; i < expected.getFields().size(); ++i) {
+        const FieldConfig& a = actual.getFields()[i];
+        const FieldConfig& e = expected.getFields()[i];
+        EXPECT_EQ(a.name(), e.name());
+        EXPECT_EQ(a.getKind(), e.getKind());
+        EXPECT_EQ(a.bit_width(), e.bit_width());
+        EXPECT_EQ(a.getCount(), e.getCount());
+        EXPECT_EQ(a.is_signed(), e.is_signed());
+        EXPECT_EQ(a.getBitOrder(), e.getBitOrder());
+        EXPECT_EQ(a.getByteOrder(), e.getByteOrder());
+    }
+    EXPECT_EQ(actual.getLayout().orderFlags(), expected.getLayout().orderFlags());
+}
+
+} // namespace
+
+TEST(SchemaSnapshotTest, RoundTripsFactoryTypes) {
+    BinaryMessageFactory source(nlohmann::json::parse(kConfigText));
+    std::vector<uint8_t> snapshot;
+    source.writeSnapshot(snapshot, 42);
+
+    BinaryMessageFactory loaded;
+    EXPECT_TRUE(loaded.getMessageTypes().empty());
+    ASSERT_TRUE(loaded.loadSnapshot(snapshot.data(), snapshot.size(), 42));
+    auto types = loaded.getMessageTypes();
+    std::sort(types.begin(), types.end());
+    EXPECT_EQ(types, (std::vector<std::string>{"sensor", "wire"}));
+    for (const auto& type : types) {
+        expectSameLayout(loaded.getMessageConfig(type), source.getMessageConfig(type));
+    }
+
+    // Messages of either factory read each other's frames
+    auto message = source.createMessage("wire");
+    message->setField("version", 9);
+    message->setField("crc", 0xBEEF);
+    message->setField("flags", 17);
+    auto decoded = loaded.createMessage("wire");
+    decoded->unpack(message->pack());
+    EXPECT_EQ(decoded->getField("crc"), 0xBEEF);
+    EXPECT_EQ(decoded->getField("flags"), 17);
+
+    // Loading the snapshot again shares the schemas, as does loading the JSON
+    BinaryMessageFactory again;
+    ASSERT_TRUE(again.loadSnapshot(snapshot.data(), snapshot.size(), 42));
+    EXPECT_EQ(again.getSchema("sensor"), loaded.getSchema("sensor"));
+    EXPECT_EQ(loaded.getSchema("sensor"), source.getSchema("sensor"));
+    EXPECT_EQ(loaded.getSchema("wire"), source.getSchema("wire"));
+
+    // Switching a factory between the JSON and its snapshot keeps its pools
+    MessagePool* pool = &source.getMessagePool("wire");
+    ASSERT_TRUE(source.loadSnapshot(snapshot.data(), snapshot.size(), 42));
+    EXPECT_EQ(&source.getMessagePool("wire"), pool);
+}
+
+TEST(SchemaSnapshotTest, StaleSnapshotsAreRejected) {
+    BinaryMessageFactory source(nlohmann::json::parse(kConfigText));
+    std::vector<uint8_t> snapshot;
+    source.writeSnapshot(snapshot, 42);
+
+    BinaryMessageFactory factory(R"({"other": [{"name": "a", "bit_width": 3, "signed": false}]})"_json);
+    // Another source, a damaged body, another version, a truncated file
+    EXPECT_FALSE(factory.loadSnapshot(snapshot.data(), snapshot.size(), 43));
+    std::vector<uint8_t> damaged = snapshot;
+    damaged.back() ^= 0x01;
+    EXPECT_FALSE(factory.loadSnapshot(damaged.data(), damaged.size(), 42));
+    std::vector<uint8_t> versioned = snapshot;
+    versioned[4] = SchemaSnapshot::kVersion + 1;
+    EXPECT_FALSE(factory.loadSnapshot(versioned.data(), versioned.size(), 42));
+    EXPECT_FALSE(factory.loadSnapshot(snapshot.data(), snapshot.size() - 1, 42));
+    EXPECT_FALSE(factory.loadSnapshot(snapshot.data(), 3, 42));
+    EXPECT_FALSE(factory.loadSnapshot(nullptr, 0, 42));
+    // The factory keeps its types throughout
+    EXPECT_EQ(factory.getMessageTypes(), std::vector<std::string>{"other"});
+}
+
+TEST(SchemaSnapshotTest, DecodesSchemasWithoutJson) {
+    BinaryMessageFactory source(nlohmann::json::parse(kConfigText));
+    for (const std::string type : {"sensor", "wire"}) {
+        const MessageConfig& config = source.getMessageConfig(type);
+        std::vector<uint8_t> encoded;
+        SchemaEncoding::encode(encoded, config);
+        ByteIO::Reader reader(encoded.data(), 0, encoded.size(), "schema");
+        expectSameLayout(SchemaEncoding::decodeConfig(reader), config);
+        EXPECT_EQ(reader.remaining(), 0u);
+    }
+
+    // Malformed schemas are reported, not built
+    std::vector<uint8_t> duplicate;
+    SchemaEncoding::encode(duplicate, MessageConfig(R"([{"name": "a", "bit_width": 3, "signed": false}])"_json));
+    std::vector<uint8_t> field(duplicate.begin() + 2, duplicate.end());
+    duplicate[1] = 2;
+    duplicate.insert(duplicate.end(), field.begin(), field.end());
+    EXPECT_THROW(SchemaRegistry::global().internEncoded(duplicate.data(), duplicate.size()), std::runtime_error);
+    const uint8_t badWidth[] = {0, 1, 1, 'a', 65, 0};
+    EXPECT_THROW(SchemaRegistry::global().internEncoded(badWidth, sizeof(badWidth)), std::runtime_error);
+    EXPECT_THROW(SchemaRegistry::global().internEncoded(badWidth, 4), std::runtime_error);
+}
+
+class SchemaSnapshotFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // One pair of files per test: ctest runs each test as its own process, in parallel
+        std::string base = ::testing::TempDir() + "schema_snapshot_" +
+                           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        configPath = base + ".json";
+        snapshotPath = base + ".bmss";
+        std::remove(snapshotPath.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(configPath.c_str());
+        std::remove(snapshotPath.c_str());
+    }
+
+    void writeFile(const std::string& path, const std::string& text) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << text;
+    }
+
+    std::string configPath;
+    std::string snapshotPath;
+};
+
+TEST_F(SchemaSnapshotFileTest, WritesSnapshotOnceAndReusesIt) {
+    writeFile(configPath, kConfigText);
+
+    BinaryMessageFactory first;
+    EXPECT_FALSE(first.loadConfigurationFile(configPath, snapshotPath));
+    EXPECT_TRUE(first.hasMessageType("sensor"));
+
+    BinaryMessageFactory second;
+    EXPECT_TRUE(second.loadConfigurationFile(configPath, snapshotPath));
+    for (const std::string type : {"sensor", "wire"}) {
+        expectSameLayout(second.getMessageConfig(type), first.getMessageConfig(type));
+    }
+
+    // An edited configuration makes the snapshot stale; it is rebuilt
+    std::string edited = kConfigText;
+    edited.replace(edited.find("\"bit_width\": 6"), 14, "\"bit_width\": 7");
+    writeFile(configPath, edited);
+    BinaryMessageFactory third;
+    EXPECT_FALSE(third.loadConfigurationFile(configPath, snapshotPath));
+    EXPECT_EQ(third.getMessageConfig("sensor").getFields()[0].bit_width(), 7);
+    BinaryMessageFactory fourth;
+    EXPECT_TRUE(fourth.loadConfigurationFile(configPath, snapshotPath));
+    EXPECT_EQ(fourth.getMessageConfig("sensor").getFields()[0].bit_width(), 7);
+
+    // Temporary files are renamed into place, none are left behind
+    std::filesystem::path snapshot(snapshotPath);
+    for (const auto& entry : std::filesystem::directory_iterator(snapshot.parent_path())) {
+        std::string name = entry.path().filename().string();
+        EXPECT_FALSE(name.rfind(snapshot.filename().string() + ".", 0) == 0) << name;
+    }
+}
+
+TEST_F(SchemaSnapshotFileTest, FallsBackToJson) {
+    writeFile(configPath, kConfigText);
+    writeFile(snapshotPath, "not a snapshot");
+
+    BinaryMessageFactory factory;
+    EXPECT_FALSE(factory.loadConfigurationFile(configPath, snapshotPath));
+    EXPECT_TRUE(factory.hasMessageType("wire"));
+
+    // Without a snapshot path only the JSON is used
+    BinaryMessageFactory plain;
+    EXPECT_FALSE(plain.loadConfigurationFile(configPath));
+    EXPECT_TRUE(plain.hasMessageType("sensor"));
+
+    // A snapshot that cannot be written does not prevent loading
+    BinaryMessageFactory unwritable;
+    EXPECT_FALSE(unwritable.loadConfigurationFile(configPath, ::testing::TempDir() + "missing_dir/cache.bmss"));
+    EXPECT_TRUE(unwritable.hasMessageType("sensor"));
+
+    writeFile(configPath, "{\"broken\": [");
+    EXPECT_THROW(factory.loadConfigurationFile(configPath, snapshotPath), std::runtime_error);
+    EXPECT_THROW(factory.loadConfigurationFile(configPath + ".missing"), std::runtime_error);
+    EXPECT_TRUE(factory.hasMessageType("wire"));
+}
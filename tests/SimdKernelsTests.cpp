@@ -0,0 +1,101 @@
+#include "SimdKernels.hpp"
+#include "BitCodec.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+const SimdLevel kAllLevels[] = {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512};
+
+} // namespace
+
+TEST(SimdKernelsTest, ActiveLevelIsDetectedLevel) {
+    EXPECT_EQ(SimdKernels::activeSimdLevel(), SimdKernels::detectSimdLevel());
+    EXPECT_STREQ(SimdKernels::simdLevelName(SimdLevel::Scalar), "scalar");
+    EXPECT_STREQ(SimdKernels::simdLevelName(SimdLevel::AVX2), "avx2");
+    EXPECT_STREQ(SimdKernels::simdLevelName(SimdLevel::AVX512), "avx512");
+}
+
+TEST(SimdKernelsTest, AllLevelsBitIdenticalToScalar) {
+    std::mt19937_64 rng(99);
+
+    for (size_t stride : {8u, 9u, 12u, 32u}) {
+        // Odd counts leave a remainder for the scalar tail of each kernel
+        const size_t count = 37;
+        std::vector<uint8_t> frames(count * stride + 8);
+        for (auto& byte : frames) {
+            byte = static_cast<uint8_t>(rng());
+        }
+
+        for (unsigned shift = 0; shift < 8; ++shift) {
+            for (unsigned width = 1; shift + width <= 64; width += 3) {
+                for (bool isSigned : {false, true}) {
+                    uint64_t mask = BitCodec::lowMask(width);
+                    unsigned signShift = isSigned ? 64 - width : 0;
+
+                    std::vector<int64_t> expected(count);
+                    for (size_t i = 0; i < count; ++i) {
+                        uint64_t raw = BitCodec::extractBits(frames.data(), frames.size(),
+                                                             i * stride * 8 + shift, width);
+                        expected[i] = isSigned ? BitCodec::signExtend(raw, width)
+                                               : static_cast<int64_t>(raw);
+                    }
+
+                    for (SimdLevel level : kAllLevels) {
+                        std::vector<int64_t> actual(count);
+                        SimdKernels::extractColumn(level, frames.data(), count, stride,
+                                                   shift, mask, signShift, actual.data());
+                        ASSERT_EQ(actual, expected)
+                            << SimdKernels::simdLevelName(level) << " stride " << stride
+                            << " shift " << shift << " width " << width << " signed " << isSigned;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(SimdKernelsTest, MatchRangeAllLevelsMatchScalar) {
+    std::mt19937_64 rng(7);
+
+    for (size_t stride : {8u, 11u, 32u}) {
+        for (size_t count : {1u, 5u, 37u, 64u}) {
+            std::vector<uint8_t> frames(count * stride + 8);
+            for (auto& byte : frames) {
+                byte = static_cast<uint8_t>(rng());
+            }
+
+            for (unsigned shift = 0; shift < 8; shift += 3) {
+                for (unsigned width : {1u, 7u, 10u, 33u, 56u}) {
+                    uint64_t mask = BitCodec::lowMask(width);
+                    for (uint64_t flip : {uint64_t(0), uint64_t(1) << (width - 1)}) {
+                        uint64_t lo = rng() & mask;
+                        uint64_t span = rng() & (mask >> 1);
+
+                        uint64_t expected = 0;
+                        for (size_t i = 0; i < count; ++i) {
+                            uint64_t raw = BitCodec::extractBits(frames.data(), frames.size(),
+                                                                 i * stride * 8 + shift, width);
+                            uint64_t key = raw ^ flip;
+                            if (key >= lo && key - lo <= span) {
+                                expected |= uint64_t(1) << i;
+                            }
+                        }
+
+                        for (SimdLevel level : kAllLevels) {
+                            uint64_t actual = SimdKernels::matchRange(level, frames.data(), count, stride,
+                                                                      shift, mask, flip, lo, span);
+                            ASSERT_EQ(actual, expected)
+                                << SimdKernels::simdLevelName(level) << " stride " << stride
+                                << " count " << count << " shift " << shift << " width " << width;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
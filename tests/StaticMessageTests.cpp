@@ -0,0 +1,127 @@
+#include "StaticMessage.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+BINARY_MESSAGE_FIELD_NAME(SensorId, "sensor_id");
+BINARY_MESSAGE_FIELD_NAME(Temperature, "temperature");
+BINARY_MESSAGE_FIELD_NAME(Humidity, "humidity");
+BINARY_MESSAGE_FIELD_NAME(BatteryLevel, "battery_level");
+BINARY_MESSAGE_FIELD_NAME(Pad, "pad");
+BINARY_MESSAGE_FIELD_NAME(Wide, "wide");
+
+using SensorData = StaticMessage<
+    Field<SensorId, 6>,
+    Field<Temperature, 10, true>,
+    Field<Humidity, 8>,
+    Field<BatteryLevel, 4>>;
+
+// Includes a 64-bit field that straddles the 8-byte word at its first byte
+using WideMessage = StaticMessage<
+    Field<Pad, 5>,
+    Field<Wide, 64, true>,
+    Field<BatteryLevel, 4>>;
+
+} // namespace
+
+TEST(StaticMessageTest, CompileTimeLayout) {
+    static_assert(SensorData::kFieldCount == 4, "field count");
+    static_assert(SensorData::kTotalBits == 28, "total bits");
+    static_assert(SensorData::kPackedSize == 4, "packed size");
+    static_assert(SensorData::bitOffset<2>() == 16, "humidity offset");
+    static_assert(WideMessage::kPackedSize == 10, "wide packed size");
+
+    EXPECT_STREQ(SensorData::fieldName(1), "temperature");
+}
+
+TEST(StaticMessageTest, FieldOperations) {
+    SensorData message;
+    message.set<SensorId>(15);
+    message.set<Temperature>(-125);
+    message.set<3>(12);
+
+    EXPECT_EQ(message.get<SensorId>(), 15);
+    EXPECT_EQ(message.get<1>(), -125);
+    EXPECT_EQ(message.get<BatteryLevel>(), 12);
+
+    EXPECT_THROW(message.set<Temperature>(512), std::runtime_error);
+    EXPECT_THROW(message.set<SensorId>(-1), std::runtime_error);
+}
+
+TEST(StaticMessageTest, EquivalentToJsonDefinition) {
+    nlohmann::json definition = R"([
+        {"name": "sensor_id", "bit_width": 6, "signed": false},
+        {"name": "temperature", "bit_width": 10, "signed": true},
+        {"name": "humidity", "bit_width": 8, "signed": false},
+        {"name": "battery_level", "bit_width": 4, "signed": false}
+    ])"_json;
+    EXPECT_EQ(SensorData::schema(), definition);
+
+    MessageConfig config(definition);
+    std::mt19937 rng(5);
+
+    for (int i = 0; i < 200; ++i) {
+        SensorData staticMessage;
+        BinaryMessage dynamicMessage(config);
+
+        int64_t sensorId = rng() % 64;
+        int64_t temperature = static_cast<int64_t>(rng() % 1024) - 512;
+        int64_t humidity = rng() % 256;
+        int64_t battery = rng() % 16;
+
+        staticMessage.set<SensorId>(sensorId);
+        staticMessage.set<Temperature>(temperature);
+        staticMessage.set<Humidity>(humidity);
+        staticMessage.set<BatteryLevel>(battery);
+        dynamicMessage.setField("sensor_id", sensorId);
+        dynamicMessage.setField("temperature", temperature);
+        dynamicMessage.setField("humidity", humidity);
+        dynamicMessage.setField("battery_level", battery);
+
+        auto staticPacked = staticMessage.pack();
+        auto dynamicPacked = dynamicMessage.pack();
+        ASSERT_EQ(std::vector<uint8_t>(staticPacked.begin(), staticPacked.end()), dynamicPacked);
+
+        SensorData unpacked;
+        unpacked.unpackFrom(dynamicPacked.data(), dynamicPacked.size());
+        EXPECT_EQ(unpacked.get<SensorId>(), sensorId);
+        EXPECT_EQ(unpacked.get<Temperature>(), temperature);
+        EXPECT_EQ(unpacked.get<Humidity>(), humidity);
+        EXPECT_EQ(unpacked.get<BatteryLevel>(), battery);
+    }
+}
+
+TEST(StaticMessageTest, WordCrossingFieldMatchesBinaryMessage) {
+    MessageConfig config(WideMessage::schema());
+
+    WideMessage staticMessage;
+    staticMessage.set<Pad>(19);
+    staticMessage.set<Wide>(INT64_MIN + 77);
+    staticMessage.set<BatteryLevel>(9);
+
+    BinaryMessage dynamicMessage(config);
+    dynamicMessage.setField("pad", 19);
+    dynamicMessage.setField("wide", INT64_MIN + 77);
+    dynamicMessage.setField("battery_level", 9);
+
+    auto staticPacked = staticMessage.pack();
+    EXPECT_EQ(std::vector<uint8_t>(staticPacked.begin(), staticPacked.end()), dynamicMessage.pack());
+
+    WideMessage unpacked;
+    EXPECT_EQ(unpacked.unpackFrom(staticPacked.data(), staticPacked.size()), WideMessage::kPackedSize);
+    EXPECT_EQ(unpacked.get<Wide>(), INT64_MIN + 77);
+    EXPECT_EQ(unpacked.get<Pad>(), 19);
+    EXPECT_EQ(unpacked.get<BatteryLevel>(), 9);
+
+    std::vector<uint8_t> small(3);
+    EXPECT_THROW(unpacked.unpackFrom(small.data(), small.size()), std::runtime_error);
+    EXPECT_THROW(staticMessage.packInto(small.data(), small.size()), std::runtime_error);
+}
@@ -0,0 +1,150 @@
+#include "StreamDecoder.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+class StreamDecoderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        nlohmann::json config = R"([
+            {"name": "sensor_id", "bit_width": 6, "signed": false},
+            {"name": "temperature", "bit_width": 10, "signed": true},
+            {"name": "wide", "bit_width": 62, "signed": true},
+            {"name": "flags", "bit_width": 5, "signed": false}
+        ])"_json;
+
+        messageConfig = std::make_unique<MessageConfig>(config);
+        frameSize = BinaryMessage(*messageConfig).getPackedSize();
+
+        // Random frames packed back to back, plus a few trailing bytes
+        std::mt19937_64 rng(11);
+        stream.resize(kFrames * frameSize + 3);
+        for (auto& byte : stream) {
+            byte = static_cast<uint8_t>(rng());
+        }
+
+        BinaryMessage message(*messageConfig);
+        expected.assign(messageConfig->getFields().size(), std::vector<int64_t>(kFrames));
+        for (size_t i = 0; i < kFrames; ++i) {
+            message.unpackFrom(stream.data() + i * frameSize, frameSize);
+            for (size_t f = 0; f < expected.size(); ++f) {
+                expected[f][i] = message.getField(FieldHandle(static_cast<uint32_t>(f)));
+            }
+        }
+    }
+
+    static constexpr size_t kFrames = 10007;
+
+    std::unique_ptr<MessageConfig> messageConfig;
+    size_t frameSize = 0;
+    std::vector<uint8_t> stream;
+    std::vector<std::vector<int64_t>> expected;
+};
+
+TEST_F(StreamDecoderTest, DecodeMatchesBinaryMessage) {
+    for (size_t threads : {1u, 2u, 5u}) {
+        StreamDecoder decoder(*messageConfig, threads, 256);
+        EXPECT_EQ(decoder.getFrameCount(stream.size()), kFrames);
+        EXPECT_EQ(decoder.decode(stream.data(), stream.size()), expected) << threads << " threads";
+    }
+}
+
+TEST_F(StreamDecoderTest, InputOrderDeliversChunksSequentially) {
+    StreamDecoder decoder(*messageConfig, 4, 100);
+    std::vector<std::vector<int64_t>> collected(expected.size());
+    size_t nextFrame = 0;
+
+    decoder.forEachChunk(stream.data(), stream.size(), [&](const DecodedChunk& chunk) {
+        EXPECT_EQ(chunk.firstFrame, nextFrame);
+        nextFrame += chunk.frameCount;
+        for (size_t f = 0; f < collected.size(); ++f) {
+            collected[f].insert(collected[f].end(), chunk.columns[f], chunk.columns[f] + chunk.frameCount);
+        }
+    });
+
+    EXPECT_EQ(nextFrame, kFrames);
+    EXPECT_EQ(collected, expected);
+}
+
+TEST_F(StreamDecoderTest, UnorderedDeliversEveryChunk) {
+    StreamDecoder decoder(*messageConfig, 3, 128);
+    std::vector<std::vector<int64_t>> collected(expected.size(), std::vector<int64_t>(kFrames));
+    std::mutex mutex;
+    size_t delivered = 0;
+
+    decoder.forEachChunk(stream.data(), stream.size(), [&](const DecodedChunk& chunk) {
+        for (size_t f = 0; f < collected.size(); ++f) {
+            std::copy(chunk.columns[f], chunk.columns[f] + chunk.frameCount,
+                      collected[f].begin() + static_cast<std::ptrdiff_t>(chunk.firstFrame));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        delivered += chunk.frameCount;
+    }, StreamOrder::Unordered);
+
+    EXPECT_EQ(delivered, kFrames);
+    EXPECT_EQ(collected, expected);
+}
+
+TEST_F(StreamDecoderTest, ConsumerExceptionStopsDelivery) {
+    StreamDecoder decoder(*messageConfig, 4, 64);
+    size_t calls = 0;
+    EXPECT_THROW(decoder.forEachChunk(stream.data(), stream.size(), [&](const DecodedChunk& chunk) {
+        ++calls;
+        if (chunk.firstFrame >= 640) {
+            throw std::runtime_error("consumer failed");
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(calls, 11u);
+
+    EXPECT_THROW(StreamDecoder(*messageConfig, 1, 0), std::runtime_error);
+}
+
+TEST_F(StreamDecoderTest, DecodeBetweenChunkPassesKeepsScratchColumns) {
+    StreamDecoder decoder(*messageConfig, 2, 512);
+    std::vector<std::vector<int64_t>> columns(expected.size(), std::vector<int64_t>(kFrames));
+    std::vector<int64_t*> pointers;
+    for (auto& column : columns) {
+        pointers.push_back(column.data());
+    }
+    auto insideColumns = [&](const int64_t* p) {
+        return std::any_of(columns.begin(), columns.end(), [p](const std::vector<int64_t>& column) {
+            return p >= column.data() && p < column.data() + column.size();
+        });
+    };
+
+    // Chunk passes before and after decode() into caller columns must decode
+    // into their own scratch, never into the caller's buffers
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<std::vector<int64_t>> collected(expected.size(), std::vector<int64_t>(kFrames));
+        std::mutex mutex;
+        decoder.forEachChunk(stream.data(), stream.size(), [&](const DecodedChunk& chunk) {
+            for (size_t f = 0; f < collected.size(); ++f) {
+                std::lock_guard<std::mutex> lock(mutex);
+                EXPECT_FALSE(insideColumns(chunk.columns[f]));
+                std::copy(chunk.columns[f], chunk.columns[f] + chunk.frameCount,
+                          collected[f].begin() + static_cast<std::ptrdiff_t>(chunk.firstFrame));
+            }
+        }, StreamOrder::Unordered);
+        EXPECT_EQ(collected, expected);
+        if (pass > 0) {
+            std::vector<int64_t> untouched(kFrames, -1);
+            for (const auto& column : columns) {
+                EXPECT_EQ(column, untouched);
+            }
+        }
+
+        decoder.decode(stream.data(), stream.size(), pointers.data());
+        EXPECT_EQ(columns, expected);
+        for (auto& column : columns) {
+            std::fill(column.begin(), column.end(), -1);
+        }
+    }
+}
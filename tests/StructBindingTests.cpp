@@ -0,0 +1,122 @@
+#include "StructBinding.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+enum class Mode : uint8_t { Idle = 0, Active = 2, Fault = 7 };
+
+struct Telemetry {
+    uint8_t sensorId;
+    int16_t temperature;
+    bool alarm;
+    Mode mode;
+    uint64_t timestamp;
+    int32_t unrelated;
+};
+
+} // namespace
+
+class StructBindingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config = std::make_unique<MessageConfig>(R"([
+            {"name": "sensor_id", "bit_width": 6, "signed": false},
+            {"name": "temperature", "bit_width": 10, "signed": true},
+            {"name": "alarm", "bit_width": 1, "signed": false},
+            {"name": "mode", "bit_width": 3, "signed": false},
+            {"name": "timestamp", "bit_width": 48, "signed": false},
+            {"name": "reserved", "bit_width": 4, "signed": false}
+        ])"_json);
+        binding = std::make_unique<StructBinding<Telemetry>>(*config);
+        binding->bind(&Telemetry::sensorId, "sensor_id")
+                .bind(&Telemetry::temperature, "temperature")
+                .bind(&Telemetry::alarm, "alarm")
+                .bind(&Telemetry::mode, "mode")
+                .bind(&Telemetry::timestamp, "timestamp");
+    }
+
+    std::unique_ptr<MessageConfig> config;
+    std::unique_ptr<StructBinding<Telemetry>> binding;
+};
+
+TEST_F(StructBindingTest, PackMatchesBinaryMessage) {
+    Telemetry telemetry{42, -317, true, Mode::Fault, 0xABCDEF012345ULL, 99};
+    std::vector<uint8_t> packed = binding->pack(telemetry);
+
+    BinaryMessage message(*config);
+    message.setField("sensor_id", 42);
+    message.setField("temperature", -317);
+    message.setField("alarm", 1);
+    message.setField("mode", 7);
+    message.setField("timestamp", 0xABCDEF012345LL);
+    EXPECT_EQ(packed, message.pack());
+    EXPECT_EQ(binding->getPackedSize(), message.getPackedSize());
+}
+
+TEST_F(StructBindingTest, UnpackFillsBoundMembersOnly) {
+    BinaryMessage message(*config);
+    message.setField("sensor_id", 63);
+    message.setField("temperature", -512);
+    message.setField("alarm", 1);
+    message.setField("mode", 2);
+    message.setField("timestamp", (1LL << 48) - 1);
+    message.setField("reserved", 15);
+    auto packed = message.pack();
+
+    Telemetry telemetry{};
+    telemetry.unrelated = 1234;
+    EXPECT_EQ(binding->unpack(packed.data(), packed.size(), telemetry), packed.size());
+    EXPECT_EQ(telemetry.sensorId, 63);
+    EXPECT_EQ(telemetry.temperature, -512);
+    EXPECT_TRUE(telemetry.alarm);
+    EXPECT_EQ(telemetry.mode, Mode::Active);
+    EXPECT_EQ(telemetry.timestamp, (1ULL << 48) - 1);
+    EXPECT_EQ(telemetry.unrelated, 1234);
+
+    // Unbound fields are packed as 0
+    auto repacked = binding->pack(telemetry);
+    message.unpack(repacked);
+    EXPECT_EQ(message.getField("reserved"), 0);
+    EXPECT_EQ(message.getField("temperature"), -512);
+}
+
+TEST_F(StructBindingTest, PackIntoCallerBuffer) {
+    Telemetry telemetry{1, 2, false, Mode::Idle, 3, 0};
+    std::vector<uint8_t> buffer(binding->getPackedSize() + 2, 0xEE);
+    EXPECT_EQ(binding->pack(telemetry, buffer.data(), buffer.size()), binding->getPackedSize());
+    EXPECT_EQ(buffer.back(), 0xEE);
+    EXPECT_THROW(binding->pack(telemetry, buffer.data(), binding->getPackedSize() - 1), std::runtime_error);
+    EXPECT_THROW(binding->unpack(buffer.data(), binding->getPackedSize() - 1, telemetry), std::runtime_error);
+}
+
+TEST_F(StructBindingTest, RejectsOutOfRangeValues) {
+    Telemetry telemetry{64, 0, false, Mode::Idle, 0, 0};
+    EXPECT_THROW(binding->pack(telemetry), std::runtime_error);
+    telemetry.sensorId = 0;
+    telemetry.temperature = 512;
+    EXPECT_THROW(binding->pack(telemetry), std::runtime_error);
+    telemetry.temperature = 0;
+    telemetry.timestamp = 1ULL << 48;
+    EXPECT_THROW(binding->pack(telemetry), std::runtime_error);
+}
+
+TEST_F(StructBindingTest, RejectsBadBindings) {
+    StructBinding<Telemetry> other(*config);
+    EXPECT_THROW(other.bind(&Telemetry::sensorId, "missing"), std::runtime_error);
+    // 10-bit signed values do not fit in uint8_t
+    EXPECT_THROW(other.bind(&Telemetry::sensorId, "temperature"), std::runtime_error);
+    // bool only holds 1-bit unsigned fields
+    EXPECT_THROW(other.bind(&Telemetry::alarm, "mode"), std::runtime_error);
+    // Mode's underlying uint8_t cannot hold a 48-bit field
+    EXPECT_THROW(other.bind(&Telemetry::mode, "timestamp"), std::runtime_error);
+
+    other.bind(&Telemetry::unrelated, "temperature");
+    EXPECT_THROW(other.bind(&Telemetry::temperature, "temperature"), std::runtime_error);
+}
@@ -0,0 +1,53 @@
+#include "ThreadPool.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+TEST(ThreadPoolTest, RunsEveryTaskExactlyOnce) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4u);
+
+    for (size_t taskCount : {0u, 1u, 3u, 4u, 1000u}) {
+        std::vector<std::atomic<int>> runs(taskCount);
+        pool.run(taskCount, [&runs, &pool](size_t task, size_t worker) {
+            ASSERT_LT(worker, pool.getThreadCount());
+            runs[task].fetch_add(1);
+        });
+        for (size_t i = 0; i < taskCount; ++i) {
+            EXPECT_EQ(runs[i].load(), 1) << "task " << i;
+        }
+    }
+}
+
+TEST(ThreadPoolTest, UnevenTasksAreStolen) {
+    ThreadPool pool(4);
+    std::atomic<size_t> total{0};
+
+    // Worker 0's range holds all the slow tasks; the others must help out
+    pool.run(64, [&total](size_t task, size_t) {
+        if (task < 16) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        total.fetch_add(task);
+    });
+    EXPECT_EQ(total.load(), 64u * 63u / 2u);
+}
+
+TEST(ThreadPoolTest, PropagatesTaskException) {
+    ThreadPool pool(3);
+    EXPECT_THROW(pool.run(100, [](size_t task, size_t) {
+        if (task == 42) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+
+    // The pool stays usable
+    std::atomic<size_t> count{0};
+    pool.run(10, [&count](size_t, size_t) { count.fetch_add(1); });
+    EXPECT_EQ(count.load(), 10u);
+}
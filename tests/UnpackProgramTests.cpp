@@ -0,0 +1,143 @@
+#include "UnpackProgram.hpp"
+#include "BinaryMessage.hpp"
+#include "MessageConfig.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+namespace {
+
+// Random schema mixing every field kind and wire order the layout supports
+nlohmann::json randomSchema(std::mt19937_64& rng, bool msbFirst) {
+    nlohmann::json fields = nlohmann::json::array();
+    size_t count = 1 + rng() % 40;
+    for (size_t i = 0; i < count; ++i) {
+        nlohmann::json field = {{"name", "f" + std::to_string(i)}};
+        unsigned kind = rng() % 10;
+        unsigned width = kind < 3 ? 8u << (rng() % 4) : 1 + static_cast<unsigned>(rng() % 64);
+        field["bit_width"] = width;
+        field["signed"] = rng() % 2 == 0;
+        if (kind == 8) {
+            field["count"] = 1 + rng() % 5;
+        } else if (kind == 9 && width % 8 == 0) {
+            field["byte_order"] = rng() % 2 == 0 ? "big" : "little";
+        } else if (kind == 9) {
+            field["bit_order"] = rng() % 2 == 0 ? "msb_first" : "lsb_first";
+        }
+        fields.push_back(field);
+    }
+    return {{"bit_order", msbFirst ? "msb_first" : "lsb_first"}, {"fields", fields}};
+}
+
+} // namespace
+
+TEST(UnpackProgramTest, MatchesPerFieldExtraction) {
+    std::mt19937_64 rng(24);
+    for (int round = 0; round < 300; ++round) {
+        MessageConfig config(randomSchema(rng, round % 2 == 1));
+        const MessageLayout& layout = config.getLayout();
+
+        // Exactly the message's size, so loads near the end must stay inside it
+        std::vector<uint8_t> buffer(layout.getTotalBytes());
+        for (auto& byte : buffer) {
+            byte = static_cast<uint8_t>(rng());
+        }
+
+        std::vector<int64_t> values(layout.size(), -1);
+        std::vector<uint8_t> blocks(layout.getBlockBytes());
+        config.getUnpackProgram().run(layout, buffer.data(), buffer.size(), values.data(), blocks.data());
+
+        for (size_t i = 0; i < layout.size(); ++i) {
+            if (layout.isScalar(i)) {
+                ASSERT_EQ(values[i], layout.extract(i, buffer.data(), buffer.size()))
+                    << config.getFields()[i].name() << " round " << round;
+            } else {
+                std::vector<uint8_t> expected(layout.getBlockSize(i));
+                layout.extractBlock(i, buffer.data(), buffer.size(), expected.data());
+                std::vector<uint8_t> actual(blocks.begin() + layout.blockOffsets()[i],
+                                            blocks.begin() + layout.blockOffsets()[i] + expected.size());
+                ASSERT_EQ(actual, expected) << config.getFields()[i].name() << " round " << round;
+            }
+        }
+    }
+}
+
+TEST(UnpackProgramTest, FusesFieldsSharingAWord) {
+    using Op = UnpackProgram::Op;
+    // Byte-aligned fields share words; h spills past the word at its first byte,
+    // and i sits in a two-byte tail
+    MessageConfig config(R"([
+        {"name": "a", "bit_width": 8, "signed": false},
+        {"name": "b", "bit_width": 8, "signed": true},
+        {"name": "c", "bit_width": 16, "signed": false},
+        {"name": "d", "bit_width": 32, "signed": true},
+        {"name": "e", "bit_width": 64, "signed": false},
+        {"name": "f", "bit_width": 4, "signed": false},
+        {"name": "h", "bit_width": 62, "signed": true},
+        {"name": "i", "bit_width": 8, "signed": false}
+    ])"_json);
+    const auto& code = config.getUnpackProgram().getInstructions();
+    std::vector<Op> ops;
+    for (const auto& instruction : code) {
+        ops.push_back(instruction.op);
+    }
+    EXPECT_EQ(ops, (std::vector<Op>{Op::Word, Op::Unsigned, Op::Signed, Op::Unsigned, Op::Signed,
+                                    Op::Word, Op::Unsigned,
+                                    Op::Word, Op::Unsigned, Op::Extract,
+                                    Op::WordTail, Op::Unsigned, Op::End}));
+    EXPECT_EQ(code[10].offset, 24u);
+    EXPECT_EQ(code[10].count, 2u);
+    EXPECT_EQ(code[5].offset, 8u);
+    // c occupies bits 16-31 of the first word
+    EXPECT_EQ(code[3].left, 32u);
+    EXPECT_EQ(code[3].right, 48u);
+
+    // A tail shorter than a word is loaded partially
+    MessageConfig tail(R"({"bit_order": "msb_first", "fields": [
+        {"name": "a", "bit_width": 64, "signed": false},
+        {"name": "b", "bit_width": 3, "signed": true},
+        {"name": "c", "bit_width": 12, "signed": false}
+    ]})"_json);
+    const auto& tailCode = tail.getUnpackProgram().getInstructions();
+    ASSERT_EQ(tailCode.size(), 6u);
+    EXPECT_EQ(tailCode[0].op, Op::WordMsb);
+    EXPECT_EQ(tailCode[2].op, Op::WordMsbTail);
+    EXPECT_EQ(tailCode[2].offset, 8u);
+    EXPECT_EQ(tailCode[2].count, 2u);
+    EXPECT_EQ(tailCode[4].left, 3u);
+}
+
+TEST(UnpackProgramTest, DrivesBinaryMessageUnpack) {
+    MessageConfig config(R"({"bit_order": "msb_first", "fields": [
+        {"name": "version", "bit_width": 4, "signed": false},
+        {"name": "delta", "bit_width": 13, "signed": true},
+        {"name": "crc", "bit_width": 16, "signed": false, "byte_order": "little"},
+        {"name": "samples", "bit_width": 6, "signed": true, "count": 3}
+    ]})"_json);
+    BinaryMessage message(config);
+    message.setField("version", 9);
+    message.setField("delta", -4000);
+    message.setField("crc", 0xBEEF);
+    const int64_t samples[] = {-32, 0, 31};
+    message.setArray("samples", samples, 3);
+
+    BinaryMessage decoded(config);
+    decoded.unpack(message.pack());
+    EXPECT_EQ(decoded.getField("version"), 9);
+    EXPECT_EQ(decoded.getField("delta"), -4000);
+    EXPECT_EQ(decoded.getField("crc"), 0xBEEF);
+    int64_t decodedSamples[3];
+    decoded.getArray("samples", decodedSamples, 3);
+    EXPECT_EQ(decodedSamples[0], -32);
+    EXPECT_EQ(decodedSamples[2], 31);
+
+    // An empty configuration compiles to a program that does nothing
+    MessageConfig empty;
+    ASSERT_EQ(empty.getUnpackProgram().getInstructions().size(), 1u);
+    EXPECT_EQ(empty.getUnpackProgram().getInstructions()[0].op, UnpackProgram::Op::End);
+}
@@ -0,0 +1,335 @@
+#include "BinaryMessageFactory.hpp"
+#include "MessageConfig.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace BinaryMessageLibrary;
+
+// Generates one self-contained header per message type of a
+// BinaryMessageFactory-style JSON definition file, plus an umbrella header
+// including all of them. Each header holds a plain struct, constexpr layout
+// constants and branch-free pack/unpack functions that operate on whole 64-bit
+// words with every offset, shift and mask baked in as a literal.
+//
+// Usage: binary_message_codegen <definitions.json> <output_dir> [namespace]
+
+namespace {
+
+bool isIdentifier(const std::string& name) {
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    });
+}
+
+// Names a generated header cannot use: C++ keywords, alternative operator
+// tokens, and the members every generated struct declares
+const std::set<std::string> kKeywords = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break",
+    "case", "catch", "char", "char16_t", "char32_t", "char8_t", "class", "compl", "concept",
+    "const", "const_cast", "consteval", "constexpr", "constinit", "continue", "co_await",
+    "co_return", "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast",
+    "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto",
+    "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+    "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register",
+    "reinterpret_cast", "requires", "return", "short", "signed", "sizeof", "static",
+    "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local",
+    "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using",
+    "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"};
+const std::set<std::string> kGeneratedMembers = {"kMessageType", "kTotalBits", "kPackedSize", "Layout"};
+
+// Why a name cannot be used as given in a generated header, or null if it can
+const char* nameProblem(const std::string& name) {
+    if (!isIdentifier(name)) {
+        return "is not a valid C++ identifier";
+    }
+    if (kKeywords.count(name) != 0) {
+        return "is a C++ keyword";
+    }
+    return nullptr;
+}
+
+// sensor_data -> SensorData
+std::string toTypeName(const std::string& messageType) {
+    std::string result;
+    bool upper = true;
+    for (char c : messageType) {
+        if (c == '_') {
+            upper = true;
+        } else {
+            result += upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+            upper = false;
+        }
+    }
+    return result;
+}
+
+// Smallest standard integer type that holds every value of the field
+std::string valueType(unsigned width, bool isSigned) {
+    unsigned bits = width <= 8 ? 8 : width <= 16 ? 16 : width <= 32 ? 32 : 64;
+    return std::string(isSigned ? "int" : "uint") + std::to_string(bits) + "_t";
+}
+
+std::string hex(uint64_t value) {
+    std::ostringstream out;
+    out << "0x" << std::hex << value << "ULL";
+    return out.str();
+}
+
+const char* kHelpers = R"(#ifndef BINARY_MESSAGE_GENERATED_HELPERS
+#define BINARY_MESSAGE_GENERATED_HELPERS
+namespace binary_message_generated_detail {
+
+inline uint64_t load_le64(const uint8_t* p) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+inline void store_le64(uint8_t* p, uint64_t word) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    std::memcpy(p, &word, sizeof(word));
+}
+
+template <size_t Count>
+inline uint64_t load_le_partial(const uint8_t* p) {
+    uint64_t word = 0;
+    for (size_t i = 0; i < Count; ++i) {
+        word |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return word;
+}
+
+template <size_t Count>
+inline void store_le_partial(uint8_t* p, uint64_t word) {
+    for (size_t i = 0; i < Count; ++i) {
+        p[i] = static_cast<uint8_t>(word >> (8 * i));
+    }
+}
+
+} // namespace binary_message_generated_detail
+#endif
+)";
+
+std::string generateHeader(const std::string& messageType, const MessageConfig& config,
+                           const std::string& ns, const std::string& source) {
+    const auto& fields = config.getFields();
+    const auto& layout = config.getLayout();
+    std::string typeName = toTypeName(messageType);
+    size_t totalBytes = layout.getTotalBytes();
+    size_t wordCount = (totalBytes + 7) / 8;
+
+    std::ostringstream out;
+    out << "// Generated by binary_message_codegen from " << source << ". Do not edit.\n"
+        << "#pragma once\n\n"
+        << "#include <cstdint>\n#include <cstddef>\n#include <cstring>\n\n"
+        << kHelpers << "\n"
+        << "namespace " << ns << " {\n\n";
+
+    // Plain struct with the layout as constexpr constants
+    out << "struct " << typeName << " {\n"
+        << "    static constexpr const char* kMessageType = \"" << messageType << "\";\n"
+        << "    static constexpr size_t kTotalBits = " << layout.getTotalBits() << ";\n"
+        << "    static constexpr size_t kPackedSize = " << totalBytes << ";\n\n"
+        << "    struct Layout {\n";
+    for (size_t i = 0; i < fields.size(); ++i) {
+        size_t offset = static_cast<size_t>(layout.byteOffsets()[i]) * 8 + layout.shifts()[i];
+        out << "        static constexpr size_t " << fields[i].name() << "_bit_offset = " << offset << ";\n"
+            << "        static constexpr unsigned " << fields[i].name() << "_bit_width = "
+            << static_cast<unsigned>(fields[i].bit_width()) << ";\n";
+    }
+    out << "    };\n\n";
+    for (const auto& field : fields) {
+        out << "    " << valueType(field.bit_width(), field.is_signed()) << " " << field.name() << " = 0;\n";
+    }
+    out << "};\n\n";
+
+    // Per 64-bit word of the packed message, the field pieces that land in it
+    std::vector<std::vector<std::string>> packTerms(wordCount);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        size_t offset = static_cast<size_t>(layout.byteOffsets()[i]) * 8 + layout.shifts()[i];
+        size_t word = offset / 64;
+        unsigned shift = static_cast<unsigned>(offset % 64);
+        std::string value = "(static_cast<uint64_t>(message." + fields[i].name() + ") & " +
+                            hex(layout.masks()[i]) + ")";
+        packTerms[word].push_back(shift == 0 ? value : "(" + value + " << " + std::to_string(shift) + ")");
+        if (shift + fields[i].bit_width() > 64) {
+            packTerms[word + 1].push_back("(" + value + " >> " + std::to_string(64 - shift) + ")");
+        }
+    }
+
+    out << "inline void pack(const " << typeName << "& message, uint8_t* out) {\n"
+        << "    namespace detail = binary_message_generated_detail;\n";
+    for (size_t w = 0; w < wordCount; ++w) {
+        std::string expression;
+        for (const auto& term : packTerms[w]) {
+            expression += (expression.empty() ? "" : "\n        | ") + term;
+        }
+        if (expression.empty()) {
+            expression = "0";
+        }
+        size_t bytes = std::min<size_t>(8, totalBytes - w * 8);
+        out << "    const uint64_t w" << w << " = " << expression << ";\n";
+        if (bytes == 8) {
+            out << "    detail::store_le64(out + " << w * 8 << ", w" << w << ");\n";
+        } else {
+            out << "    detail::store_le_partial<" << bytes << ">(out + " << w * 8 << ", w" << w << ");\n";
+        }
+    }
+    if (wordCount == 0) {
+        out << "    (void)message;\n    (void)out;\n";
+    }
+    out << "}\n\n";
+
+    out << "inline void unpack(const uint8_t* in, " << typeName << "& message) {\n"
+        << "    namespace detail = binary_message_generated_detail;\n";
+    for (size_t w = 0; w < wordCount; ++w) {
+        size_t bytes = std::min<size_t>(8, totalBytes - w * 8);
+        if (bytes == 8) {
+            out << "    const uint64_t w" << w << " = detail::load_le64(in + " << w * 8 << ");\n";
+        } else {
+            out << "    const uint64_t w" << w << " = detail::load_le_partial<" << bytes << ">(in + "
+                << w * 8 << ");\n";
+        }
+    }
+    for (size_t i = 0; i < fields.size(); ++i) {
+        size_t offset = static_cast<size_t>(layout.byteOffsets()[i]) * 8 + layout.shifts()[i];
+        size_t word = offset / 64;
+        unsigned shift = static_cast<unsigned>(offset % 64);
+        std::string raw = "w" + std::to_string(word);
+        if (shift != 0) {
+            raw = "(" + raw + " >> " + std::to_string(shift) + ")";
+        }
+        if (shift + fields[i].bit_width() > 64) {
+            raw = "(" + raw + " | (w" + std::to_string(word + 1) + " << " + std::to_string(64 - shift) + "))";
+        }
+        raw = "(" + raw + " & " + hex(layout.masks()[i]) + ")";
+        unsigned signShift = layout.signShifts()[i];
+        if (signShift != 0) {
+            raw = "(static_cast<int64_t>(" + raw + " << " + std::to_string(signShift) + ") >> " +
+                  std::to_string(signShift) + ")";
+        }
+        out << "    message." << fields[i].name() << " = static_cast<"
+            << valueType(fields[i].bit_width(), fields[i].is_signed()) << ">(" << raw << ");\n";
+    }
+    if (wordCount == 0) {
+        out << "    (void)in;\n    (void)message;\n";
+    }
+    out << "}\n\n"
+        << "} // namespace " << ns << "\n";
+    return out.str();
+}
+
+void writeFile(const std::string& path, const std::string& contents) {
+    // Leave unchanged files alone so dependents are not rebuilt needlessly
+    std::ifstream existing(path, std::ios::binary);
+    if (existing) {
+        std::ostringstream current;
+        current << existing.rdbuf();
+        if (current.str() == contents) {
+            return;
+        }
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    file << contents;
+}
+
+std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3 || argc > 4) {
+        std::cerr << "Usage: " << argv[0] << " <definitions.json> <output_dir> [namespace]" << std::endl;
+        return 2;
+    }
+    std::string definitionsPath = argv[1];
+    std::string outputDir = argv[2];
+    std::string ns = argc == 4 ? argv[3] : "generated";
+
+    try {
+        std::ifstream definitionsFile(definitionsPath);
+        if (!definitionsFile) {
+            throw std::runtime_error("Cannot open " + definitionsPath);
+        }
+        nlohmann::json definitions;
+        definitionsFile >> definitions;
+
+        // The factory performs the same validation as at runtime
+        BinaryMessageFactory factory(definitions);
+        auto types = factory.getMessageTypes();
+        std::sort(types.begin(), types.end());
+
+        std::string source = baseName(definitionsPath) + ".json";
+        std::ostringstream umbrella;
+        umbrella << "// Generated by binary_message_codegen from " << source << ". Do not edit.\n"
+                 << "#pragma once\n\n";
+
+        std::map<std::string, std::string> typeNames;
+        for (const auto& type : types) {
+            if (const char* problem = nameProblem(type)) {
+                throw std::runtime_error("Message type '" + type + "' " + problem);
+            }
+            std::string typeName = toTypeName(type);
+            if (const char* problem = nameProblem(typeName)) {
+                throw std::runtime_error("Struct name '" + typeName + "' of message '" + type + "' " + problem);
+            }
+            auto named = typeNames.emplace(typeName, type);
+            if (!named.second) {
+                throw std::runtime_error("Messages '" + named.first->second + "' and '" + type +
+                                         "' both map to the struct name '" + typeName + "'");
+            }
+            const auto& config = factory.getMessageConfig(type);
+            if (!config.getLayout().hasDefaultOrder()) {
+                throw std::runtime_error("Message '" + type + "' uses a bit_order or byte_order other than "
+                                         "lsb_first/little, which generated codecs do not support");
+            }
+            if (config.getLayout().hasBlocks()) {
+                throw std::runtime_error("Message '" + type + "' has array or bytes fields, "
+                                         "which generated codecs do not support");
+            }
+            for (const auto& field : config.getFields()) {
+                if (const char* problem = nameProblem(field.name())) {
+                    throw std::runtime_error("Field '" + field.name() + "' in message '" + type + "' " + problem);
+                }
+                if (kGeneratedMembers.count(field.name()) != 0) {
+                    throw std::runtime_error("Field '" + field.name() + "' in message '" + type +
+                                             "' collides with the generated member of that name");
+                }
+            }
+            writeFile(outputDir + "/" + type + ".hpp", generateHeader(type, config, ns, source));
+            umbrella << "#include \"" << type << ".hpp\"\n";
+        }
+
+        writeFile(outputDir + "/" + baseName(definitionsPath) + "_codecs.hpp", umbrella.str());
+    } catch (const std::exception& e) {
+        std::cerr << "binary_message_codegen: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}